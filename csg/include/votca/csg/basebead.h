@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -25,6 +25,7 @@
 // VOTCA includes
 #include <votca/tools/constants.h>
 #include <votca/tools/eigen.h>
+#include <votca/tools/internedstring.h>
 #include <votca/tools/name.h>
 #include <votca/tools/types.h>
 
@@ -55,7 +56,12 @@ class BaseBead {
   void setId(const Index &id) noexcept { id_ = id; }
 
   /// Gets the name of the bead
-  std::string getName() const { return name_.getName(); }
+  const std::string &getName() const { return name_.getName(); }
+
+  /// Gets the interned name, for fast comparisons and lookup tables
+  const tools::InternedString &getInternedName() const {
+    return name_.getInternedName();
+  }
 
   /// Sets the name of the bead
   void setName(std::string name) { return name_.setName(name); }
@@ -81,13 +87,21 @@ class BaseBead {
    * get the bead type
    * \return const string
    */
-  virtual const std::string getType() const noexcept { return type_; }
+  virtual const std::string &getType() const noexcept { return type_.str(); }
+
+  /**
+   * get the interned bead type, beads of the same type share its id
+   * \return interned type
+   */
+  const tools::InternedString &getInternedType() const noexcept {
+    return type_;
+  }
 
   /**
    * set the bead type
    * \param type bead type object
    */
-  virtual void setType(const std::string &type) noexcept { type_ = type; }
+  virtual void setType(const std::string &type) { type_ = type; }
 
   /**
    * @brief Returns the element type of the bead
@@ -146,7 +160,7 @@ class BaseBead {
  protected:
   BaseBead() = default;
 
-  std::string type_ = tools::topology_constants::unassigned_bead_type;
+  tools::InternedString type_ = tools::topology_constants::unassigned_bead_type;
   Index id_ = tools::topology_constants::unassigned_residue_id;
   Index molecule_id_ = tools::topology_constants::unassigned_molecule_id;
   std::string element_symbol_ = tools::topology_constants::unassigned_element;
@@ -121,6 +121,15 @@ class BeadStructure {
    **/
   bool isStructureEquivalent(BeadStructure &beadstructure);
 
+  /**
+   * \brief Hash of the topology of the bead structure
+   *
+   * The hash does not depend on the bead ids, equivalent structures have the
+   * same hash. It is cheap to compute and can be used to bucket structures
+   * before comparing them with isStructureEquivalent.
+   **/
+  std::uint64_t getStructureHash();
+
   /// Determine if a bead exists in the structure
   bool BeadExist(Index bead_id) const { return beads_.count(bead_id); }
 
@@ -142,13 +151,18 @@ class BeadStructure {
   virtual void UpdateOnBeadAddition_(){};
   void InitializeGraph_();
   void CalculateStructure_();
+  /// True if the beads of both structures, sorted by id, have the same names
+  /// and masses and are connected in the same way
+  bool MatchesInIdOrder_(const BeadStructure &beadstructure) const;
   tools::GraphNode BeadInfoToGraphNode_(const BeadInfo &);
 
   bool structureIdUpToDate = false;
+  bool structureHashUpToDate = false;
   bool graphUpToDate = false;
   bool single_structureUpToDate_ = false;
   bool single_structure_ = false;
   std::string structure_id_ = "";
+  std::uint64_t structure_hash_ = 0;
   tools::Graph graph_;
   std::set<tools::Edge> connections_;
   std::unordered_map<Index, BeadInfo> beads_;
@@ -176,6 +190,7 @@ void BeadStructure::AddBead(const T &bead) {
     single_structureUpToDate_ = false;
     graphUpToDate = false;
     structureIdUpToDate = false;
+    structureHashUpToDate = false;
   }
 }
 
@@ -26,6 +26,7 @@
 
 // Local VOTCA includes
 #include "cgobserver.h"
+#include "csgprofiler.h"
 #include "topology.h"
 #include "topologymap.h"
 #include "trajectoryreader.h"
@@ -79,6 +80,9 @@ class CsgApplication : public tools::Application {
 
   void AddObserver(CGObserver *observer);
 
+  /// \brief profiler, enabled with the --profile option
+  CsgProfiler &Profiler() { return profiler_; }
+
   /// \brief called before the first frame
   virtual void BeginEvaluate(Topology *top, Topology *top_ref = nullptr);
   /// \brief called after the last frame
@@ -165,6 +169,7 @@ class CsgApplication : public tools::Application {
   /// \brief stores Mutexes used to impose order for output
   std::vector<std::unique_ptr<tools::Mutex>> threadsMutexesOut_;
   std::unique_ptr<TrajectoryReader> traj_reader_;
+  CsgProfiler profiler_;
 };
 
 inline void CsgApplication::AddObserver(CGObserver *observer) {
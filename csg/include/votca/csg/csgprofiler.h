@@ -0,0 +1,119 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_CSGPROFILER_H
+#define VOTCA_CSG_CSGPROFILER_H
+
+// Standard includes
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+
+// VOTCA includes
+#include <votca/tools/mutex.h>
+#include <votca/tools/property.h>
+#include <votca/tools/types.h>
+
+namespace votca {
+namespace csg {
+
+/**
+ * \brief Lightweight profiler for CsgApplication based tools
+ *
+ * Collects the wall time spent in named stages per thread and global event
+ * counters. Stage names containing a '/' are sub stages (e.g.
+ * "evaluate/nbsearch") and are reported but not added to the busy time of a
+ * thread. Stages starting with "wait" are time a thread spent waiting for
+ * its turn and are reported as idle time.
+ *
+ * All functions return immediately if the profiler is not enabled, so tools
+ * can instrument their code unconditionally.
+ */
+class CsgProfiler {
+ public:
+  /// \brief adds the time between construction and destruction to a stage
+  class ScopedTimer {
+   public:
+    ScopedTimer(CsgProfiler &profiler, std::string stage, Index thread = 0);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+   private:
+    CsgProfiler *profiler_;
+    std::string stage_;
+    Index thread_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  void Enable(bool enable = true) { enabled_ = enable; }
+  bool isEnabled() const { return enabled_; }
+
+  /// \brief start the wall clock of the whole run
+  void Start();
+  /// \brief stop the wall clock of the whole run
+  void Stop();
+
+  void AddTime(Index thread, const std::string &stage, double seconds);
+  void AddCount(const std::string &counter, Index count = 1);
+
+  double getTime(Index thread, const std::string &stage) const;
+  Index getCalls(Index thread, const std::string &stage) const;
+  Index getCount(const std::string &counter) const;
+  double getWallTime() const { return wall_time_; }
+
+  /// \brief time of all top level stages of a thread, waiting excluded
+  double getBusyTime(Index thread) const;
+  /// \brief time a thread spent waiting
+  double getIdleTime(Index thread) const;
+
+  /// \brief report as property tree, used for the xml output
+  tools::Property Report(const std::string &program) const;
+
+  void WriteJSON(std::ostream &out, const std::string &program) const;
+  void WriteXML(std::ostream &out, const std::string &program) const;
+  /// \brief writes xml if the filename ends in .xml, json otherwise
+  void WriteReport(const std::string &filename,
+                   const std::string &program) const;
+
+ private:
+  struct stage_t {
+    double seconds_ = 0.0;
+    Index calls_ = 0;
+  };
+
+  static bool isWaiting(const std::string &stage) {
+    return stage.compare(0, 4, "wait") == 0;
+  }
+  static bool isSubStage(const std::string &stage) {
+    return stage.find('/') != std::string::npos;
+  }
+
+  bool enabled_ = false;
+  double wall_time_ = 0.0;
+  std::chrono::steady_clock::time_point start_;
+  std::map<Index, std::map<std::string, stage_t>> threads_;
+  std::map<std::string, Index> counters_;
+  mutable tools::Mutex mutex_;
+};
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_CSGPROFILER_H
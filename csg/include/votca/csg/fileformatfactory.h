@@ -34,6 +34,9 @@ class FileFormatFactory : public tools::ObjectFactory<std::string, T> {
   FileFormatFactory() = default;
 
   std::unique_ptr<T> Create(const std::string &file) final;
+  /// uses the plugin registered as format instead of the file extension
+  std::unique_ptr<T> Create(const std::string &file,
+                            const std::string &format);
 };
 
 template <typename T>
@@ -50,6 +53,21 @@ std::unique_ptr<T> FileFormatFactory<T>::Create(const std::string &file) {
   return nullptr;
 }
 
+template <typename T>
+std::unique_ptr<T> FileFormatFactory<T>::Create(const std::string &file,
+                                                const std::string &format) {
+  if (format.empty()) {
+    return Create(file);
+  }
+  try {
+    return tools::ObjectFactory<std::string, T>::Create(format);
+  } catch (std::exception &) {
+    throw std::runtime_error("Error '" + format + "' file format of file '" +
+                             file + "' cannot be read or written");
+  }
+  return nullptr;
+}
+
 }  // namespace csg
 }  // namespace votca
 
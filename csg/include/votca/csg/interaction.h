@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2019 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -23,6 +23,9 @@
 #include <sstream>
 #include <string>
 
+// VOTCA includes
+#include <votca/tools/internedstring.h>
+
 // Local VOTCA includes
 #include "bead.h"
 #include "topology.h"
@@ -44,14 +47,20 @@ class Interaction {
   virtual ~Interaction() = default;
   virtual double EvaluateVar(const Topology &top) = 0;
 
-  std::string getName() const { return name_; }
+  /// name built from molecule, group and index, only used for messages
+  std::string getName() const;
 
   void setGroup(const std::string &group) {
     group_ = group;
-    RebuildName();
+    name_group_id_ = group_id_;
   }
   const std::string &getGroup() const {
-    assert(group_.compare("") != 0);
+    assert(!group_.empty());
+    return group_.str();
+  }
+  /// interned group name, all interactions of a group share its id
+  const tools::InternedString &getInternedGroup() const {
+    assert(!group_.empty());
     return group_;
   }
 
@@ -66,7 +75,7 @@ class Interaction {
 
   void setIndex(const Index &index) {
     index_ = index;
-    RebuildName();
+    name_group_id_ = group_id_;
   }
   const Index &getIndex() const {
     assert(index_ != -1);
@@ -75,7 +84,7 @@ class Interaction {
 
   void setMolecule(const Index &mol) {
     mol_ = mol;
-    RebuildName();
+    name_group_id_ = group_id_;
   }
   const Index &getMolecule() const {
     assert(mol_ != -1);
@@ -91,16 +100,17 @@ class Interaction {
 
  protected:
   Index index_ = -1;
-  std::string group_ = "";
+  tools::InternedString group_;
   Index group_id_ = -1;
-  std::string name_ = "";
+  // group id at the last change of group, index or molecule, the name only
+  // contains the id if it was known then. Interactions get their id when added
+  // to a topology, after the setters were called, and are named without it.
+  Index name_group_id_ = -1;
   Index mol_ = -1;
   std::vector<Index> beads_;
-
-  void RebuildName();
 };
 
-inline void Interaction::RebuildName() {
+inline std::string Interaction::getName() const {
   std::stringstream s;
   if (mol_ != -1) {
     {
@@ -109,8 +119,8 @@ inline void Interaction::RebuildName() {
   }
   if (!group_.empty()) {
     s << ":" << group_;
-    if (group_id_ != -1) {
-      s << " " << group_id_;
+    if (name_group_id_ != -1) {
+      s << " " << name_group_id_;
     }
   }
   if (index_ != -1) {
@@ -118,7 +128,7 @@ inline void Interaction::RebuildName() {
       s << ":index " << index_;
     }
   }
-  name_ = s.str();
+  return s.str();
 }
 
 /**
@@ -226,7 +236,7 @@ inline Eigen::Vector3d IAngle::Grad(const Topology &top, Index bead) {
     case (0):
       return acos_prime *
              (-v2 / (v1.norm() * v2.norm()) +
-              (v1.dot(v2) * v1) / (v1.squaredNorm() * v2.squaredNorm()));
+              (v1.dot(v2) * v1) / (std::pow(v1.norm(), 3) * v2.norm()));
       break;
     case (1):
       return acos_prime *
@@ -235,8 +245,9 @@ inline Eigen::Vector3d IAngle::Grad(const Topology &top, Index bead) {
                   (std::pow(v1.norm(), 3) * std::pow(v2.norm(), 3)));
       break;
     case (2):
-      return acos_prime * (-v1 / (v1.norm() * v2.norm())) +
-             (v1.dot(v2) * v2 / (v1.norm() * std::pow(v2.norm(), 3)));
+      return acos_prime *
+             (-v1 / (v1.norm() * v2.norm()) +
+              (v1.dot(v2) * v2) / (v1.norm() * std::pow(v2.norm(), 3)));
       break;
   }
   // should never reach this
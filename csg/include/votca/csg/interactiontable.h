@@ -0,0 +1,101 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_CSG_INTERACTIONTABLE_H
+#define VOTCA_CSG_INTERACTIONTABLE_H
+
+// Standard includes
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/eigen.h>
+#include <votca/tools/types.h>
+
+namespace votca {
+namespace csg {
+
+class Interaction;
+class Topology;
+
+/**
+    \brief flat table of all bonded interactions of one group
+
+    The table stores the bead ids of all interactions of a group as one
+    contiguous array of index tuples (2 for bonds, 3 for angles, 4 for
+    dihedrals). The batch kernels evaluate the variable (length, angle or
+    dihedral) and its gradients for the whole group in one pass, which avoids
+    a virtual call and a topology lookup per interaction.
+
+    Gradients are returned as a 3 x (Arity()*size()) matrix, column
+    i*Arity()+j is the gradient with respect to bead j of interaction i, i.e.
+    it belongs to the bead id BeadIds()[i*Arity()+j].
+*/
+class InteractionTable {
+ public:
+  InteractionTable() = default;
+
+  /// \brief append an interaction, id is its index in
+  /// Topology::BondedInteractions()
+  void Add(const Interaction &ic, Index id);
+
+  void Clear();
+
+  /// number of interactions in the table
+  Index size() const { return Index(ids_.size()); }
+  bool empty() const { return ids_.empty(); }
+
+  /// number of beads per interaction, 0 for an empty table
+  Index Arity() const { return arity_; }
+
+  Index getBeadId(Index interaction, Index bead) const {
+    return beads_[interaction * arity_ + bead];
+  }
+  const std::vector<Index> &BeadIds() const { return beads_; }
+
+  /// index of the interaction in Topology::BondedInteractions()
+  Index getInteractionId(Index interaction) const { return ids_[interaction]; }
+
+  /// \brief evaluate the variable of all interactions
+  void EvaluateVar(const Topology &top, Eigen::VectorXd &values) const;
+
+  /// \brief evaluate the variable and gradients of all interactions
+  void EvaluateVarAndGrad(const Topology &top, Eigen::VectorXd &values,
+                          Eigen::Matrix3Xd &grads) const;
+
+ private:
+  /// pbc corrected connection vectors from bead `from` to bead `to` of
+  /// all interactions
+  Eigen::Matrix3Xd Connections(const Topology &top, Index from,
+                               Index to) const;
+
+  void BondKernel(const Topology &top, Eigen::VectorXd &values,
+                  Eigen::Matrix3Xd *grads) const;
+  void AngleKernel(const Topology &top, Eigen::VectorXd &values,
+                   Eigen::Matrix3Xd *grads) const;
+  void DihedralKernel(const Topology &top, Eigen::VectorXd &values,
+                      Eigen::Matrix3Xd *grads) const;
+
+  Index arity_ = 0;
+  std::vector<Index> beads_;
+  std::vector<Index> ids_;
+};
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_INTERACTIONTABLE_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -25,6 +25,9 @@
 #include <string>
 #include <vector>
 
+// VOTCA includes
+#include <votca/tools/internedstring.h>
+
 // Local VOTCA includes
 #include "bead.h"
 
@@ -48,13 +51,20 @@ class Molecule {
   Index getId() const { return id_; }
 
   /// get the name of the molecule
-  const std::string &getName() const { return name_; }
+  const std::string &getName() const { return name_.str(); }
+  /// get the interned name of the molecule
+  const tools::InternedString &getInternedName() const { return name_; }
 
   /// set the name of the molecule
   void setName(const std::string &name) { name_ = name; }
 
   /// Add a bead to the molecule
   void AddBead(Bead *bead, const std::string &name);
+  /// reserve memory for nbeads beads, used if the size is known in advance
+  void ReserveBeads(Index nbeads) {
+    beads_.reserve(nbeads);
+    bead_names_.reserve(nbeads);
+  }
   /// get the id of a bead in the molecule
   Bead *getBead(Index bead) { return beads_[bead]; }
   const Bead *getBead(Index bead) const { return beads_[bead]; }
@@ -68,9 +78,8 @@ class Molecule {
   std::vector<Bead *> &Beads() { return beads_; }
   /// find a bead by it's name
   Index getBeadByName(const std::string &name) const;
-  std::string getBeadName(const Index bead) { return bead_names_[bead]; }
   const std::string &getBeadName(const Index bead) const {
-    return bead_names_[bead];
+    return bead_names_[bead].str();
   }
 
   /// Add an interaction to the molecule
@@ -82,18 +91,19 @@ class Molecule {
   }
 
  private:
-  // maps a name to a bead id
-  std::map<std::string, Index> beadmap_;
+  // maps the id of an interned bead name to the bead index
+  std::map<Index, Index> beadmap_;
   std::vector<Interaction *> interactions_;
 
   // id of the molecules
   Index id_;
 
   // name of the molecule
-  std::string name_;
+  tools::InternedString name_;
   // the beads in the molecule
   std::vector<Bead *> beads_;
-  std::vector<std::string> bead_names_;
+  // names are interned, copies of a molecule share them
+  std::vector<tools::InternedString> bead_names_;
 
   /// constructor
   Molecule(Index id, std::string name) : id_(id), name_(name) {}
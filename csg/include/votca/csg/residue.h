@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,6 +21,10 @@
 // Standard includes
 #include <string>
 
+// VOTCA includes
+#include <votca/tools/internedstring.h>
+#include <votca/tools/types.h>
+
 namespace votca {
 namespace csg {
 
@@ -42,14 +46,14 @@ class Residue {
 
  private:
   Index id_;
-  std::string name_;
+  tools::InternedString name_;
 
   /// constructor
   Residue(Index id, const std::string &name) : id_(id), name_(name) {}
   friend class Topology;
 };
 
-inline const std::string &Residue::getName() const { return name_; }
+inline const std::string &Residue::getName() const { return name_.str(); }
 
 }  // namespace csg
 }  // namespace votca
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -36,6 +36,7 @@
 #include "bead.h"
 #include "boundarycondition.h"
 #include "exclusionlist.h"
+#include "interactiontable.h"
 #include "molecule.h"
 #include "openbox.h"
 #include "orthorhombicbox.h"
@@ -192,14 +193,51 @@ class Topology {
   }
 
   void AddBondedInteraction(Interaction *ic);
-  std::vector<Interaction *> InteractionsInGroup(const std::string &group);
+
+  /**
+   * \brief reserves memory for n more bonded interactions
+   *
+   * Readers which know the number of interactions in advance call this before
+   * adding them, so the interaction list is not reallocated while it grows.
+   * \param n number of interactions which will be added
+   */
+  void ReserveBondedInteractions(Index n) {
+    interactions_.reserve(interactions_.size() + n);
+  }
+
+  /**
+   * \brief all bonded interactions of a group
+   * \param group name of the interaction group
+   * \return interactions of the group, empty if the group does not exist
+   */
+  const std::vector<Interaction *> &InteractionsInGroup(
+      const std::string &group) const;
+
+  /**
+   * \brief flat table of all bonded interactions of a group
+   *
+   * The table is kept in sync by AddBondedInteraction and can be used to
+   * evaluate all interactions of the group with one batch kernel call.
+   * \param group name of the interaction group
+   * \return table of the group, empty if the group does not exist
+   */
+  const InteractionTable &BondedInteractionTable(
+      const std::string &group) const;
+
+  /**
+   * access the interaction tables of all groups, indexed by group id
+   * @return vector of interaction tables
+   */
+  const std::vector<InteractionTable> &BondedInteractionTables() const {
+    return interaction_tables_;
+  }
 
   /**
    * \brief Determine if a bead type exists.
    *
    * @return bool true if it has been registered
    **/
-  bool BeadTypeExist(std::string type) const;
+  bool BeadTypeExist(const std::string &type) const;
 
   /**
    * \brief Register the bead type with the topology object.
@@ -217,6 +255,8 @@ class Topology {
    * @return Index the id of the type
    **/
   Index getBeadTypeId(std::string type) const;
+  /// same as above without hashing the type name, for per bead loops
+  Index getBeadTypeId(const tools::InternedString &type) const;
 
   /**
    * \brief Returns a pointer to the bead with index i
@@ -409,7 +449,8 @@ class Topology {
       const Eigen::Matrix3d &box) const;
 
   /// bead types in the topology
-  std::unordered_map<std::string, Index> beadtypes_;
+  /// topology type id by id of the interned type name
+  std::unordered_map<Index, Index> beadtypes_;
 
   /// beads in the topology
   BeadContainer beads_;
@@ -425,9 +466,14 @@ class Topology {
 
   ExclusionList exclusions_;
 
-  std::map<std::string, Index> interaction_groups_;
+  /// group id by id of the interned group name
+  std::unordered_map<Index, Index> interaction_groups_;
+
+  /// interactions of each group, indexed by group id
+  std::vector<std::vector<Interaction *>> interactions_by_group_;
 
-  std::map<std::string, std::vector<Interaction *>> interactions_by_group_;
+  /// flat interaction tables, indexed by group id
+  std::vector<InteractionTable> interaction_tables_;
 
   double time_ = 0.0;
   Index step_ = 0;
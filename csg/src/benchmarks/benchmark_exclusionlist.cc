@@ -0,0 +1,88 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Builds exclusion lists of bonded chains and queries them with
+// ExclusionList::IsExcluded, prints one json object per case.
+
+// Standard includes
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/exclusionlist.h"
+#include "votca/csg/topology.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+#include "benchmark_systems.h"
+
+using namespace votca;
+
+int main(int argc, char **argv) {
+  Index nbeads = (argc > 1) ? std::atol(argv[1]) : 100000;
+  const Index nqueries = 1000000;
+
+  for (Index chainlength : {3, 10, 50}) {
+    csg::Topology top;
+    csg::benchmark::MakeChains(top, nbeads / chainlength, chainlength, 10.0,
+                               "cubic");
+
+    tools::benchmark::timing_t create = tools::benchmark::Measure(
+        [&]() { top.RebuildExclusions(); }, 0.5, 10);
+    tools::benchmark::Record("exclusionlist", "CreateExclusions")
+        .Add("beads", top.BeadCount())
+        .Add("chainlength", chainlength)
+        .Add(create, double(top.BeadCount()), "beads/s")
+        .Print();
+
+    // half of the queries are pairs of the same chain, which are excluded
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<Index> bead(0, top.BeadCount() - 1);
+    std::uniform_int_distribution<Index> offset(1, chainlength - 1);
+    std::vector<std::pair<csg::Bead *, csg::Bead *>> queries;
+    queries.reserve(nqueries);
+    for (Index i = 0; i < nqueries; ++i) {
+      Index b1 = bead(gen);
+      Index b2 = (i % 2) ? bead(gen)
+                         : (b1 / chainlength) * chainlength +
+                               (b1 % chainlength + offset(gen)) % chainlength;
+      queries.emplace_back(top.getBead(b1), top.getBead(b2));
+    }
+
+    const csg::ExclusionList &exclusions = top.getExclusions();
+    Index excluded = 0;
+    tools::benchmark::timing_t query = tools::benchmark::Measure([&]() {
+      excluded = 0;
+      for (const auto &pair : queries) {
+        excluded += exclusions.IsExcluded(pair.first, pair.second);
+      }
+    });
+    tools::benchmark::Record("exclusionlist", "IsExcluded")
+        .Add("beads", top.BeadCount())
+        .Add("chainlength", chainlength)
+        .Add("queries", nqueries)
+        .Add("excluded", excluded)
+        .Add(query, double(nqueries), "queries/s")
+        .Print();
+  }
+  return 0;
+}
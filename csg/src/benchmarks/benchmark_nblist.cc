@@ -0,0 +1,132 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Neighbour search with NBListGrid for several system sizes, densities and
+// box shapes, with and without exclusions, and the throughput of independent
+// searches in parallel like the frame workers of csg_stat. Prints one json
+// object per case.
+
+// Standard includes
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/taskpool.h>
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/beadlist.h"
+#include "votca/csg/nblistgrid.h"
+#include "votca/csg/topology.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+#include "benchmark_systems.h"
+
+using namespace votca;
+
+namespace {
+
+const double cutoff = 1.0;
+const Index chainlength = 10;
+
+Index Search(csg::Topology &top, bool exclusions) {
+  csg::BeadList beads;
+  beads.Generate(top, "*");
+  csg::NBListGrid nb;
+  nb.setCutoff(cutoff);
+  nb.Generate(beads, exclusions);
+  return nb.size();
+}
+
+void RunSearch(Index nbeads, double density, const std::string &shape,
+               bool exclusions) {
+  csg::Topology top;
+  csg::benchmark::MakeChains(top, nbeads / chainlength, chainlength, density,
+                             shape);
+  top.RebuildExclusions();
+  Index pairs = 0;
+  tools::benchmark::timing_t timing = tools::benchmark::Measure(
+      [&]() { pairs = Search(top, exclusions); }, 0.5, 20);
+  tools::benchmark::Record("nblist", "NBListGrid::Generate")
+      .Add("beads", nbeads)
+      .Add("density", density)
+      .Add("shape", shape)
+      .Add("exclusions", Index(exclusions))
+      .Add("cutoff", cutoff)
+      .Add("pairs", pairs)
+      .Add(timing, double(nbeads), "beads/s")
+      .Print();
+}
+
+void RunThreads(Index nbeads, Index nthreads) {
+  // every thread searches its own copy of the system
+  std::vector<std::unique_ptr<csg::Topology>> tops;
+  for (Index i = 0; i < nthreads; ++i) {
+    tops.push_back(std::make_unique<csg::Topology>());
+    csg::benchmark::MakeChains(*tops.back(), nbeads / chainlength,
+                               chainlength, 10.0, "cubic", true,
+                               unsigned(42 + i));
+    tops.back()->RebuildExclusions();
+  }
+  tools::TaskPool pool(nthreads);
+  const Index frames_per_thread = 4;
+  tools::benchmark::timing_t timing = tools::benchmark::Measure(
+      [&]() {
+        pool.ParallelFor(
+            0, nthreads,
+            [&](Index i) {
+              for (Index frame = 0; frame < frames_per_thread; ++frame) {
+                Search(*tops[i], true);
+              }
+            },
+            1);
+      },
+      0.5, 10);
+  tools::benchmark::Record("nblist", "NBListGrid::Generate parallel")
+      .Add("beads", nbeads)
+      .Add("threads", nthreads)
+      .Add(timing, double(nthreads * frames_per_thread), "frames/s")
+      .Print();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Index maxbeads = (argc > 1) ? std::atol(argv[1]) : 30000;
+
+  for (Index nbeads = 1000; nbeads <= maxbeads; nbeads *= 3) {
+    RunSearch(nbeads, 10.0, "cubic", true);
+  }
+  for (double density : {3.0, 10.0, 30.0}) {
+    for (const char *shape : {"cubic", "elongated", "triclinic"}) {
+      RunSearch(10000, density, shape, true);
+    }
+  }
+  RunSearch(10000, 10.0, "cubic", false);
+
+  Index hardware =
+      std::max(Index(1), Index(std::thread::hardware_concurrency()));
+  for (Index nthreads = 1; nthreads <= hardware; nthreads *= 2) {
+    RunThreads(10000, nthreads);
+  }
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_BENCHMARK_SYSTEMS_H
+#define VOTCA_CSG_BENCHMARK_SYSTEMS_H
+
+// Standard includes
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// VOTCA includes
+#include <votca/tools/eigen.h>
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/interaction.h"
+#include "votca/csg/molecule.h"
+#include "votca/csg/topology.h"
+
+namespace votca {
+namespace csg {
+namespace benchmark {
+
+/*
+ * Generators of synthetic systems for the csg microbenchmarks.
+ */
+
+/**
+ * \brief box of a given volume
+ *
+ * shape is "cubic", "elongated" (edge lengths 1:1:4) or "triclinic" (a cube
+ * with c tilted by a quarter of the edge length towards a and b)
+ */
+inline Eigen::Matrix3d MakeBox(const std::string &shape, double volume) {
+  Eigen::Matrix3d box = Eigen::Matrix3d::Zero();
+  if (shape == "cubic") {
+    box.diagonal().setConstant(std::cbrt(volume));
+  } else if (shape == "elongated") {
+    double a = std::cbrt(volume / 4.0);
+    box.diagonal() << a, a, 4.0 * a;
+  } else if (shape == "triclinic") {
+    double a = std::cbrt(volume);
+    box.diagonal().setConstant(a);
+    box(0, 2) = 0.25 * a;
+    box(1, 2) = 0.25 * a;
+  } else {
+    throw std::runtime_error("unknown box shape " + shape);
+  }
+  return box;
+}
+
+/**
+ * \brief fills top with linear chains at a given bead number density
+ *
+ * Chains are random walks with a bond length of 0.15 nm wrapped into the box.
+ * Each chain is a molecule and residue "CHAIN", its beads are called A0, A1, ...
+ * and registered in the molecule as "1:CHAIN:A<i>" like the gromacs
+ * topology reader does. Neighbouring beads are connected by bonds of the
+ * group "bond", if bonds is true.
+ */
+inline void MakeChains(Topology &top, Index nchains, Index chainlength,
+                       double density, const std::string &shape,
+                       bool bonds = true, unsigned seed = 42) {
+  const Eigen::Matrix3d box =
+      MakeBox(shape, double(nchains * chainlength) / density);
+  const Eigen::Matrix3d inverse = box.inverse();
+  top.setBox(box);
+  top.RegisterBeadType("A");
+
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  const double bondlength = 0.15;
+
+  for (Index c = 0; c < nchains; ++c) {
+    top.CreateResidue("CHAIN");
+    Molecule *mol = top.CreateMolecule("CHAIN");
+    Eigen::Vector3d pos =
+        box * Eigen::Vector3d(uniform(gen), uniform(gen), uniform(gen));
+    for (Index i = 0; i < chainlength; ++i) {
+      if (i > 0) {
+        Eigen::Vector3d step(normal(gen), normal(gen), normal(gen));
+        pos += bondlength * step.normalized();
+      }
+      // wrap into the box
+      Eigen::Vector3d s = inverse * pos;
+      s = s.array() - s.array().floor();
+      std::string name = "A" + std::to_string(i);
+      Bead *bead = top.CreateBead(Bead::spherical, name, "A", c, 1.0, 0.0);
+      bead->setPos(box * s);
+      mol->AddBead(bead, "1:CHAIN:" + name);
+      if (bonds && i > 0) {
+        Interaction *ic = new IBond(bead->getId() - 1, bead->getId());
+        ic->setGroup("bond");
+        ic->setIndex(c * (chainlength - 1) + i - 1);
+        ic->setMolecule(mol->getId());
+        top.AddBondedInteraction(ic);
+        mol->AddInteraction(ic);
+      }
+    }
+  }
+}
+
+/**
+ * \brief writes a mapping file for the chains of MakeChains
+ *
+ * Every group of beads_per_cg consecutive beads is mapped to one center of
+ * mass coarse-grained bead.
+ */
+inline void WriteChainMapping(const std::string &filename, Index chainlength,
+                              Index beads_per_cg) {
+  std::ofstream out(filename);
+  out << "<cg_molecule>\n  <name>CHAIN</name>\n  <ident>CHAIN</ident>\n";
+  out << "  <topology>\n    <cg_beads>\n";
+  for (Index k = 0; k < chainlength / beads_per_cg; ++k) {
+    out << "      <cg_bead>\n        <name>B" << k << "</name>\n";
+    out << "        <type>B</type>\n        <mapping>A</mapping>\n";
+    out << "        <beads>";
+    for (Index i = 0; i < beads_per_cg; ++i) {
+      out << " 1:CHAIN:A" << k * beads_per_cg + i;
+    }
+    out << "</beads>\n      </cg_bead>\n";
+  }
+  out << "    </cg_beads>\n  </topology>\n";
+  out << "  <maps>\n    <map>\n      <name>A</name>\n      <weights>";
+  for (Index i = 0; i < beads_per_cg; ++i) {
+    out << " 1";
+  }
+  out << "</weights>\n    </map>\n  </maps>\n</cg_molecule>\n";
+}
+
+}  // namespace benchmark
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_BENCHMARK_SYSTEMS_H
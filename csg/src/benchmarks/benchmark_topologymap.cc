@@ -0,0 +1,118 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Maps chains to center of mass beads with TopologyMap::Apply for several
+// system sizes and mapping ratios, and the throughput of independent maps in
+// parallel like the frame workers of csg_stat. Prints one json object per
+// case.
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/taskpool.h>
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/cgengine.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/topologymap.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+#include "benchmark_systems.h"
+
+using namespace votca;
+
+namespace {
+
+const Index chainlength = 12;
+const std::string mappingfile = "benchmark_topologymap.xml";
+
+struct system_t {
+  csg::Topology atomistic;
+  csg::Topology cg;
+  std::unique_ptr<csg::TopologyMap> map;
+};
+
+std::unique_ptr<system_t> MakeSystem(Index nbeads, Index beads_per_cg,
+                                     unsigned seed = 42) {
+  auto system = std::make_unique<system_t>();
+  csg::benchmark::MakeChains(system->atomistic, nbeads / chainlength,
+                             chainlength, 100.0, "cubic", false, seed);
+  csg::benchmark::WriteChainMapping(mappingfile, chainlength, beads_per_cg);
+  csg::CGEngine engine;
+  engine.LoadMoleculeType(mappingfile);
+  system->map = engine.CreateCGTopology(system->atomistic, system->cg);
+  return system;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Index maxbeads = (argc > 1) ? std::atol(argv[1]) : 1000000;
+
+  for (Index nbeads = 12000; nbeads <= maxbeads; nbeads *= 10) {
+    for (Index beads_per_cg : {1, 3, 12}) {
+      std::unique_ptr<system_t> system = MakeSystem(nbeads, beads_per_cg);
+      tools::benchmark::timing_t timing =
+          tools::benchmark::Measure([&]() { system->map->Apply(); });
+      tools::benchmark::Record("topologymap", "TopologyMap::Apply")
+          .Add("beads", nbeads)
+          .Add("cg_beads", system->cg.BeadCount())
+          .Add("beads_per_cg", beads_per_cg)
+          .Add(timing, double(nbeads), "beads/s")
+          .Print();
+    }
+  }
+
+  // every thread maps its own copy of the system
+  const Index nbeads = 120000;
+  Index hardware =
+      std::max(Index(1), Index(std::thread::hardware_concurrency()));
+  for (Index nthreads = 1; nthreads <= hardware; nthreads *= 2) {
+    std::vector<std::unique_ptr<system_t>> systems;
+    for (Index i = 0; i < nthreads; ++i) {
+      systems.push_back(MakeSystem(nbeads, 3, unsigned(42 + i)));
+    }
+    tools::TaskPool pool(nthreads);
+    const Index frames_per_thread = 8;
+    tools::benchmark::timing_t timing = tools::benchmark::Measure([&]() {
+      pool.ParallelFor(
+          0, nthreads,
+          [&](Index i) {
+            for (Index frame = 0; frame < frames_per_thread; ++frame) {
+              systems[i]->map->Apply();
+            }
+          },
+          1);
+    });
+    tools::benchmark::Record("topologymap", "TopologyMap::Apply parallel")
+        .Add("beads", nbeads)
+        .Add("threads", nthreads)
+        .Add(timing, double(nthreads * frames_per_thread), "frames/s")
+        .Print();
+  }
+  std::remove(mappingfile.c_str());
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Writes a synthetic trajectory in every format that has a reader and a
+// writer and measures how many frames per second the reader delivers. The
+// gromacs formats are only available if csg was built with gromacs, they are
+// read with several thread counts since their reader decodes frames in
+// parallel. Prints one json object per case.
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+// VOTCA includes
+#include <votca/tools/taskpool.h>
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/topology.h"
+#include "votca/csg/trajectoryreader.h"
+#include "votca/csg/trajectorywriter.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+#include "benchmark_systems.h"
+
+using namespace votca;
+
+namespace {
+
+void WriteTrajectory(csg::Topology &top, const std::string &filename,
+                     Index nframes) {
+  tools::benchmark::QuietStdout quiet;
+  std::unique_ptr<csg::TrajectoryWriter> writer =
+      csg::TrjWriterFactory().Create(filename);
+  writer->Open(filename);
+  for (Index frame = 0; frame < nframes; ++frame) {
+    top.setStep(frame);
+    top.setTime(0.01 * double(frame));
+    writer->Write(&top);
+  }
+  writer->Close();
+}
+
+Index ReadTrajectory(csg::Topology &top, const std::string &filename) {
+  tools::benchmark::QuietStdout quiet;
+  std::unique_ptr<csg::TrajectoryReader> reader =
+      csg::TrjReaderFactory().Create(filename);
+  reader->Open(filename);
+  Index nframes = 0;
+  for (bool ok = reader->FirstFrame(top); ok; ok = reader->NextFrame(top)) {
+    nframes++;
+  }
+  reader->Close();
+  return nframes;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Index nbeads = (argc > 1) ? std::atol(argv[1]) : 10000;
+  Index nframes = (argc > 2) ? std::atol(argv[2]) : 50;
+
+  csg::TrajectoryWriter::RegisterPlugins();
+  csg::TrajectoryReader::RegisterPlugins();
+
+  csg::Topology top;
+  csg::benchmark::MakeChains(top, nbeads / 10, 10, 10.0, "cubic", false);
+
+  Index hardware =
+      std::max(Index(1), Index(std::thread::hardware_concurrency()));
+  for (const char *format : {"xyz", "gro", "pdb", "dump", "xtc", "trr"}) {
+    const std::string filename = std::string("benchmark_trajectory.") + format;
+    if (!csg::TrjWriterFactory().IsRegistered(format) ||
+        !csg::TrjReaderFactory().IsRegistered(format)) {
+      continue;
+    }
+    try {
+      WriteTrajectory(top, filename, nframes);
+      double megabytes = double(std::filesystem::file_size(filename)) / 1e6;
+
+      const bool threaded =
+          std::string(format) == "xtc" || std::string(format) == "trr";
+      for (Index nthreads = 1; nthreads <= (threaded ? hardware : 1);
+           nthreads *= 2) {
+        tools::TaskPool::setGlobalThreadCount(nthreads);
+        Index read = 0;
+        tools::benchmark::timing_t timing = tools::benchmark::Measure(
+            [&]() { read = ReadTrajectory(top, filename); }, 0.5, 10);
+        tools::benchmark::Record("trajectory", "TrajectoryReader")
+            .Add("format", format)
+            .Add("beads", top.BeadCount())
+            .Add("frames", read)
+            .Add("threads", nthreads)
+            .Add("megabytes_per_second", megabytes / timing.best)
+            .Add(timing, double(read), "frames/s")
+            .Print();
+      }
+    } catch (std::exception &e) {
+      // a broken format must not hide the results of the others
+      tools::benchmark::Record("trajectory", "TrajectoryReader")
+          .Add("format", format)
+          .Add("error", e.what())
+          .Print();
+    }
+    std::remove(filename.c_str());
+  }
+  return 0;
+}
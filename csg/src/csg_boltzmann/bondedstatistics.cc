@@ -32,13 +32,14 @@ void BondedStatistics::BeginCG(Topology *top, Topology *) {
 void BondedStatistics::EndCG() {}
 
 void BondedStatistics::EvalConfiguration(Topology *conf, Topology *) {
-  InteractionContainer &ic = conf->BondedInteractions();
-  InteractionContainer::iterator ia;
-
-  DataCollection<double>::iterator is;
-  for (ia = ic.begin(), is = bonded_values_.begin(); ia != ic.end();
-       ++ia, ++is) {
-    (*is)->push_back((*ia)->EvaluateVar(*conf));
+  // the arrays are ordered like conf->BondedInteractions(), the tables
+  // remember the position of each interaction in there
+  Eigen::VectorXd values;
+  for (const InteractionTable &table : conf->BondedInteractionTables()) {
+    table.EvaluateVar(*conf, values);
+    for (Index i = 0; i < table.size(); ++i) {
+      bonded_values_[table.getInteractionId(i)].push_back(values[i]);
+    }
   }
 }
 
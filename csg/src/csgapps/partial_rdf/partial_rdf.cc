@@ -51,7 +51,9 @@ class CsgPartialRdfApp : public CsgApplication {
   bool DoMapping() override { return true; }
   bool DoMappingDefault(void) override { return false; }
   bool DoThreaded() override { return true; }
-  bool SynchronizeThreads() override { return true; }
+  // workers keep thread-local histograms, ordered merging is only needed
+  // when writing blocks
+  bool SynchronizeThreads() override { return write_every_ != 0; }
   void Initialize() override;
   bool EvaluateOptions() override;
 
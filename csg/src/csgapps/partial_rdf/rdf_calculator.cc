@@ -16,6 +16,7 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -66,6 +67,34 @@ void RDFCalculator::Initialize() {
   for (Property *prop : nonbonded_) {
     interaction_t *i = AddInteraction(prop);
     i->is_bonded_ = false;
+
+    // interactions with the same types share one neighbour search
+    std::string type1 = prop->get("type1").value();
+    std::string type2 = prop->get("type2").value();
+    auto search = std::find_if(
+        searches_.begin(), searches_.end(), [&](const search_t &s) {
+          return s.type1_ == type1 && s.type2_ == type2;
+        });
+    if (search == searches_.end()) {
+      searches_.push_back(search_t());
+      search = searches_.end() - 1;
+      search->type1_ = type1;
+      search->type2_ = type2;
+    }
+    search->cutoff_ = std::max(search->cutoff_, i->max_ + i->step_);
+    search->interactions_.push_back(i);
+  }
+  std::cout << "# of neighbour searches per frame: " << searches_.size()
+            << std::endl;
+
+  if (options_.exists("cg.nbsearch")) {
+    if (options_.get("cg.nbsearch").as<std::string>() == "grid") {
+      gridsearch_ = true;
+    } else if (options_.get("cg.nbsearch").as<std::string>() == "simple") {
+      gridsearch_ = false;
+    } else {
+      throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
+    }
   }
 }
 
@@ -168,12 +197,14 @@ void RDFCalculator::LoadOptions(const std::string &file) {
 
 // evaluate current conformation
 void RDFCalculator::Worker::EvalConfiguration(Topology *top, Topology *) {
-  cur_vol_ = 4.0 / 3.0 * votca::tools::conv::Pi * rdfcalculator_->subvol_rad_ *
-             rdfcalculator_->subvol_rad_ * rdfcalculator_->subvol_rad_;
+  vol_.Process(4.0 / 3.0 * votca::tools::conv::Pi *
+               rdfcalculator_->subvol_rad_ * rdfcalculator_->subvol_rad_ *
+               rdfcalculator_->subvol_rad_);
   // process non-bonded interactions
   DoNonbonded(top);
   // process bonded interactions
   DoBonded(top);
+  ++nframes_;
 }
 
 void RDFCalculator::ClearAverages() {
@@ -190,31 +221,35 @@ void RDFCalculator::ClearAverages() {
 
 class IMCNBSearchHandler {
  public:
-  IMCNBSearchHandler(HistogramNew *hist, double subvol_rad,
-                     Eigen::Vector3d boxc, bool do_vol_corr)
-      : hist_(hist),
-        subvol_rad_(subvol_rad),
-        boxc_(boxc),
-        do_vol_corr_(do_vol_corr) {}
-
-  HistogramNew *hist_;
+  IMCNBSearchHandler(double subvol_rad, Eigen::Vector3d boxc,
+                     bool do_vol_corr)
+      : subvol_rad_(subvol_rad), boxc_(boxc), do_vol_corr_(do_vol_corr) {}
+
+  /// add a histogram which is filled with all pairs closer than cutoff
+  void AddHistogram(HistogramNew *hist, double cutoff) {
+    hists_.push_back(hist);
+    cutoffs_.push_back(cutoff);
+  }
+
+  std::vector<HistogramNew *> hists_;
+  std::vector<double> cutoffs_;
   double subvol_rad_;
   Eigen::Vector3d boxc_;  // center of box
   bool do_vol_corr_;
 
   bool FoundPair(Bead *b1, Bead *, const Eigen::Vector3d &, const double dist) {
-
+    double scale = 1.0;
     if (do_vol_corr_) {
       double dr = (b1->Pos() - boxc_).norm();
       if (dist + dr > subvol_rad_) {
         // 2.0 is because everything is normalized to 4 PI
-        hist_->Process(dist, 2.0 / SurfaceRatio(dist, dr));
-      } else {
-        hist_->Process(dist);
+        scale = 2.0 / SurfaceRatio(dist, dr);
+      }
+    }
+    for (std::size_t k = 0; k < hists_.size(); ++k) {
+      if (dist < cutoffs_[k]) {
+        hists_[k]->Process(dist, scale);
       }
-
-    } else {
-      hist_->Process(dist);
     }
     return false;
   }
@@ -229,71 +264,51 @@ class IMCNBSearchHandler {
 
 // process non-bonded interactions for current frame
 void RDFCalculator::Worker::DoNonbonded(Topology *top) {
-  for (Property *prop : rdfcalculator_->nonbonded_) {
-    std::string name = prop->get("name").value();
-
-    interaction_t &i = *rdfcalculator_->interactions_[name];
-
+  for (search_t &search : rdfcalculator_->searches_) {
     // generate the bead lists
     BeadList beads1, beads2;
 
-    beads1.GenerateInSphericalSubvolume(*top, prop->get("type1").value(),
+    beads1.GenerateInSphericalSubvolume(*top, search.type1_,
                                         rdfcalculator_->boxc_,
                                         rdfcalculator_->subvol_rad_);
-    beads2.GenerateInSphericalSubvolume(*top, prop->get("type2").value(),
+    beads2.GenerateInSphericalSubvolume(*top, search.type2_,
                                         rdfcalculator_->boxc_,
                                         rdfcalculator_->subvol_rad_);
 
-    cur_beadlist_1_count_ = (double)beads1.size();
-    cur_beadlist_2_count_ = (double)beads2.size();
+    double beadlist_1_count = (double)beads1.size();
+    double beadlist_2_count = (double)beads2.size();
 
     // same types, so put factor 1/2 because of already counted interactions
-    if (prop->get("type1").value() == prop->get("type2").value()) {
-      cur_beadlist_2_count_ /= 2.0;
+    if (search.type1_ == search.type2_) {
+      beadlist_2_count /= 2.0;
     }
 
     // generate the neighbour list
     std::unique_ptr<NBList> nb;
-
-    bool gridsearch = true;
-
-    if (rdfcalculator_->options_.exists("cg.nbsearch")) {
-      if (rdfcalculator_->options_.get("cg.nbsearch").as<std::string>() ==
-          "grid") {
-        gridsearch = true;
-      } else if (rdfcalculator_->options_.get("cg.nbsearch")
-                     .as<std::string>() == "simple") {
-        gridsearch = false;
-      } else {
-        throw std::runtime_error("cg.nbsearch invalid, can be grid or simple");
-      }
-    }
-    if (gridsearch) {
+    if (rdfcalculator_->gridsearch_) {
       nb = std::make_unique<NBListGrid>();
     } else {
       nb = std::make_unique<NBList>();
     }
 
-    nb->setCutoff(i.max_ + i.step_);
+    nb->setCutoff(search.cutoff_);
 
-    // clear the current histogram
-    current_hists_[i.index_].Clear();
-
-    IMCNBSearchHandler h(&(current_hists_[i.index_]),
-                         rdfcalculator_->subvol_rad_, rdfcalculator_->boxc_,
+    IMCNBSearchHandler h(rdfcalculator_->subvol_rad_, rdfcalculator_->boxc_,
                          rdfcalculator_->do_vol_corr_);
+    for (interaction_t *i : search.interactions_) {
+      h.AddHistogram(&(current_hists_[i->index_]), i->max_ + i->step_);
+      // store particle number in subvolume for each interaction
+      beadlist_1_count_[i->index_].Process(beadlist_1_count);
+      beadlist_2_count_[i->index_].Process(beadlist_2_count);
+    }
     nb->SetMatchFunction(&h, &IMCNBSearchHandler::FoundPair);
 
     // is it same types or different types?
-    if (prop->get("type1").value() == prop->get("type2").value()) {
+    if (search.type1_ == search.type2_) {
       nb->Generate(beads1);
     } else {
       nb->Generate(beads1, beads2);
     }
-
-    // store particle number in subvolume for each interaction
-    i.avg_beadlist_1_count_.Process(cur_beadlist_1_count_);
-    i.avg_beadlist_2_count_.Process(cur_beadlist_2_count_);
   }
 }
 
@@ -304,14 +319,10 @@ void RDFCalculator::Worker::DoBonded(Topology *top) {
 
     interaction_t &i = *rdfcalculator_->interactions_[name];
 
-    // clear the current histogram
-    current_hists_[i.index_].Clear();
-
     // now fill with new data
-    std::vector<Interaction *> vec = top->InteractionsInGroup(name);
-
-    for (auto ic : vec) {
-      double v = ic->EvaluateVar(*top);
+    Eigen::VectorXd values;
+    top->BondedInteractionTable(name).EvaluateVar(*top, values);
+    for (double v : values) {
       current_hists_[i.index_].Process(v);
     }
   }
@@ -363,6 +374,8 @@ std::unique_ptr<CsgApplication::Worker> RDFCalculator::ForkWorker() {
   auto worker = std::make_unique<RDFCalculator::Worker>();
 
   worker->current_hists_.resize(interactions_.size());
+  worker->beadlist_1_count_.resize(interactions_.size());
+  worker->beadlist_2_count_.resize(interactions_.size());
   worker->rdfcalculator_ = this;
 
   for (auto &interaction_ : interactions_) {
@@ -374,22 +387,33 @@ std::unique_ptr<CsgApplication::Worker> RDFCalculator::ForkWorker() {
 }
 
 void RDFCalculator::MergeWorker(CsgApplication::Worker *worker_) {
-  processed_some_frames_ = true;
   RDFCalculator::Worker *worker =
       dynamic_cast<RDFCalculator::Worker *>(worker_);
-  // update the average
+  if (worker->nframes_ == 0) {
+    return;
+  }
+  processed_some_frames_ = true;
+  // update the average, the worker histograms hold the sum over all frames
+  // it processed since the last merge
 
-  ++nframes_;
+  nframes_ += worker->nframes_;
 
-  avg_vol_.Process(worker->cur_vol_);
+  avg_vol_.Merge(worker->vol_);
 
   for (auto &interaction_ : interactions_) {
     interaction_t *i = interaction_.second.get();
     i->average_.data().y() =
-        (((double)nframes_ - 1.0) * i->average_.data().y() +
+        (((double)(nframes_ - worker->nframes_)) * i->average_.data().y() +
          worker->current_hists_[i->index_].data().y()) /
         (double)nframes_;
+    i->avg_beadlist_1_count_.Merge(worker->beadlist_1_count_[i->index_]);
+    i->avg_beadlist_2_count_.Merge(worker->beadlist_2_count_[i->index_]);
+    worker->current_hists_[i->index_].Clear();
+    worker->beadlist_1_count_[i->index_].Clear();
+    worker->beadlist_2_count_[i->index_].Clear();
   }
+  worker->vol_.Clear();
+  worker->nframes_ = 0;
 
   if (write_every_ != 0) {
     if ((nframes_ % write_every_) == 0) {
@@ -97,6 +97,14 @@ class RDFCalculator {
     Average<double> avg_beadlist_2_count_;
   };
 
+  /// non-bonded interactions sharing the same bead types, they are served by
+  /// one neighbour search per frame
+  struct search_t {
+    std::string type1_, type2_;
+    double cutoff_ = 0;
+    std::vector<interaction_t *> interactions_;
+  };
+
   // a pair of interactions which are correlated
   struct pair_t {
     interaction_t *i1_;
@@ -137,6 +145,10 @@ class RDFCalculator {
   std::map<std::string, std::unique_ptr<interaction_t>> interactions_;
   /// std::map group-name to group
   std::map<std::string, std::unique_ptr<group_t>> groups_;
+  /// neighbour searches, one per pair of bead types
+  std::vector<search_t> searches_;
+  /// use the grid search instead of the simple N^2 search
+  bool gridsearch_ = true;
 
   /// create a new interaction entry based on given options
   interaction_t *AddInteraction(Property *p);
@@ -148,14 +160,22 @@ class RDFCalculator {
 
   void ClearAverages();
 
+  /**
+   * \brief Worker accumulating thread-local histograms
+   *
+   * The histograms and averages are summed over all frames the worker
+   * processed since the last MergeWorker call, so the worker can run
+   * without synchronisation and is merged only once at the end.
+   */
   class Worker : public CsgApplication::Worker {
    public:
     std::vector<HistogramNew> current_hists_;
     RDFCalculator *rdfcalculator_;
-    double cur_vol_;
-    double cur_beadlist_1_count_;  // need to normalize to avg density for
-                                   // subvol
-    double cur_beadlist_2_count_;
+    Index nframes_ = 0;
+    Average<double> vol_;
+    // need to normalize to avg density for subvol
+    std::vector<Average<double>> beadlist_1_count_;
+    std::vector<Average<double>> beadlist_2_count_;
 
     /// evaluate current conformation
     void EvalConfiguration(Topology *top, Topology *top_atom) override;
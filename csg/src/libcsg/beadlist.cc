@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,7 +16,7 @@
  */
 
 // VOTCA includes
-#include <votca/tools/tokenizer.h>
+#include <votca/tools/internedstring.h>
 
 // Local VOTCA includes
 #include "votca/csg/beadlist.h"
@@ -40,13 +40,15 @@ Index BeadList::Generate(Topology &top, const string &select) {
     pSelect = select;
   }
 
+  // the pattern is compared once per distinct name or type, not per bead
+  tools::InternedWildcard match(pSelect);
   for (auto &bead : top.Beads()) {
     if (!selectByName) {
-      if (tools::wildcmp(pSelect, bead.getType())) {
+      if (match(bead.getInternedType())) {
         beads_.push_back(&bead);
       }
     } else {
-      if (tools::wildcmp(pSelect, bead.getName())) {
+      if (match(bead.getInternedName())) {
         beads_.push_back(&bead);
       }
     }
@@ -70,16 +72,17 @@ Index BeadList::GenerateInSphericalSubvolume(Topology &top,
     pSelect = select;
   }
 
+  tools::InternedWildcard match(pSelect);
   for (auto &bead : top.Beads()) {
     if (topology_->BCShortestConnection(ref, bead.getPos()).norm() > radius) {
       continue;
     }
     if (!selectByName) {
-      if (tools::wildcmp(pSelect, bead.getType())) {
+      if (match(bead.getInternedType())) {
         beads_.push_back(&bead);
       }
     } else {
-      if (tools::wildcmp(pSelect, bead.getName())) {
+      if (match(bead.getInternedName())) {
         beads_.push_back(&bead);
       }
     }
@@ -16,6 +16,7 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <cassert>
 
 // VOTCA includes
@@ -128,6 +129,7 @@ void BeadStructure::ConnectBeads(const Index &bead1_id, const Index &bead2_id) {
     single_structureUpToDate_ = false;
     graphUpToDate = false;
     structureIdUpToDate = false;
+    structureHashUpToDate = false;
   }
 }
 
@@ -166,7 +168,60 @@ bool BeadStructure::isSingleStructure() {
   return single_structure_;
 }
 
+std::uint64_t BeadStructure::getStructureHash() {
+  InitializeGraph_();
+  if (!structureHashUpToDate) {
+    // graph_ is modified when the structure id is calculated, so the hash is
+    // calculated from the unmodified nodes
+    std::vector<tools::Edge> connections_vector(connections_.begin(),
+                                                connections_.end());
+    structure_hash_ =
+        tools::CompressedGraph(connections_vector, graphnodes_).CanonicalHash();
+    structureHashUpToDate = true;
+  }
+  return structure_hash_;
+}
+
+bool BeadStructure::MatchesInIdOrder_(
+    const BeadStructure &beadstructure) const {
+  if (beads_.size() != beadstructure.beads_.size() ||
+      connections_.size() != beadstructure.connections_.size()) {
+    return false;
+  }
+  std::vector<Index> ids = getBeadIds();
+  std::vector<Index> other_ids = beadstructure.getBeadIds();
+  std::sort(ids.begin(), ids.end());
+  std::sort(other_ids.begin(), other_ids.end());
+  std::unordered_map<Index, Index> to_other;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    const BeadInfo &bead = beads_.at(ids[i]);
+    const BeadInfo &other_bead = beadstructure.beads_.at(other_ids[i]);
+    if (bead.name != other_bead.name || bead.mass != other_bead.mass) {
+      return false;
+    }
+    to_other[ids[i]] = other_ids[i];
+  }
+  for (const tools::Edge &edge : connections_) {
+    tools::Edge other_edge(to_other.at(edge.getEndPoint1()),
+                           to_other.at(edge.getEndPoint2()));
+    if (beadstructure.connections_.count(other_edge) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool BeadStructure::isStructureEquivalent(BeadStructure &beadstructure) {
+  // structures with different hashes can not be equivalent
+  if (getStructureHash() != beadstructure.getStructureHash()) {
+    return false;
+  }
+  // Equal hashes are not a proof, but copies of the same molecule usually list
+  // their beads in the same order, which is checked in O(V+E). The expensive
+  // structure id is only built for permuted bead ids or hash collisions.
+  if (MatchesInIdOrder_(beadstructure)) {
+    return true;
+  }
   if (!structureIdUpToDate) {
     CalculateStructure_();
   }
@@ -19,6 +19,9 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <memory>
 
+// VOTCA includes
+#include <votca/tools/taskpool.h>
+
 // Local VOTCA includes
 #include "votca/csg/cgengine.h"
 #include "votca/csg/csgapplication.h"
@@ -66,6 +69,9 @@ void CsgApplication::Initialize() {
     AddProgramOptions("Trajectory options")(
         "trj", boost::program_options::value<std::string>(),
         "  atomistic trajectory file")(
+        "trj-format", boost::program_options::value<std::string>(),
+        "  read the trajectory with this reader instead of the one for its "
+        "extension, e.g. xdr for the native xtc/trr reader")(
         "begin", boost::program_options::value<double>()->default_value(0.0),
         "  skip frames before this time (only works for Gromacs files)")(
         "first-frame", boost::program_options::value<Index>()->default_value(0),
@@ -82,6 +88,10 @@ void CsgApplication::Initialize() {
         "nt", boost::program_options::value<Index>()->default_value(1),
         "  number of threads");
   }
+
+  AddProgramOptions("Profiling options")(
+      "profile", boost::program_options::value<std::string>(),
+      "  write timings and counters of the run to this file (.json or .xml)");
 }
 
 bool CsgApplication::EvaluateOptions() {
@@ -113,12 +123,18 @@ bool CsgApplication::EvaluateOptions() {
   /* check threading options */
   if (DoThreaded()) {
     nthreads_ = OptionsMap()["nt"].as<Index>();
+    // the frame workers are threads of their own, tasks of the libraries
+    // (e.g. frame decoding) only get the remaining hardware threads
+    tools::TaskPool::setGlobalThreadCount(std::max(
+        Index(1), tools::TaskPool::HardwareThreadCount() - nthreads_));
     /* TODO
      * does the number of threads make sense?
      * which criteria should be used? smaller than system's cores?
      */
   }
 
+  profiler_.Enable(OptionsMap().count("profile") > 0);
+
   return true;
 }
 
@@ -138,8 +154,14 @@ void CsgApplication::Worker::Run() {
   while (app_->ProcessData(this)) {
     if (app_->SynchronizeThreads()) {
       Index id = getId();
-      app_->threadsMutexesOut_[id]->Lock();
-      app_->MergeWorker(this);
+      {
+        CsgProfiler::ScopedTimer timer(app_->profiler_, "wait_output", id);
+        app_->threadsMutexesOut_[id]->Lock();
+      }
+      {
+        CsgProfiler::ScopedTimer timer(app_->profiler_, "merge", id);
+        app_->MergeWorker(this);
+      }
       app_->threadsMutexesOut_[(id + 1) % app_->nthreads_]->Unlock();
     }
   }
@@ -150,11 +172,14 @@ bool CsgApplication::ProcessData(Worker *worker) {
   Index id;
   id = worker->getId();
 
-  if (SynchronizeThreads()) {
-    // wait til its your turn
-    threadsMutexesIn_[id]->Lock();
+  {
+    CsgProfiler::ScopedTimer timer(profiler_, "wait_input", id);
+    if (SynchronizeThreads()) {
+      // wait til its your turn
+      threadsMutexesIn_[id]->Lock();
+    }
+    traj_readerMutex_.Lock();
   }
-  traj_readerMutex_.Lock();
   if (nframes_ == 0) {
     traj_readerMutex_.Unlock();
 
@@ -168,7 +193,11 @@ bool CsgApplication::ProcessData(Worker *worker) {
   nframes_--;
   if (!is_first_frame_ || worker->getId() != 0) {
     // get frame
-    bool tmpRes = traj_reader_->NextFrame(worker->top_);
+    bool tmpRes;
+    {
+      CsgProfiler::ScopedTimer timer(profiler_, "decode", id);
+      tmpRes = traj_reader_->NextFrame(worker->top_);
+    }
     if (!tmpRes) {
       traj_readerMutex_.Unlock();
       if (SynchronizeThreads()) {
@@ -186,11 +215,17 @@ bool CsgApplication::ProcessData(Worker *worker) {
     // unlock next frame for input
     threadsMutexesIn_[(id + 1) % nthreads_]->Unlock();
   }
+  profiler_.AddCount("frames");
   // evaluate
   if (do_mapping_) {
-    worker->map_->Apply();
+    {
+      CsgProfiler::ScopedTimer timer(profiler_, "mapping", id);
+      worker->map_->Apply();
+    }
+    CsgProfiler::ScopedTimer timer(profiler_, "evaluate", id);
     worker->EvalConfiguration(&worker->top_cg_, &worker->top_);
   } else {
+    CsgProfiler::ScopedTimer timer(profiler_, "evaluate", id);
     worker->EvalConfiguration(&worker->top_);
   }
 
@@ -198,6 +233,7 @@ bool CsgApplication::ProcessData(Worker *worker) {
 }
 
 void CsgApplication::Run(void) {
+  profiler_.Start();
   // create reader for atomistic topology
   std::unique_ptr<TopologyReader> reader =
       TopReaderFactory().Create(OptionsMap()["top"].as<std::string>());
@@ -228,7 +264,10 @@ void CsgApplication::Run(void) {
   //////////////////////////////////////////////////
   // read in the topology for master
   //////////////////////////////////////////////////
-  reader->ReadTopology(OptionsMap()["top"].as<std::string>(), master->top_);
+  {
+    CsgProfiler::ScopedTimer timer(profiler_, "topology");
+    reader->ReadTopology(OptionsMap()["top"].as<std::string>(), master->top_);
+  }
   // Ensure that the coarse grained topology will have the same boundaries
   master->top_cg_.setBox(master->top_.getBox());
 
@@ -251,7 +290,10 @@ void CsgApplication::Run(void) {
       }
     }
 
-    master->map_ = cg.CreateCGTopology(master->top_, master->top_cg_);
+    {
+      CsgProfiler::ScopedTimer timer(profiler_, "topology");
+      master->map_ = cg.CreateCGTopology(master->top_, master->top_cg_);
+    }
 
     std::cout << "I have " << master->top_cg_.BeadCount() << " beads in "
               << master->top_cg_.MoleculeCount()
@@ -293,8 +335,12 @@ void CsgApplication::Run(void) {
     first_frame = OptionsMap()["first-frame"].as<Index>();
 
     // create reader for trajectory
-    traj_reader_ =
-        TrjReaderFactory().Create(OptionsMap()["trj"].as<std::string>());
+    std::string trj_format;
+    if (OptionsMap().count("trj-format")) {
+      trj_format = OptionsMap()["trj-format"].as<std::string>();
+    }
+    traj_reader_ = TrjReaderFactory().Create(
+        OptionsMap()["trj"].as<std::string>(), trj_format);
     if (traj_reader_ == nullptr) {
       throw std::runtime_error(std::string("input format not supported: ") +
                                OptionsMap()["trj"].as<std::string>());
@@ -353,11 +399,14 @@ void CsgApplication::Run(void) {
     }
 
     // notify all observers that coarse graining has begun
-    if (do_mapping_) {
-      master->map_->Apply();
-      BeginEvaluate(&master->top_cg_, &master->top_);
-    } else {
-      BeginEvaluate(&master->top_);
+    {
+      CsgProfiler::ScopedTimer timer(profiler_, "begin_evaluate");
+      if (do_mapping_) {
+        master->map_->Apply();
+        BeginEvaluate(&master->top_cg_, &master->top_);
+      } else {
+        BeginEvaluate(&master->top_);
+      }
     }
 
     is_first_frame_ = true;
@@ -391,6 +440,7 @@ void CsgApplication::Run(void) {
         myWorker->WaitDone();
         if (!SynchronizeThreads()) {
           mergeMutex.Lock();
+          CsgProfiler::ScopedTimer timer(profiler_, "merge");
           MergeWorker(myWorker.get());
           mergeMutex.Unlock();
         }
@@ -401,13 +451,23 @@ void CsgApplication::Run(void) {
       master->WaitDone();
     }
 
-    EndEvaluate();
+    {
+      CsgProfiler::ScopedTimer timer(profiler_, "end_evaluate");
+      EndEvaluate();
+    }
 
     myWorkers_.clear();
     threadsMutexesIn_.clear();
     threadsMutexesOut_.clear();
     traj_reader_->Close();
   }
+
+  if (profiler_.isEnabled()) {
+    profiler_.Stop();
+    std::string file = OptionsMap()["profile"].as<std::string>();
+    std::cout << "writing profile to " << file << std::endl;
+    profiler_.WriteReport(file, ProgramName());
+  }
 }
 
 void CsgApplication::BeginEvaluate(Topology *top, Topology *top_ref) {
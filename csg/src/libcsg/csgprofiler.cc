@@ -0,0 +1,235 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+// Third party includes
+#include <boost/algorithm/string/predicate.hpp>
+
+// VOTCA includes
+#include <votca/tools/propertyiomanipulator.h>
+
+// Local VOTCA includes
+#include "votca/csg/csgprofiler.h"
+
+namespace votca {
+namespace csg {
+
+namespace {
+
+double Seconds(std::chrono::steady_clock::time_point start,
+               std::chrono::steady_clock::time_point stop) {
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}  // namespace
+
+CsgProfiler::ScopedTimer::ScopedTimer(CsgProfiler &profiler,
+                                      std::string stage, Index thread)
+    : profiler_(profiler.isEnabled() ? &profiler : nullptr),
+      stage_(std::move(stage)),
+      thread_(thread) {
+  if (profiler_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+CsgProfiler::ScopedTimer::~ScopedTimer() {
+  if (profiler_) {
+    profiler_->AddTime(thread_, stage_,
+                       Seconds(start_, std::chrono::steady_clock::now()));
+  }
+}
+
+void CsgProfiler::Start() { start_ = std::chrono::steady_clock::now(); }
+
+void CsgProfiler::Stop() {
+  wall_time_ = Seconds(start_, std::chrono::steady_clock::now());
+}
+
+void CsgProfiler::AddTime(Index thread, const std::string &stage,
+                          double seconds) {
+  if (!enabled_) {
+    return;
+  }
+  mutex_.Lock();
+  stage_t &entry = threads_[thread][stage];
+  entry.seconds_ += seconds;
+  entry.calls_++;
+  mutex_.Unlock();
+}
+
+void CsgProfiler::AddCount(const std::string &counter, Index count) {
+  if (!enabled_) {
+    return;
+  }
+  mutex_.Lock();
+  counters_[counter] += count;
+  mutex_.Unlock();
+}
+
+double CsgProfiler::getTime(Index thread, const std::string &stage) const {
+  mutex_.Lock();
+  double seconds = 0.0;
+  auto stages = threads_.find(thread);
+  if (stages != threads_.end()) {
+    auto entry = stages->second.find(stage);
+    if (entry != stages->second.end()) {
+      seconds = entry->second.seconds_;
+    }
+  }
+  mutex_.Unlock();
+  return seconds;
+}
+
+Index CsgProfiler::getCalls(Index thread, const std::string &stage) const {
+  mutex_.Lock();
+  Index calls = 0;
+  auto stages = threads_.find(thread);
+  if (stages != threads_.end()) {
+    auto entry = stages->second.find(stage);
+    if (entry != stages->second.end()) {
+      calls = entry->second.calls_;
+    }
+  }
+  mutex_.Unlock();
+  return calls;
+}
+
+Index CsgProfiler::getCount(const std::string &counter) const {
+  mutex_.Lock();
+  auto entry = counters_.find(counter);
+  Index count = (entry == counters_.end()) ? 0 : entry->second;
+  mutex_.Unlock();
+  return count;
+}
+
+double CsgProfiler::getBusyTime(Index thread) const {
+  mutex_.Lock();
+  double seconds = 0.0;
+  auto stages = threads_.find(thread);
+  if (stages != threads_.end()) {
+    for (const auto &entry : stages->second) {
+      if (!isWaiting(entry.first) && !isSubStage(entry.first)) {
+        seconds += entry.second.seconds_;
+      }
+    }
+  }
+  mutex_.Unlock();
+  return seconds;
+}
+
+double CsgProfiler::getIdleTime(Index thread) const {
+  mutex_.Lock();
+  double seconds = 0.0;
+  auto stages = threads_.find(thread);
+  if (stages != threads_.end()) {
+    for (const auto &entry : stages->second) {
+      if (isWaiting(entry.first) && !isSubStage(entry.first)) {
+        seconds += entry.second.seconds_;
+      }
+    }
+  }
+  mutex_.Unlock();
+  return seconds;
+}
+
+tools::Property CsgProfiler::Report(const std::string &program) const {
+  tools::Property root;
+  tools::Property &profile = root.add("profile", "");
+  profile.add("program", program);
+  profile.add("wall_time", std::to_string(wall_time_));
+
+  tools::Property &counters = profile.add("counters", "");
+  for (const auto &counter : counters_) {
+    counters.add("counter", std::to_string(counter.second))
+        .setAttribute("name", counter.first);
+  }
+
+  for (const auto &thread : threads_) {
+    tools::Property &prop = profile.add("thread", "");
+    prop.setAttribute("id", thread.first);
+    prop.add("busy", std::to_string(getBusyTime(thread.first)));
+    prop.add("idle", std::to_string(getIdleTime(thread.first)));
+    for (const auto &stage : thread.second) {
+      tools::Property &s = prop.add("stage", "");
+      s.setAttribute("name", stage.first);
+      s.add("time", std::to_string(stage.second.seconds_));
+      s.add("calls", std::to_string(stage.second.calls_));
+    }
+  }
+  return root;
+}
+
+void CsgProfiler::WriteJSON(std::ostream &out,
+                            const std::string &program) const {
+  out << "{\n";
+  out << "  \"program\": \"" << program << "\",\n";
+  out << "  \"wall_time\": " << wall_time_ << ",\n";
+  out << "  \"counters\": {";
+  std::string sep = "\n";
+  for (const auto &counter : counters_) {
+    out << sep << "    \"" << counter.first << "\": " << counter.second;
+    sep = ",\n";
+  }
+  out << "\n  },\n";
+  out << "  \"threads\": [";
+  sep = "\n";
+  for (const auto &thread : threads_) {
+    out << sep << "    {\n";
+    out << "      \"id\": " << thread.first << ",\n";
+    out << "      \"busy\": " << getBusyTime(thread.first) << ",\n";
+    out << "      \"idle\": " << getIdleTime(thread.first) << ",\n";
+    out << "      \"stages\": {";
+    std::string stage_sep = "\n";
+    for (const auto &stage : thread.second) {
+      out << stage_sep << "        \"" << stage.first
+          << "\": {\"time\": " << stage.second.seconds_
+          << ", \"calls\": " << stage.second.calls_ << "}";
+      stage_sep = ",\n";
+    }
+    out << "\n      }\n    }";
+    sep = ",\n";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void CsgProfiler::WriteXML(std::ostream &out,
+                           const std::string &program) const {
+  tools::PropertyIOManipulator iomXML(tools::PropertyIOManipulator::XML, 0,
+                                      "");
+  out << iomXML << Report(program);
+}
+
+void CsgProfiler::WriteReport(const std::string &filename,
+                              const std::string &program) const {
+  std::ofstream out(filename);
+  if (!out) {
+    throw std::runtime_error("cannot open profile file " + filename);
+  }
+  if (boost::algorithm::ends_with(filename, ".xml")) {
+    WriteXML(out, program);
+  } else {
+    WriteJSON(out, program);
+  }
+}
+
+}  // namespace csg
+}  // namespace votca
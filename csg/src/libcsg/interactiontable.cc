@@ -0,0 +1,220 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+
+// Local VOTCA includes
+#include "votca/csg/interaction.h"
+#include "votca/csg/interactiontable.h"
+#include "votca/csg/topology.h"
+
+namespace votca {
+namespace csg {
+
+namespace {
+
+using RowArray = Eigen::Array<double, 1, Eigen::Dynamic>;
+
+// column by column cross product of two 3xN matrices
+Eigen::Matrix3Xd ColwiseCross(const Eigen::Matrix3Xd &a,
+                              const Eigen::Matrix3Xd &b) {
+  Eigen::Matrix3Xd c(3, a.cols());
+  c.row(0) = a.row(1).cwiseProduct(b.row(2)) - a.row(2).cwiseProduct(b.row(1));
+  c.row(1) = a.row(2).cwiseProduct(b.row(0)) - a.row(0).cwiseProduct(b.row(2));
+  c.row(2) = a.row(0).cwiseProduct(b.row(1)) - a.row(1).cwiseProduct(b.row(0));
+  return c;
+}
+
+RowArray ColwiseDot(const Eigen::Matrix3Xd &a, const Eigen::Matrix3Xd &b) {
+  return a.cwiseProduct(b).colwise().sum().array();
+}
+
+// view on the gradients with respect to bead `bead` of all interactions
+Eigen::Map<Eigen::Matrix3Xd, 0, Eigen::OuterStride<>> GradsOfBead(
+    Eigen::Matrix3Xd &grads, Index arity, Index bead) {
+  return Eigen::Map<Eigen::Matrix3Xd, 0, Eigen::OuterStride<>>(
+      grads.data() + 3 * bead, 3, grads.cols() / arity,
+      Eigen::OuterStride<>(3 * arity));
+}
+
+}  // namespace
+
+void InteractionTable::Add(const Interaction &ic, Index id) {
+  if (arity_ == 0) {
+    arity_ = ic.BeadCount();
+  } else if (arity_ != ic.BeadCount()) {
+    throw std::runtime_error("interaction group " + ic.getGroup() +
+                             " mixes interactions with " +
+                             std::to_string(arity_) + " and " +
+                             std::to_string(ic.BeadCount()) + " beads");
+  }
+  for (Index i = 0; i < arity_; ++i) {
+    beads_.push_back(ic.getBeadId(i));
+  }
+  ids_.push_back(id);
+}
+
+void InteractionTable::Clear() {
+  arity_ = 0;
+  beads_.clear();
+  ids_.clear();
+}
+
+Eigen::Matrix3Xd InteractionTable::Connections(const Topology &top,
+                                               Index from, Index to) const {
+  Eigen::Matrix3Xd r(3, size());
+  for (Index i = 0; i < size(); ++i) {
+    r.col(i) = top.getDist(getBeadId(i, from), getBeadId(i, to));
+  }
+  return r;
+}
+
+void InteractionTable::EvaluateVar(const Topology &top,
+                                   Eigen::VectorXd &values) const {
+  switch (arity_) {
+    case 0:
+      values.resize(0);
+      break;
+    case 2:
+      BondKernel(top, values, nullptr);
+      break;
+    case 3:
+      AngleKernel(top, values, nullptr);
+      break;
+    case 4:
+      DihedralKernel(top, values, nullptr);
+      break;
+    default:
+      throw std::runtime_error("InteractionTable: no kernel for interactions "
+                               "with " +
+                               std::to_string(arity_) + " beads");
+  }
+}
+
+void InteractionTable::EvaluateVarAndGrad(const Topology &top,
+                                          Eigen::VectorXd &values,
+                                          Eigen::Matrix3Xd &grads) const {
+  grads.resize(3, Index(beads_.size()));
+  switch (arity_) {
+    case 0:
+      values.resize(0);
+      break;
+    case 2:
+      BondKernel(top, values, &grads);
+      break;
+    case 3:
+      AngleKernel(top, values, &grads);
+      break;
+    case 4:
+      DihedralKernel(top, values, &grads);
+      break;
+    default:
+      throw std::runtime_error("InteractionTable: no kernel for interactions "
+                               "with " +
+                               std::to_string(arity_) + " beads");
+  }
+}
+
+void InteractionTable::BondKernel(const Topology &top, Eigen::VectorXd &values,
+                                  Eigen::Matrix3Xd *grads) const {
+  Eigen::Matrix3Xd r = Connections(top, 0, 1);
+  RowArray length = r.colwise().norm().array();
+  values = length.matrix().transpose();
+  if (grads) {
+    Eigen::Matrix3Xd unit = (r.array().rowwise() / length).matrix();
+    GradsOfBead(*grads, 2, 0) = -unit;
+    GradsOfBead(*grads, 2, 1) = unit;
+  }
+}
+
+void InteractionTable::AngleKernel(const Topology &top,
+                                   Eigen::VectorXd &values,
+                                   Eigen::Matrix3Xd *grads) const {
+  Eigen::Matrix3Xd v1 = Connections(top, 1, 0);
+  Eigen::Matrix3Xd v2 = Connections(top, 1, 2);
+  RowArray sq1 = v1.colwise().squaredNorm().array();
+  RowArray sq2 = v2.colwise().squaredNorm().array();
+  RowArray dot = ColwiseDot(v1, v2);
+  RowArray norm12 = (sq1 * sq2).sqrt();
+  RowArray cosine = dot / norm12;
+  values = cosine.acos().matrix().transpose();
+  if (grads) {
+    RowArray acos_prime = 1.0 / (1.0 - cosine.square()).sqrt();
+    RowArray a = acos_prime / norm12;
+    Eigen::Matrix3Xd g0 =
+        (v1.array().rowwise() * (acos_prime * cosine / sq1) -
+         v2.array().rowwise() * a)
+            .matrix();
+    Eigen::Matrix3Xd g2 =
+        (v2.array().rowwise() * (acos_prime * cosine / sq2) -
+         v1.array().rowwise() * a)
+            .matrix();
+    GradsOfBead(*grads, 3, 0) = g0;
+    GradsOfBead(*grads, 3, 1) = -(g0 + g2);
+    GradsOfBead(*grads, 3, 2) = g2;
+  }
+}
+
+void InteractionTable::DihedralKernel(const Topology &top,
+                                      Eigen::VectorXd &values,
+                                      Eigen::Matrix3Xd *grads) const {
+  Eigen::Matrix3Xd v1 = Connections(top, 0, 1);
+  Eigen::Matrix3Xd v2 = Connections(top, 1, 2);
+  Eigen::Matrix3Xd v3 = Connections(top, 2, 3);
+  Eigen::Matrix3Xd n1 = ColwiseCross(v1, v2);
+  Eigen::Matrix3Xd n2 = ColwiseCross(v2, v3);
+  RowArray sign = (ColwiseDot(v1, n2) < 0).select(RowArray::Constant(size(), -1.0),
+                                                  RowArray::Constant(size(), 1.0));
+  RowArray norm1 = n1.colwise().norm().array();
+  RowArray norm2 = n2.colwise().norm().array();
+  RowArray dot = ColwiseDot(n1, n2);
+  RowArray cosine = dot / (norm1 * norm2);
+  values = (sign * cosine.acos()).matrix().transpose();
+  if (grads) {
+    RowArray acos_prime = -sign / (1.0 - cosine.square()).sqrt();
+    RowArray a = acos_prime / (norm1 * norm2);
+    RowArray b1 = acos_prime * dot / (norm2 * norm1.cube());
+    RowArray b2 = acos_prime * dot / (norm1 * norm2.cube());
+
+    Eigen::Matrix3Xd v12 = v1 + v2;
+    Eigen::Matrix3Xd v23 = v2 + v3;
+
+    GradsOfBead(*grads, 4, 0) =
+        (ColwiseCross(n2, v2).array().rowwise() * a -
+         ColwiseCross(n1, v2).array().rowwise() * b1)
+            .matrix();
+    GradsOfBead(*grads, 4, 1) =
+        ((ColwiseCross(n1, v3) + ColwiseCross(v12, n2)).array().rowwise() * a -
+         ColwiseCross(v12, n1).array().rowwise() * b1 -
+         ColwiseCross(n2, v3).array().rowwise() * b2)
+            .matrix();
+    GradsOfBead(*grads, 4, 2) =
+        ((ColwiseCross(v23, n1) + ColwiseCross(n2, v1)).array().rowwise() * a -
+         ColwiseCross(n1, v1).array().rowwise() * b1 -
+         ColwiseCross(v23, n2).array().rowwise() * b2)
+            .matrix();
+    GradsOfBead(*grads, 4, 3) =
+        (ColwiseCross(n1, v2).array().rowwise() * a -
+         ColwiseCross(n2, v2).array().rowwise() * b2)
+            .matrix();
+  }
+}
+
+}  // namespace csg
+}  // namespace votca
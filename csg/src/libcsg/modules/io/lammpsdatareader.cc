@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,11 +16,14 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <limits>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -28,9 +31,7 @@
 #include <votca/tools/elements.h>
 #include <votca/tools/floatingpointcomparison.h>
 #include <votca/tools/getline.h>
-
-// Third party includes
-#include <boost/algorithm/string.hpp>
+#include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
 #include "votca/csg/molecule.h"
@@ -57,6 +58,28 @@ std::vector<std::string> TrimCommentsFrom_(std::vector<std::string> fields) {
   return tempFields;
 }
 
+bool IsBlank_(const std::string &line) {
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+// Converts the first values.size() words of a line of the bonds, angles or
+// dihedrals section, words is a buffer reused for all lines
+void ParseIndices_(const std::string &line,
+                   std::vector<std::string_view> &words,
+                   std::vector<Index> &values) {
+  tools::ViewTokenizer(line, " \t\r").ToVector(words);
+  if (words.size() >= values.size()) {
+    try {
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = tools::convertFromStringView<Index>(words[i]);
+      }
+      return;
+    } catch (std::runtime_error &) {
+    }
+  }
+  throw std::runtime_error("Misformatted line in lammps data file:\n" + line);
+}
+
 /*****************************************************************************
  * Public Facing Methods                                                     *
  *****************************************************************************/
@@ -395,12 +418,6 @@ LAMMPSDataReader::lammps_format LAMMPSDataReader::determineDataFileFormat_(
 
 void LAMMPSDataReader::ReadAtoms_(Topology &top) {
 
-  if (data_.count("Masses") == 0) {
-    throw runtime_error(
-        "You are attempting to read in the atom block before the masses, or "
-        "you have failed to include the masses in the data file.");
-  }
-
   string line;
   tools::getline(fl_, line);
   tools::getline(fl_, line);
@@ -416,71 +433,96 @@ void LAMMPSDataReader::ReadAtoms_(Topology &top) {
     chargeRead = true;
   }
 
-  std::map<Index, string> sorted_file;
-  Index startingIndex;
-  Index startingIndexMolecule = 0;
-  std::istringstream issfirst(line);
-  issfirst >> startingIndex;
+  // Every line is parsed once, the atoms are then processed in the order of
+  // their ids
+  struct AtomLine {
+    Index atomId;
+    Index moleculeId;
+    Index atomTypeId;
+    double charge;
+    Eigen::Vector3d pos;
+  };
+  std::vector<AtomLine> atoms;
+  atoms.reserve(numberOf_["atoms"]);
+  std::vector<std::string_view> words;
+  std::size_t ncolumns = 4;
   if (moleculeRead) {
-    issfirst >> startingIndexMolecule;
+    ncolumns++;
   }
-  sorted_file[startingIndex] = line;
-  tools::getline(fl_, line);
-  boost::trim(line);
-
-  Index atomId = 0;
-  Index moleculeId = 0;
-  while (!line.empty()) {
-    std::istringstream iss(line);
-    iss >> atomId;
+  if (chargeRead) {
+    ncolumns++;
+  }
+  Index startingIndexMolecule = std::numeric_limits<Index>::max();
+  while (!IsBlank_(line)) {
+    tools::ViewTokenizer(line, " \t\r").ToVector(words);
+    if (words.size() < ncolumns) {
+      throw runtime_error("Misformatted line in atoms section:\n" + line);
+    }
+    std::size_t col = 0;
+    AtomLine atom;
+    atom.atomId = tools::convertFromStringView<Index>(words[col++]);
+    atom.moleculeId = atom.atomId;
     if (moleculeRead) {
-      iss >> moleculeId;
+      atom.moleculeId = tools::convertFromStringView<Index>(words[col++]);
+      startingIndexMolecule = std::min(startingIndexMolecule, atom.moleculeId);
     }
-    sorted_file[atomId] = line;
-    tools::getline(fl_, line);
-    boost::trim(line);
-    if (atomId < startingIndex) {
-      startingIndex = atomId;
+    atom.atomTypeId = tools::convertFromStringView<Index>(words[col++]);
+    atom.charge = 0;
+    if (chargeRead) {
+      atom.charge = tools::convertFromStringView<double>(words[col++]);
     }
-    if (moleculeId < startingIndexMolecule) {
-      startingIndexMolecule = moleculeId;
+    for (Index k = 0; k < 3; ++k) {
+      atom.pos[k] = tools::convertFromStringView<double>(words[col++]);
+    }
+    atoms.push_back(atom);
+    tools::getline(fl_, line);
+  }
+  if (!moleculeRead) {
+    startingIndexMolecule = 0;
+  }
+  std::sort(atoms.begin(), atoms.end(),
+            [](const AtomLine &a, const AtomLine &b) {
+              return a.atomId < b.atomId;
+            });
+  for (std::size_t i = 1; i < atoms.size(); ++i) {
+    if (atoms[i].atomId != atoms[0].atomId + Index(i)) {
+      throw runtime_error(
+          "The atom ids in the atoms section of the lammps data file are not "
+          "contiguous, atom " +
+          std::to_string(atoms[0].atomId + Index(i)) + " is missing.");
     }
   }
 
-  for (Index atomIndex = startingIndex;
-       static_cast<size_t>(atomIndex - startingIndex) < sorted_file.size();
-       ++atomIndex) {
-
-    Index atomTypeId;
-    double charge = 0;
-    double x, y, z;
-
-    istringstream iss(sorted_file[atomIndex]);
-    iss >> atomId;
-    if (moleculeRead) {
-      iss >> moleculeId;
-    } else {
-      moleculeId = atomId;
+  // Masses and bead type names only depend on the atom type, they are
+  // resolved and registered once per type. They are only needed to build the
+  // topology, trajectories only update the positions.
+  std::vector<double> type_masses;
+  std::vector<bool> type_registered;
+  if (topology_) {
+    if (data_.count("Masses") == 0) {
+      throw runtime_error(
+          "You are attempting to read in the atom block before the masses, or "
+          "you have failed to include the masses in the data file.");
     }
-    iss >> atomTypeId;
-    if (chargeRead) {
-      iss >> charge;
+    const std::vector<std::vector<std::string>> &masses = data_.at("Masses");
+    type_masses.resize(masses.size());
+    type_registered.resize(masses.size(), false);
+    for (std::size_t t = 0; t < masses.size(); ++t) {
+      type_masses[t] = std::stod(masses[t].at(1));
     }
-    iss >> x;
-    iss >> y;
-    iss >> z;
+  }
 
+  for (std::size_t atomIndex = 0; atomIndex < atoms.size(); ++atomIndex) {
+    const AtomLine &atom = atoms[atomIndex];
     // Exclusion list assumes beads start with ids of 0
-    --atomId;
-    --atomTypeId;
-    moleculeId -= startingIndexMolecule;
+    Index atomId = atom.atomId - 1;
+    Index atomTypeId = atom.atomTypeId - 1;
+    Index moleculeId = atom.moleculeId - startingIndexMolecule;
 
-    // We want to start with an index of 0 not 1
-    // atomId;
     Bead *b;
     if (topology_) {
 
-      atomIdToIndex_[atomId] = atomIndex - startingIndex;
+      atomIdToIndex_[atomId] = Index(atomIndex);
       atomIdToMoleculeId_[atomId] = moleculeId;
       Molecule *mol;
       if (!molecules_.count(moleculeId)) {
@@ -490,22 +532,17 @@ void LAMMPSDataReader::ReadAtoms_(Topology &top) {
         mol = molecules_[moleculeId];
       }
 
-      double mass = std::stod(data_["Masses"].at(atomTypeId).at(1));
-
-      if (Index(data_.at("Masses").size()) <= atomTypeId) {
+      if (atomTypeId < 0 || Index(type_masses.size()) <= atomTypeId) {
         std::string err =
             "The atom block contains an atom of type " +
             std::to_string(atomTypeId) +
             " however, the masses are only specified for atoms up to type " +
-            std::to_string(data_.at("Masses").size() - 1);
+            std::to_string(type_masses.size() - 1);
         throw runtime_error(err);
       }
 
       Index residue_index = moleculeId;
-      if (residue_index >= top.ResidueCount()) {
-        while ((residue_index - 1) >= top.ResidueCount()) {
-          top.CreateResidue("DUM");
-        }
+      while (residue_index >= top.ResidueCount()) {
         top.CreateResidue("DUM");
       }
 
@@ -515,23 +552,25 @@ void LAMMPSDataReader::ReadAtoms_(Topology &top) {
             "may be uninitialized");
       }
 
-      string bead_type_name = atomtypes_[atomTypeId];
-      if (!top.BeadTypeExist(bead_type_name)) {
-        top.RegisterBeadType(bead_type_name);
+      const string &bead_type_name = atomtypes_[atomTypeId];
+      if (!type_registered[atomTypeId]) {
+        if (!top.BeadTypeExist(bead_type_name)) {
+          top.RegisterBeadType(bead_type_name);
+        }
+        type_registered[atomTypeId] = true;
       }
 
       b = top.CreateBead(Bead::spherical, bead_type_name, bead_type_name,
-                         residue_index, mass, charge);
+                         residue_index, type_masses[atomTypeId], atom.charge);
 
       mol->AddBead(b, bead_type_name);
       b->setMoleculeId(mol->getId());
 
     } else {
-      b = top.getBead(atomIndex - startingIndex);
+      b = top.getBead(Index(atomIndex));
     }
 
-    Eigen::Vector3d xyz_pos(x, y, z);
-    b->setPos(xyz_pos * tools::conv::ang2nm);
+    b->setPos(atom.pos * tools::conv::ang2nm);
   }
 
   if (top.BeadCount() != numberOf_["atoms"]) {
@@ -549,26 +588,22 @@ void LAMMPSDataReader::ReadBonds_(Topology &top) {
   string line;
   tools::getline(fl_, line);
   tools::getline(fl_, line);
-  boost::trim(line);
 
-  Index bondId;
-  Index bondTypeId;
-  Index atom1Id, atom2Id;
+  // bond id, bond type, atom1 id, atom2 id
+  std::vector<Index> values(4);
+  std::vector<std::string_view> words;
+  if (topology_) {
+    top.ReserveBondedInteractions(numberOf_["bonds"]);
+  }
 
   Index bond_count = 0;
-  while (!line.empty()) {
+  while (!IsBlank_(line)) {
 
     if (topology_) {
-      istringstream iss(line);
-      iss >> bondId;
-      iss >> bondTypeId;
-      iss >> atom1Id;
-      iss >> atom2Id;
-
-      --atom1Id;
-      --atom2Id;
-      --bondTypeId;
-      --bondId;
+      ParseIndices_(line, words, values);
+      Index bondId = values[0] - 1;
+      Index atom1Id = values[2] - 1;
+      Index atom2Id = values[3] - 1;
 
       Index atom1Index = atomIdToIndex_[atom1Id];
       Index atom2Index = atomIdToIndex_[atom2Id];
@@ -595,7 +630,6 @@ void LAMMPSDataReader::ReadBonds_(Topology &top) {
 
     ++bond_count;
     tools::getline(fl_, line);
-    boost::trim(line);
   }
 
   if (bond_count != numberOf_["bonds"]) {
@@ -614,33 +648,25 @@ void LAMMPSDataReader::ReadAngles_(Topology &top) {
   std::string line;
   tools::getline(fl_, line);
   tools::getline(fl_, line);
-  boost::trim(line);
 
-  Index angleId;
-  Index angleTypeId;
-  Index atom1Id, atom2Id, atom3Id;
+  // angle id, angle type, atom1 id, atom2 id, atom3 id
+  std::vector<Index> values(5);
+  std::vector<std::string_view> words;
+  if (topology_) {
+    top.ReserveBondedInteractions(numberOf_["angles"]);
+  }
 
   Index angle_count = 0;
 
-  while (!line.empty()) {
+  while (!IsBlank_(line)) {
 
     if (topology_) {
-      std::istringstream iss(line);
-      iss >> angleId;
-      iss >> angleTypeId;
-      iss >> atom1Id;
-      iss >> atom2Id;
-      iss >> atom3Id;
-
-      --angleId;
-      --atom1Id;
-      --atom2Id;
-      --atom3Id;
-      --angleTypeId;
+      ParseIndices_(line, words, values);
+      Index angleId = values[0] - 1;
 
-      Index atom1Index = atomIdToIndex_[atom1Id];
-      Index atom2Index = atomIdToIndex_[atom2Id];
-      Index atom3Index = atomIdToIndex_[atom3Id];
+      Index atom1Index = atomIdToIndex_[values[2] - 1];
+      Index atom2Index = atomIdToIndex_[values[3] - 1];
+      Index atom3Index = atomIdToIndex_[values[4] - 1];
 
       Interaction *ic = new IAngle(atom1Index, atom2Index, atom3Index);
       ic->setGroup("ANGLES");
@@ -655,7 +681,6 @@ void LAMMPSDataReader::ReadAngles_(Topology &top) {
     ++angle_count;
 
     tools::getline(fl_, line);
-    boost::trim(line);
   }
 
   if (angle_count != numberOf_["angles"]) {
@@ -682,35 +707,25 @@ void LAMMPSDataReader::ReadDihedrals_(Topology &top) {
   string line;
   tools::getline(fl_, line);
   tools::getline(fl_, line);
-  boost::trim(line);
 
-  Index dihedralId;
-  Index dihedralTypeId;
-  Index atom1Id, atom2Id, atom3Id, atom4Id;
+  // dihedral id, dihedral type, atom1 id, atom2 id, atom3 id, atom4 id
+  std::vector<Index> values(6);
+  std::vector<std::string_view> words;
+  if (topology_) {
+    top.ReserveBondedInteractions(numberOf_["dihedrals"]);
+  }
 
   Index dihedral_count = 0;
-  while (!line.empty()) {
+  while (!IsBlank_(line)) {
 
     if (topology_) {
-      istringstream iss(line);
-      iss >> dihedralId;
-      iss >> dihedralTypeId;
-      iss >> atom1Id;
-      iss >> atom2Id;
-      iss >> atom3Id;
-      iss >> atom4Id;
-
-      --dihedralId;
-      --atom1Id;
-      --atom2Id;
-      --atom3Id;
-      --atom4Id;
-      --dihedralTypeId;
+      ParseIndices_(line, words, values);
+      Index dihedralId = values[0] - 1;
 
-      Index atom1Index = atomIdToIndex_[atom1Id];
-      Index atom2Index = atomIdToIndex_[atom2Id];
-      Index atom3Index = atomIdToIndex_[atom3Id];
-      Index atom4Index = atomIdToIndex_[atom4Id];
+      Index atom1Index = atomIdToIndex_[values[2] - 1];
+      Index atom2Index = atomIdToIndex_[values[3] - 1];
+      Index atom3Index = atomIdToIndex_[values[4] - 1];
+      Index atom4Index = atomIdToIndex_[values[5] - 1];
 
       Interaction *ic =
           new IDihedral(atom1Index, atom2Index, atom3Index, atom4Index);
@@ -724,7 +739,6 @@ void LAMMPSDataReader::ReadDihedrals_(Topology &top) {
     }
     ++dihedral_count;
     tools::getline(fl_, line);
-    boost::trim(line);
   }
 
   if (dihedral_count != numberOf_["dihedrals"]) {
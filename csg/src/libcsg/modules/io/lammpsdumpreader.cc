@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,7 +16,9 @@
  */
 
 // Standard includes
+#include <map>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 // Third party includes
@@ -26,6 +28,7 @@
 // VOTCA includes
 #include <votca/tools/constants.h>
 #include <votca/tools/getline.h>
+#include <votca/tools/tokenizer.h>
 
 // Local private VOTCA includes
 #include "lammpsdumpreader.h"
@@ -119,7 +122,7 @@ void LAMMPSDumpReader::ReadBox(Topology &top) {
   for (Index i = 0; i < 3; ++i) {
     tools::getline(fl_, s);
     boost::algorithm::trim(s);
-    vector<double> v = tools::Tokenizer(s, " ").ToVector<double>();
+    vector<double> v = tools::ViewTokenizer(s, " ").ToVector<double>();
     if (v.size() != 2) {
       throw std::ios_base::failure("invalid box format");
     }
@@ -149,31 +152,36 @@ void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
     }
   }
 
+  // column meaning, resolved once instead of comparing names for every atom
+  enum column_t { other, x, y, z, xs, ys, zs, vx, vy, vz, fx, fy, fz, type };
+
   bool pos = false;
   bool force = false;
   bool vel = false;
   Index id = -1;
 
-  vector<string> fields;
-
+  vector<column_t> columns;
   {
+    const std::map<string, column_t> names = {
+        {"x", x},   {"y", y},   {"z", z},   {"xu", x},  {"yu", y},
+        {"zu", z},  {"xs", xs}, {"ys", ys}, {"zs", zs}, {"vx", vx},
+        {"vy", vy}, {"vz", vz}, {"fx", fx}, {"fy", fy}, {"fz", fz},
+        {"type", type}};
     tools::Tokenizer tok(itemline.substr(12), " ");
-    fields = tok.ToVector();
     Index j = 0;
     for (tools::Tokenizer::iterator i = tok.begin(); i != tok.end(); ++i, ++j) {
-      if (*i == "x" || *i == "y" || *i == "z") {
-        pos = true;
-      } else if (*i == "xu" || *i == "yu" || *i == "zu") {
+      auto name = names.find(*i);
+      column_t column = (name == names.end()) ? other : name->second;
+      if (column >= x && column <= zs) {
         pos = true;
-      } else if (*i == "xs" || *i == "ys" || *i == "zs") {
-        pos = true;
-      } else if (*i == "vx" || *i == "vy" || *i == "vz") {
+      } else if (column >= vx && column <= vz) {
         vel = true;
-      } else if (*i == "fx" || *i == "fy" || *i == "fz") {
+      } else if (column >= fx && column <= fz) {
         force = true;
       } else if (*i == "id") {
         id = j;
       }
+      columns.push_back(column);
     }
   }
   if (id < 0) {
@@ -181,10 +189,12 @@ void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
         "error, id not found in any column of the atoms section");
   }
 
+  const double force_conv = tools::conv::kcal2kj / tools::conv::ang2nm;
+  const Eigen::Matrix3d m = top.getBox();
+  string s;
+  vector<std::string_view> words;
   for (Index i = 0; i < natoms_; ++i) {
-    string s;
     tools::getline(fl_, s);
-    boost::algorithm::trim(s);
     if (fl_.eof()) {
       throw std::runtime_error("Error: unexpected end of lammps file '" +
                                fname_ + "' only " +
@@ -192,11 +202,16 @@ void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
                                boost::lexical_cast<string>(natoms_) + " read.");
     }
 
-    tools::Tokenizer tok(s, " ");
-    tools::Tokenizer::iterator itok = tok.begin();
-    vector<string> fields2 = tok.ToVector();
+    tools::ViewTokenizer(s, " \t\r").ToVector(words);
+    if (words.size() > columns.size()) {
+      throw std::runtime_error(
+          "error, wrong number of columns in atoms section");
+    }
+    if (Index(words.size()) <= id) {
+      throw std::runtime_error("error, id not found in atoms section line");
+    }
     // internal numbering begins with 0
-    Index atom_id = boost::lexical_cast<Index>(fields2[id]);
+    Index atom_id = tools::convertFromStringView<Index>(words[id]);
     if (atom_id > natoms_) {
       throw std::runtime_error(
           "Error: found atom with id " + boost::lexical_cast<string>(atom_id) +
@@ -207,47 +222,59 @@ void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
     b->HasPos(pos);
     b->HasF(force);
     b->HasVel(vel);
-    Eigen::Matrix3d m = top.getBox();
 
-    for (size_t j = 0; itok != tok.end(); ++itok, ++j) {
-      if (j == fields.size()) {
-        throw std::runtime_error(
-            "error, wrong number of columns in atoms section");
-      } else if (fields[j] == "x") {
-        b->Pos().x() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "y") {
-        b->Pos().y() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "z") {
-        b->Pos().z() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "xu") {
-        b->Pos().x() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "yu") {
-        b->Pos().y() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "zu") {
-        b->Pos().z() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "xs") {
-        b->Pos().x() = stod(*itok) * m(0, 0);  // box is already in nm
-      } else if (fields[j] == "ys") {
-        b->Pos().y() = stod(*itok) * m(1, 1);  // box is already in nm
-      } else if (fields[j] == "zs") {
-        b->Pos().z() = stod(*itok) * m(2, 2);  // box is already in nm
-      } else if (fields[j] == "vx") {
-        b->Vel().x() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "vy") {
-        b->Vel().y() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "vz") {
-        b->Vel().z() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "fx") {
-        b->F().x() = stod(*itok) * tools::conv::kcal2kj / tools::conv::ang2nm;
-      } else if (fields[j] == "fy") {
-        b->F().y() = stod(*itok) * tools::conv::kcal2kj / tools::conv::ang2nm;
-      } else if (fields[j] == "fz") {
-        b->F().z() = stod(*itok) * tools::conv::kcal2kj / tools::conv::ang2nm;
-      } else if ((fields[j] == "type") && topology_) {
-        if (!top.BeadTypeExist(*itok)) {
-          top.RegisterBeadType(*itok);
-        }
-        b->setType(*itok);
+    for (size_t j = 0; j < words.size(); ++j) {
+      auto value = [&words, j]() {
+        return tools::convertFromStringView<double>(words[j]);
+      };
+      switch (columns[j]) {
+        case x:
+          b->Pos().x() = value() * tools::conv::ang2nm;
+          break;
+        case y:
+          b->Pos().y() = value() * tools::conv::ang2nm;
+          break;
+        case z:
+          b->Pos().z() = value() * tools::conv::ang2nm;
+          break;
+        case xs:  // box is already in nm
+          b->Pos().x() = value() * m(0, 0);
+          break;
+        case ys:
+          b->Pos().y() = value() * m(1, 1);
+          break;
+        case zs:
+          b->Pos().z() = value() * m(2, 2);
+          break;
+        case vx:
+          b->Vel().x() = value() * tools::conv::ang2nm;
+          break;
+        case vy:
+          b->Vel().y() = value() * tools::conv::ang2nm;
+          break;
+        case vz:
+          b->Vel().z() = value() * tools::conv::ang2nm;
+          break;
+        case fx:
+          b->F().x() = value() * force_conv;
+          break;
+        case fy:
+          b->F().y() = value() * force_conv;
+          break;
+        case fz:
+          b->F().z() = value() * force_conv;
+          break;
+        case type:
+          if (topology_) {
+            string bead_type(words[j]);
+            if (!top.BeadTypeExist(bead_type)) {
+              top.RegisterBeadType(bead_type);
+            }
+            b->setType(bead_type);
+          }
+          break;
+        case other:
+          break;
       }
     }
   }
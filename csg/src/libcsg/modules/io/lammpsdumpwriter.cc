@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -53,7 +53,7 @@ void LAMMPSDumpWriter::Write(Topology *conf) {
   fprintf(out_, "\n");
 
   for (const Bead &bead : conf->Beads()) {
-    Index type_id = conf->getBeadTypeId(bead.getType());
+    Index type_id = conf->getBeadTypeId(bead.getInternedType());
 
     fprintf(out_, "%ld %li", bead.getId() + 1, type_id);
     fprintf(out_, " %f %f %f", bead.getPos().x() * conv::nm2ang,
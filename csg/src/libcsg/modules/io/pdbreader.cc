@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,8 +16,9 @@
  */
 
 // Standard includes
-#include <sstream>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 // Third party includes
@@ -27,6 +28,7 @@
 
 // VOTCA includes
 #include <votca/tools/getline.h>
+#include <votca/tools/tokenizer.h>
 
 // Local private VOTCA includes
 #include "pdbreader.h"
@@ -36,6 +38,33 @@ namespace csg {
 using namespace boost;
 using namespace std;
 
+namespace {
+
+// Column of a fixed width pdb line without surrounding blanks, a view into
+// the line to avoid a string per field
+std::string_view Field(std::string_view line, std::size_t start,
+                       std::size_t length) {
+  std::string_view field = line.substr(start, length);
+  std::size_t first = field.find_first_not_of(" \t\r");
+  if (first == std::string_view::npos) {
+    return std::string_view();
+  }
+  std::size_t last = field.find_last_not_of(" \t\r");
+  return field.substr(first, last - first + 1);
+}
+
+// pdb charges are written as e.g. "1-" or "2+"
+double ParseCharge(std::string_view charge) {
+  double sign = 1.0;
+  if (charge.back() == '-' || charge.back() == '+') {
+    sign = (charge.back() == '-') ? -1.0 : 1.0;
+    charge.remove_suffix(1);
+  }
+  return sign * tools::convertFromStringView<double>(charge);
+}
+
+}  // namespace
+
 bool PDBReader::ReadTopology(string file, Topology &top) {
   topology_ = true;
   top.Cleanup();
@@ -89,16 +118,18 @@ bool PDBReader::NextFrame(Topology &top) {
 
   string line;
   tools::Elements elements;
-  // Two column vector for storing all bonds
-  // 1 - id of first atom
-  // 2 - id of second atom
-  vector<vector<Index>> bond_pairs;
+  // Pairs of atom ids for storing all bonds
+  // first  - id of first atom
+  // second - id of second atom
+  vector<pair<Index, Index>> bond_pairs;
   // Store pointers to every bead
   // WARNING we are assuming in the bead_Eigen::Vector3d that the indices of the
   // beads
   //         correspond to the order in which they are read in. As in the first
   //         bead read in will be at index 0, etc...
   vector<Bead *> bead_vec;
+  // atom ids of a CONECT line, reused for all lines
+  vector<Index> conect_ids;
   ////////////////////////////////////////////////////////////////////////////////
   // Read in information from .pdb file
   ////////////////////////////////////////////////////////////////////////////////
@@ -145,46 +176,27 @@ bool PDBReader::NextFrame(Topology &top) {
     }
     // Only read the CONECT keyword if the topology is set too true
     if (topology_ && tools::wildcmp("CONECT*", line)) {
-      vector<string> bonded_atms;
-      string atm1;
-      try {
-        // If the CONECT keyword is found then there must be at least
-        // two atom identifiers, more than that is optional.
-
-        stringstream ss;
-        ss << string(line.substr(6));
-        // 1 -  6       Record name    "CONECT"
-        // 11 -  7       Real(5)        atm1           (ID)
-        ss >> atm1;
-        string temp_atm;
-        ss >> temp_atm;
-        bonded_atms.push_back(temp_atm);
-        ss >> temp_atm;
-        // Here we have taken a less rigorous approach to the .pdb files
-        // we do not care at this point how large the ids of the atoms are
-        // they can be greater than 99,999 with this approach.
-        while (ss) {
-          bonded_atms.push_back(temp_atm);
-          ss >> temp_atm;
-        }
-      } catch (std::out_of_range &) {
+      // 1 -  6       Record name    "CONECT"
+      // 7 - 11       Integer        atm1           (ID)
+      // Here we have taken a less rigorous approach to the .pdb files
+      // we do not care at this point how large the ids of the atoms are
+      // they can be greater than 99,999 with this approach.
+      tools::ViewTokenizer(std::string_view(line).substr(6), " \t\r")
+          .ToVector(conect_ids);
+      // If the CONECT keyword is found then there must be at least
+      // two atom identifiers, more than that is optional.
+      if (conect_ids.size() < 2) {
         throw std::runtime_error("Misformated pdb file in CONECT line\n" +
                                  line);
       }
-
-      vector<Index> row(2);
-      boost::algorithm::trim(atm1);
-      Index at1 = boost::lexical_cast<Index>(atm1);
-      row.at(0) = at1;
-
-      for (auto &bonded_atm : bonded_atms) {
-        Index at2 = boost::lexical_cast<Index>(bonded_atm);
-        row.at(1) = at2;
+      Index at1 = conect_ids[0];
+      for (std::size_t i = 1; i < conect_ids.size(); ++i) {
+        Index at2 = conect_ids[i];
         // Because every bond will be counted twice in a .pdb file
         // we will only add bonds where the id (atm1) is less than the
         // bonded_atm
         if (at1 < at2) {
-          bond_pairs.push_back(row);
+          bond_pairs.emplace_back(at1, at2);
         }
       }
     }
@@ -192,46 +204,24 @@ bool PDBReader::NextFrame(Topology &top) {
     if (tools::wildcmp("ATOM*", line) || tools::wildcmp("HETATM*", line)) {
 
       // according to PDB format
-      string x, y, z, resNum, resName, atName;
-      string charge, elem_sym;
-      // string atNum;
-      try {
-        /* Some pdb don't include all this, read only what we really need*/
-        /* leave this here in case we need more later*/
-
-        // str       ,  "ATOM", "HETATM"
-        // string recType    (line,( 1-1),6);
-        // Index       , Atom serial number
-        // atNum    =    string(line,( 7-1),6);
-        // str       , Atom name
-        atName = string(line, (13 - 1), 4);
-        // char      , Alternate location indicator
-        // string atAltLoc   (line,(17-1),1);
-        // str       , Residue name
-        resName = string(line, (18 - 1), 3);
-        // char      , Chain identifier
-        // string chainID    (line,(22-1),1);
-        // Index       , Residue sequence number
-        resNum = string(line, (23 - 1), 4);
-        // char      , Code for insertion of res
-        // string atICode    (line,(27-1),1);
-        // float 8.3 , x
-        x = string(line, (31 - 1), 8);
-        // float 8.3 , y
-        y = string(line, (39 - 1), 8);
-        // float 8.3 , z
-        z = string(line, (47 - 1), 8);
-        // float 6.2 , Occupancy
-        // string atOccup    (line,(55-1),6);
-        // float 6.2 , Temperature factor
-        // string atTFactor  (line,(61-1),6);
-        // str       , Segment identifier
-        // string segID      (line,(73-1),4);
-        // str       , Element symbol
-        elem_sym = string(line, (77 - 1), 2);
-        // str       , Charge on the atom
-        charge = string(line, (79 - 1), 2);
-      } catch (std::out_of_range &) {
+      // Some pdb don't include all this, read only what we really need
+      // 1 -  6  str        "ATOM", "HETATM"
+      // 7 - 11  Index      Atom serial number
+      // 13 - 16 str        Atom name
+      // 17      char       Alternate location indicator
+      // 18 - 20 str        Residue name
+      // 22      char       Chain identifier
+      // 23 - 26 Index      Residue sequence number
+      // 27      char       Code for insertion of res
+      // 31 - 38 float 8.3  x
+      // 39 - 46 float 8.3  y
+      // 47 - 54 float 8.3  z
+      // 55 - 60 float 6.2  Occupancy
+      // 61 - 66 float 6.2  Temperature factor
+      // 73 - 76 str        Segment identifier
+      // 77 - 78 str        Element symbol
+      // 79 - 80 str        Charge on the atom
+      if (line.size() < 78) {
         string err_msg = "Misformated pdb file in atom line # " +
                          boost::lexical_cast<string>(bead_count) +
                          "\n the correct pdb file format requires 80 "
@@ -245,14 +235,15 @@ bool PDBReader::NextFrame(Topology &top) {
                          "charge (optional)     \n";
         throw std::runtime_error(err_msg);
       }
-      boost::algorithm::trim(atName);
-      boost::algorithm::trim(resName);
-      boost::algorithm::trim(resNum);
-      boost::algorithm::trim(x);
-      boost::algorithm::trim(y);
-      boost::algorithm::trim(z);
-      boost::algorithm::trim(elem_sym);
-      boost::algorithm::trim(charge);
+      std::string_view view(line);
+      string atName(Field(view, (13 - 1), 4));
+      string resName(Field(view, (18 - 1), 3));
+      std::string_view resNum = Field(view, (23 - 1), 4);
+      std::string_view x = Field(view, (31 - 1), 8);
+      std::string_view y = Field(view, (39 - 1), 8);
+      std::string_view z = Field(view, (47 - 1), 8);
+      string elem_sym(Field(view, (77 - 1), 2));
+      std::string_view charge = Field(view, (79 - 1), 2);
 
       bead_count++;
 
@@ -261,10 +252,10 @@ bool PDBReader::NextFrame(Topology &top) {
       if (topology_) {
         Index resnr;
         try {
-          resnr = boost::lexical_cast<Index>(resNum);
-        } catch (bad_lexical_cast &) {
+          resnr = tools::convertFromStringView<Index>(resNum);
+        } catch (std::runtime_error &) {
           throw std::runtime_error(
-              "Cannot convert resNum='" + resNum +
+              "Cannot convert resNum='" + string(resNum) +
               "' to int, that usallly means: misformated pdb file");
         }
 
@@ -300,8 +291,8 @@ bool PDBReader::NextFrame(Topology &top) {
         // Determine if the charge has been provided in the .pdb file or if we
         // will be assuming it is 0
         double ch = 0;
-        if (charge != "") {
-          ch = stod(charge);
+        if (!charge.empty()) {
+          ch = ParseCharge(charge);
         } else {
           cout << "WARNING no charge was specified for " << endl;
           cout << line << endl;
@@ -336,8 +327,10 @@ bool PDBReader::NextFrame(Topology &top) {
         b = top.getBead(bead_count - 1);
       }
       // convert to nm from A
-      b->setPos(
-          Eigen::Vector3d(stod(x) / 10.0, stod(y) / 10.0, stod(z) / 10.0));
+      b->setPos(Eigen::Vector3d(tools::convertFromStringView<double>(x),
+                                tools::convertFromStringView<double>(y),
+                                tools::convertFromStringView<double>(z)) /
+                10.0);
 
       bead_vec.push_back(b);
     }
@@ -376,8 +369,8 @@ bool PDBReader::NextFrame(Topology &top) {
     // Cycle through all bonds
     for (auto &bond_pair : bond_pairs) {
 
-      Index atm_id1 = bond_pair.at(0);
-      Index atm_id2 = bond_pair.at(1);
+      Index atm_id1 = bond_pair.first;
+      Index atm_id2 = bond_pair.second;
       // Check to see if either atm referred to in the bond is already
       // attached to a molecule
       auto mol_iter1 = atm_molecule.find(atm_id1);
@@ -471,31 +464,32 @@ bool PDBReader::NextFrame(Topology &top) {
     // Second Index - is the new index
     map<Index, Index> mol_reInd_map;
 
+    const string residuename = "DUM";
     Index ind = 0;
     for (auto mol = molecule_atms.begin(); mol != molecule_atms.end(); mol++) {
 
-      string mol_name = "PDB Molecule " + boost::lexical_cast<string>(ind);
+      string mol_name = "PDB Molecule " + std::to_string(ind);
 
       Molecule *mi = top.CreateMolecule(mol_name);
       mol_map[mol->first] = mi;
       mol_reInd_map[mol->first] = ind;
 
       // Add all the atoms to the appropriate molecule object
-      list<Index> atm_list = molecule_atms[mol->first];
-      for (Index &atm_temp : atm_list) {
-
-        string residuename = "DUM";
+      const list<Index> &atm_list = mol->second;
+      mi->ReserveBeads(Index(atm_list.size()));
+      for (Index atm_temp : atm_list) {
         mi->AddBead(bead_vec.at(atm_temp - 1), residuename);
       }
       ind++;
     }
 
+    top.ReserveBondedInteractions(Index(bond_pairs.size()));
     Index bond_indx = 0;
     // Cyle through the bonds and add them to the appropriate molecule
     for (auto &bond_pair : bond_pairs) {
 
-      Index atm_id1 = bond_pair.at(0);
-      Index atm_id2 = bond_pair.at(1);
+      Index atm_id1 = bond_pair.first;
+      Index atm_id2 = bond_pair.second;
       // Should be able to just look at one of the atoms the bond is attached
       // too because the other will also be attached to the same molecule.
       Index mol_ind = atm_molecule[atm_id1];
@@ -0,0 +1,644 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+// Third party includes
+#include <boost/algorithm/string/predicate.hpp>
+
+// VOTCA includes
+#include <votca/tools/taskpool.h>
+
+// Local VOTCA includes
+#include "votca/csg/topology.h"
+
+// Local private VOTCA includes
+#include "xdrtrajectoryreader.h"
+
+namespace votca {
+namespace csg {
+
+namespace {
+
+const std::int32_t xtc_magic = 1995;
+const std::int32_t trr_magic = 1993;
+
+// size of the xtc header up to the number of atoms of the coordinate block
+const std::streamoff xtc_header_size = 56;
+// size of precision, minint, maxint and smallidx of compressed xtc frames
+const std::streamoff xtc_compressed_header_size = 32;
+
+/// reads big endian xdr data from a buffer
+class XDRBuffer {
+ public:
+  XDRBuffer(const char *data, std::size_t size) : data_(data), size_(size) {}
+
+  std::uint32_t UInt() {
+    const unsigned char *p =
+        reinterpret_cast<const unsigned char *>(Advance(4));
+    return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+           (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+  }
+
+  std::int32_t Int() { return std::int32_t(UInt()); }
+
+  float Float() {
+    std::uint32_t bits = UInt();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  double Double() {
+    std::uint64_t high = UInt();
+    std::uint64_t bits = (high << 32) | UInt();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  double Real(Index real_size) {
+    return (real_size == 8) ? Double() : double(Float());
+  }
+
+  std::size_t Position() const { return pos_; }
+
+  /// opaque data is padded to a multiple of 4 bytes
+  const unsigned char *Opaque(std::size_t size) {
+    const char *p = Advance((size + 3) / 4 * 4);
+    return reinterpret_cast<const unsigned char *>(p);
+  }
+
+ private:
+  const char *Advance(std::size_t bytes) {
+    if (pos_ + bytes > size_) {
+      throw std::runtime_error("xdr frame is truncated");
+    }
+    const char *p = data_ + pos_;
+    pos_ += bytes;
+    return p;
+  }
+
+  const char *data_;
+  std::size_t size_;
+  std::size_t pos_ = 0;
+};
+
+/// reads the bit stream of compressed xtc coordinates, most significant bit
+/// first
+class BitReader {
+ public:
+  BitReader(const unsigned char *data, std::size_t size)
+      : data_(data), size_(size) {}
+
+  unsigned ReceiveBits(int nbits) {
+    unsigned value = 0;
+    for (int i = 0; i < nbits; ++i) {
+      std::size_t byte = pos_ >> 3;
+      if (byte >= size_) {
+        throw std::runtime_error("xtc coordinate data is truncated");
+      }
+      unsigned bit = (data_[byte] >> (7 - (pos_ & 7))) & 1U;
+      value = (value << 1) | bit;
+      ++pos_;
+    }
+    return value;
+  }
+
+  /// decode num_of_ints integers, which were packed as one large number in
+  /// mixed radix sizes
+  void ReceiveInts(int nbits, const std::array<unsigned, 3> &sizes,
+                   std::array<int, 3> &nums) {
+    std::array<unsigned, 32> bytes{};
+    int nbytes = 0;
+    while (nbits > 8) {
+      bytes[nbytes++] = ReceiveBits(8);
+      nbits -= 8;
+    }
+    if (nbits > 0) {
+      bytes[nbytes++] = ReceiveBits(nbits);
+    }
+    for (int i = 2; i > 0; --i) {
+      unsigned num = 0;
+      for (int j = nbytes - 1; j >= 0; --j) {
+        num = (num << 8) | bytes[j];
+        unsigned p = num / sizes[i];
+        bytes[j] = p;
+        num = num - p * sizes[i];
+      }
+      nums[i] = int(num);
+    }
+    nums[0] = int(bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+                  (bytes[3] << 24));
+  }
+
+ private:
+  const unsigned char *data_;
+  std::size_t size_;
+  std::size_t pos_ = 0;
+};
+
+// table of the ranges of the small differences, index is number of bits
+const std::array<int, 73> magicints = {
+    0,        0,        0,       0,       0,       0,        0,
+    0,        0,        8,       10,      12,      16,       20,
+    25,       32,       40,      50,      64,      80,       101,
+    128,      161,      203,     256,     322,     406,      512,
+    645,      812,      1024,    1290,    1625,    2048,     2580,
+    3250,     4096,     5060,    6501,    8192,    10321,    13003,
+    16384,    20642,    26007,   32768,   41285,   52015,    65536,
+    82570,    104031,   131072,  165140,  208063,  262144,   330280,
+    416127,   524287,   660561,  832255,  1048576, 1321122,  1664510,
+    2097152,  2642245,  3329021, 4194304, 5284491, 6658042,  8388607,
+    10568983, 13316085, 16777216};
+
+const int firstidx = 9;
+
+int SizeOfInt(unsigned size) {
+  std::uint64_t num = 1;
+  int nbits = 0;
+  while (size >= num && nbits < 32) {
+    nbits++;
+    num <<= 1;
+  }
+  return nbits;
+}
+
+// number of bits needed to store the product of the sizes
+int SizeOfInts(const std::array<unsigned, 3> &sizes) {
+  std::array<unsigned, 32> bytes{};
+  bytes[0] = 1;
+  int nbytes = 1;
+  for (unsigned size : sizes) {
+    unsigned tmp = 0;
+    int bytecnt;
+    for (bytecnt = 0; bytecnt < nbytes; bytecnt++) {
+      tmp = bytes[bytecnt] * size + tmp;
+      bytes[bytecnt] = tmp & 0xff;
+      tmp >>= 8;
+    }
+    while (tmp != 0) {
+      bytes[bytecnt++] = tmp & 0xff;
+      tmp >>= 8;
+    }
+    nbytes = bytecnt;
+  }
+  unsigned num = 1;
+  int nbits = 0;
+  nbytes--;
+  while (bytes[nbytes] >= num) {
+    nbits++;
+    num *= 2;
+  }
+  return nbits + nbytes * 8;
+}
+
+void DecompressCoordinates(XDRBuffer &xdr, Index natoms,
+                           std::vector<double> &x) {
+  const float precision = xdr.Float();
+  std::array<int, 3> minint;
+  std::array<int, 3> maxint;
+  for (int &m : minint) {
+    m = xdr.Int();
+  }
+  for (int &m : maxint) {
+    m = xdr.Int();
+  }
+  std::array<unsigned, 3> sizeint;
+  std::array<int, 3> bitsizeint = {0, 0, 0};
+  for (Index d = 0; d < 3; ++d) {
+    sizeint[d] = unsigned(maxint[d] - minint[d]) + 1;
+  }
+  int bitsize = 0;
+  if ((sizeint[0] | sizeint[1] | sizeint[2]) > 0xffffff) {
+    // large systems store each coordinate separately
+    for (Index d = 0; d < 3; ++d) {
+      bitsizeint[d] = SizeOfInt(sizeint[d]);
+    }
+  } else {
+    bitsize = SizeOfInts(sizeint);
+  }
+
+  int smallidx = xdr.Int();
+  if (smallidx < 0 || smallidx >= int(magicints.size())) {
+    throw std::runtime_error("xtc frame has invalid compression parameters");
+  }
+  int smaller = magicints[std::max(firstidx, smallidx - 1)] / 2;
+  int smallnum = magicints[smallidx] / 2;
+  std::array<unsigned, 3> sizesmall;
+  sizesmall.fill(unsigned(magicints[smallidx]));
+
+  const std::size_t nbytes = xdr.UInt();
+  BitReader bits(xdr.Opaque(nbytes), nbytes);
+
+  const float inv_precision = 1.0f / precision;
+  x.resize(3 * natoms);
+  Index i = 0;
+  Index out = 0;
+  std::array<int, 3> thiscoord;
+  std::array<int, 3> prevcoord;
+  int run = 0;
+  auto store = [&](const std::array<int, 3> &coord) {
+    if (out + 3 > Index(x.size())) {
+      throw std::runtime_error("xtc frame contains too many atoms");
+    }
+    for (Index d = 0; d < 3; ++d) {
+      x[out++] = double(float(coord[d]) * inv_precision);
+    }
+  };
+
+  while (i < natoms) {
+    if (bitsize == 0) {
+      for (Index d = 0; d < 3; ++d) {
+        thiscoord[d] = int(bits.ReceiveBits(bitsizeint[d]));
+      }
+    } else {
+      bits.ReceiveInts(bitsize, sizeint, thiscoord);
+    }
+    i++;
+    for (Index d = 0; d < 3; ++d) {
+      thiscoord[d] += minint[d];
+    }
+    prevcoord = thiscoord;
+
+    int is_smaller = 0;
+    if (bits.ReceiveBits(1) == 1) {
+      run = int(bits.ReceiveBits(5));
+      is_smaller = run % 3;
+      run -= is_smaller;
+      is_smaller--;
+    }
+    if (run > 0) {
+      for (int k = 0; k < run; k += 3) {
+        bits.ReceiveInts(smallidx, sizesmall, thiscoord);
+        i++;
+        for (Index d = 0; d < 3; ++d) {
+          thiscoord[d] += prevcoord[d] - smallnum;
+        }
+        if (k == 0) {
+          // the first two atoms of a run are swapped, which compresses water
+          // better
+          std::swap(thiscoord, prevcoord);
+          store(prevcoord);
+        } else {
+          prevcoord = thiscoord;
+        }
+        store(thiscoord);
+      }
+    } else {
+      store(thiscoord);
+    }
+
+    smallidx += is_smaller;
+    if (smallidx < firstidx || smallidx >= int(magicints.size())) {
+      throw std::runtime_error("xtc frame has invalid compression parameters");
+    }
+    if (is_smaller < 0) {
+      smallnum = smaller;
+      smaller = (smallidx > firstidx) ? magicints[smallidx - 1] / 2 : 0;
+    } else if (is_smaller > 0) {
+      smaller = smallnum;
+      smallnum = magicints[smallidx] / 2;
+    }
+    sizesmall.fill(unsigned(magicints[smallidx]));
+  }
+  if (out != Index(x.size())) {
+    throw std::runtime_error("xtc frame contains too few atoms");
+  }
+}
+
+struct trr_header_t {
+  Index box_size = 0;
+  Index vir_size = 0;
+  Index pres_size = 0;
+  Index x_size = 0;
+  Index v_size = 0;
+  Index f_size = 0;
+  Index natoms = 0;
+  Index step = 0;
+  Index real_size = 4;
+  double time = 0.0;
+};
+
+trr_header_t ReadTRRHeader(XDRBuffer &xdr) {
+  if (xdr.Int() != trr_magic) {
+    throw std::runtime_error("not a trr frame");
+  }
+  // version string "GMX_trn_file", stored with its length with and without
+  // the terminating zero
+  std::uint32_t slen = xdr.UInt();
+  std::uint32_t len = xdr.UInt();
+  if (len == slen) {
+    len = xdr.UInt();
+  }
+  xdr.Opaque(len);
+
+  trr_header_t h;
+  std::int32_t ir_size = xdr.Int();
+  std::int32_t e_size = xdr.Int();
+  h.box_size = xdr.Int();
+  h.vir_size = xdr.Int();
+  h.pres_size = xdr.Int();
+  std::int32_t top_size = xdr.Int();
+  std::int32_t sym_size = xdr.Int();
+  h.x_size = xdr.Int();
+  h.v_size = xdr.Int();
+  h.f_size = xdr.Int();
+  h.natoms = xdr.Int();
+  h.step = xdr.Int();
+  xdr.Int();  // nre
+  if (ir_size != 0 || e_size != 0 || top_size != 0 || sym_size != 0) {
+    throw std::runtime_error("trr frames with ir, energy or topology data "
+                             "are not supported");
+  }
+  if (h.box_size) {
+    h.real_size = h.box_size / 9;
+  } else if (h.x_size && h.natoms) {
+    h.real_size = h.x_size / (3 * h.natoms);
+  } else if (h.v_size && h.natoms) {
+    h.real_size = h.v_size / (3 * h.natoms);
+  } else if (h.f_size && h.natoms) {
+    h.real_size = h.f_size / (3 * h.natoms);
+  }
+  if (h.real_size != 4 && h.real_size != 8) {
+    throw std::runtime_error("trr frame has unknown precision");
+  }
+  h.time = xdr.Real(h.real_size);
+  xdr.Real(h.real_size);  // lambda
+  return h;
+}
+
+void ReadTRRVectors(XDRBuffer &xdr, Index natoms, Index real_size,
+                    std::vector<double> &data) {
+  data.resize(3 * natoms);
+  for (double &value : data) {
+    value = xdr.Real(real_size);
+  }
+}
+
+Eigen::Matrix3d ReadBox(XDRBuffer &xdr, Index real_size) {
+  // the rows of the xdr box are the box vectors, votca stores them as columns
+  Eigen::Matrix3d box;
+  for (Index j = 0; j < 3; ++j) {
+    for (Index i = 0; i < 3; ++i) {
+      box(i, j) = xdr.Real(real_size);
+    }
+  }
+  return box;
+}
+
+}  // namespace
+
+XDRTrajectoryReader::~XDRTrajectoryReader() { WaitPending(); }
+
+bool XDRTrajectoryReader::Open(const std::string &file) {
+  filename_ = file;
+  if (boost::algorithm::iends_with(file, ".trr")) {
+    format_ = trr;
+  } else if (boost::algorithm::iends_with(file, ".xtc")) {
+    format_ = xtc;
+  } else {
+    throw std::runtime_error("unknown xdr trajectory format: " + file);
+  }
+  file_.open(file, std::ios::binary);
+  if (!file_) {
+    throw std::runtime_error(std::string("cannot open ") + file);
+  }
+  BuildIndex();
+  if (prefetch_ <= 0) {
+    prefetch_ = tools::TaskPool::Global().ThreadCount();
+  }
+  return true;
+}
+
+void XDRTrajectoryReader::Close() {
+  WaitPending();
+  if (file_.is_open()) {
+    file_.close();
+  }
+  index_.clear();
+}
+
+void XDRTrajectoryReader::WaitPending() {
+  for (auto &frame : pending_) {
+    frame.wait();
+  }
+  pending_.clear();
+}
+
+void XDRTrajectoryReader::BuildIndex() {
+  index_.clear();
+  file_.seekg(0, std::ios::end);
+  const std::streamoff filesize = file_.tellg();
+  std::streamoff offset = 0;
+
+  // reads size bytes at pos, returns false at the end of the file
+  std::vector<char> buffer;
+  auto read = [&](std::streamoff pos, std::streamoff size) {
+    if (pos + size > filesize) {
+      return false;
+    }
+    buffer.resize(std::size_t(size));
+    file_.seekg(pos);
+    file_.read(buffer.data(), size);
+    return bool(file_);
+  };
+
+  while (offset < filesize) {
+    std::streamoff size;
+    if (format_ == xtc) {
+      if (!read(offset, xtc_header_size + 4)) {
+        break;
+      }
+      XDRBuffer xdr(buffer.data(), buffer.size());
+      if (xdr.Int() != xtc_magic) {
+        throw std::runtime_error("corrupt xtc file " + filename_);
+      }
+      const Index natoms = xdr.Int();
+      if (natoms <= 9) {
+        size = xtc_header_size + 12 * natoms;
+      } else {
+        const std::streamoff count_pos =
+            offset + xtc_header_size + xtc_compressed_header_size;
+        if (!read(count_pos, 4)) {
+          break;
+        }
+        XDRBuffer count(buffer.data(), buffer.size());
+        const std::streamoff nbytes = count.UInt();
+        size = xtc_header_size + xtc_compressed_header_size + 4 +
+               (nbytes + 3) / 4 * 4;
+      }
+    } else {
+      // the header is at most 28 + 13 * 4 + 2 * 8 bytes long
+      std::streamoff header = std::min<std::streamoff>(100, filesize - offset);
+      if (!read(offset, header)) {
+        break;
+      }
+      XDRBuffer xdr(buffer.data(), buffer.size());
+      trr_header_t h = ReadTRRHeader(xdr);
+      size = std::streamoff(xdr.Position()) + h.box_size + h.vir_size +
+             h.pres_size + h.x_size + h.v_size + h.f_size;
+    }
+    if (offset + size > filesize) {
+      // incomplete last frame, e.g. from a crashed run
+      break;
+    }
+    index_.push_back({offset, size});
+    offset += size;
+  }
+  file_.clear();
+  next_frame_ = 0;
+  next_decode_ = 0;
+}
+
+std::vector<char> XDRTrajectoryReader::ReadRaw(Index frame) {
+  const entry_t &entry = index_[frame];
+  std::vector<char> raw(std::size_t(entry.size_));
+  file_.seekg(entry.offset_);
+  file_.read(raw.data(), entry.size_);
+  if (!file_) {
+    throw std::runtime_error("error reading frame from " + filename_);
+  }
+  return raw;
+}
+
+void XDRTrajectoryReader::Prefetch() {
+  while (Index(pending_.size()) < prefetch_ && next_decode_ < FrameCount()) {
+    std::vector<char> raw = ReadRaw(next_decode_++);
+    if (format_ == xtc) {
+      pending_.push_back(tools::TaskPool::Global().Submit(
+          [raw = std::move(raw)]() { return DecodeXTC(raw); }));
+    } else {
+      pending_.push_back(tools::TaskPool::Global().Submit(
+          [raw = std::move(raw)]() { return DecodeTRR(raw); }));
+    }
+  }
+}
+
+bool XDRTrajectoryReader::FirstFrame(Topology &conf) {
+  WaitPending();
+  next_frame_ = 0;
+  next_decode_ = 0;
+  if (!NextFrame(conf)) {
+    throw std::runtime_error(std::string("cannot read first frame of ") +
+                             filename_);
+  }
+  return true;
+}
+
+bool XDRTrajectoryReader::NextFrame(Topology &conf) {
+  Prefetch();
+  if (pending_.empty()) {
+    return false;
+  }
+  frame_t frame = pending_.front().get();
+  pending_.pop_front();
+  next_frame_++;
+  SetFrame(frame, conf);
+  Prefetch();
+  return true;
+}
+
+void XDRTrajectoryReader::SetFrame(const frame_t &frame,
+                                   Topology &conf) const {
+  if (frame.natoms_ != conf.BeadCount()) {
+    throw std::runtime_error(
+        "number of beads in trajectory do not match topology");
+  }
+  conf.setTime(frame.time_);
+  conf.setStep(frame.step_);
+  if (frame.has_box_) {
+    conf.setBox(frame.box_);
+  }
+  for (Index i = 0; i < frame.natoms_; i++) {
+    Bead *bead = conf.getBead(i);
+    if (!frame.x_.empty()) {
+      bead->setPos(Eigen::Map<const Eigen::Vector3d>(&frame.x_[3 * i]));
+    }
+    if (!frame.v_.empty()) {
+      bead->setVel(Eigen::Map<const Eigen::Vector3d>(&frame.v_[3 * i]));
+    }
+    if (!frame.f_.empty()) {
+      bead->setF(Eigen::Map<const Eigen::Vector3d>(&frame.f_[3 * i]));
+    }
+  }
+}
+
+XDRTrajectoryReader::frame_t XDRTrajectoryReader::DecodeXTC(
+    const std::vector<char> &raw) {
+  XDRBuffer xdr(raw.data(), raw.size());
+  if (xdr.Int() != xtc_magic) {
+    throw std::runtime_error("not a xtc frame");
+  }
+  frame_t frame;
+  frame.natoms_ = xdr.Int();
+  frame.step_ = xdr.Int();
+  frame.time_ = xdr.Float();
+  frame.box_ = ReadBox(xdr, 4);
+  frame.has_box_ = true;
+  if (xdr.Int() != frame.natoms_) {
+    throw std::runtime_error("xtc frame has inconsistent number of atoms");
+  }
+  if (frame.natoms_ <= 9) {
+    // small systems are stored uncompressed
+    frame.x_.resize(3 * frame.natoms_);
+    for (double &value : frame.x_) {
+      value = xdr.Float();
+    }
+  } else {
+    DecompressCoordinates(xdr, frame.natoms_, frame.x_);
+  }
+  return frame;
+}
+
+XDRTrajectoryReader::frame_t XDRTrajectoryReader::DecodeTRR(
+    const std::vector<char> &raw) {
+  XDRBuffer xdr(raw.data(), raw.size());
+  trr_header_t h = ReadTRRHeader(xdr);
+  frame_t frame;
+  frame.natoms_ = h.natoms;
+  frame.step_ = h.step;
+  frame.time_ = h.time;
+  if (h.box_size) {
+    frame.box_ = ReadBox(xdr, h.real_size);
+    frame.has_box_ = true;
+  }
+  if (h.vir_size) {
+    ReadBox(xdr, h.real_size);
+  }
+  if (h.pres_size) {
+    ReadBox(xdr, h.real_size);
+  }
+  if (h.x_size) {
+    ReadTRRVectors(xdr, h.natoms, h.real_size, frame.x_);
+  }
+  if (h.v_size) {
+    ReadTRRVectors(xdr, h.natoms, h.real_size, frame.v_);
+  }
+  if (h.f_size) {
+    ReadTRRVectors(xdr, h.natoms, h.real_size, frame.f_);
+  }
+  return frame;
+}
+
+}  // namespace csg
+}  // namespace votca
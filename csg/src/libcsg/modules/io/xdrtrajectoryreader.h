@@ -0,0 +1,122 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_XDRTRAJECTORYREADER_PRIVATE_H
+#define VOTCA_CSG_XDRTRAJECTORYREADER_PRIVATE_H
+
+// Standard includes
+#include <deque>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/unitconverter.h>
+
+// Local VOTCA includes
+#include "votca/csg/trajectoryreader.h"
+
+namespace votca {
+namespace csg {
+
+/**
+    \brief class for reading gromacs xtc and trr files without gromacs
+
+    On Open the file is scanned once to build an index of the frame offsets.
+    Frames are then decoded by the global task pool ahead of the consumer, so
+    the decompression of xtc frames runs concurrently to the analysis.
+*/
+class XDRTrajectoryReader : public TrajectoryReader {
+ public:
+  XDRTrajectoryReader() = default;
+  ~XDRTrajectoryReader() override;
+
+  const tools::DistanceUnit distance_unit = tools::DistanceUnit::nanometers;
+  const tools::MassUnit mass_unit = tools::MassUnit::atomic_mass_units;
+  const tools::TimeUnit time_unit = tools::TimeUnit::picoseconds;
+  const tools::ChargeUnit charge_unit = tools::ChargeUnit::e;
+  const tools::MolarEnergyUnit energy_unit =
+      tools::MolarEnergyUnit::kilojoules_per_mole;
+  const tools::VelocityUnit velocity_unit =
+      tools::VelocityUnit::nanometers_per_picosecond;
+  const tools::MolarForceUnit force_unit =
+      tools::MolarForceUnit::kilojoules_per_mole_nanometer;
+
+  /// open a trejectory file and index its frames
+  bool Open(const std::string &file) override;
+  /// read in the first frame
+  bool FirstFrame(Topology &conf) override;
+  /// read in the next frame
+  bool NextFrame(Topology &conf) override;
+
+  void Close() override;
+
+  /// number of frames in the file
+  Index FrameCount() const { return Index(index_.size()); }
+
+  /// number of frames decoded ahead of the current one, default is the
+  /// number of threads of the global task pool
+  void setPrefetch(Index prefetch) { prefetch_ = prefetch; }
+
+  struct frame_t {
+    Index natoms_ = 0;
+    Index step_ = 0;
+    double time_ = 0.0;
+    bool has_box_ = false;
+    Eigen::Matrix3d box_ = Eigen::Matrix3d::Zero();
+    // coordinates, velocities and forces, 3 entries per atom
+    std::vector<double> x_;
+    std::vector<double> v_;
+    std::vector<double> f_;
+  };
+
+  /// decode a xtc frame from its raw bytes
+  static frame_t DecodeXTC(const std::vector<char> &raw);
+  /// decode a trr frame from its raw bytes
+  static frame_t DecodeTRR(const std::vector<char> &raw);
+
+ private:
+  enum Format { xtc, trr };
+
+  struct entry_t {
+    std::streamoff offset_;
+    std::streamoff size_;
+  };
+
+  void BuildIndex();
+  std::vector<char> ReadRaw(Index frame);
+  /// start decoding frames until prefetch_ frames are in flight
+  void Prefetch();
+  void SetFrame(const frame_t &frame, Topology &conf) const;
+  void WaitPending();
+
+  std::string filename_;
+  std::ifstream file_;
+  Format format_ = xtc;
+  std::vector<entry_t> index_;
+  Index prefetch_ = 0;
+  // next frame to hand out and next frame to start decoding
+  Index next_frame_ = 0;
+  Index next_decode_ = 0;
+  std::deque<std::future<frame_t>> pending_;
+};
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_XDRTRAJECTORYREADER_PRIVATE_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -67,7 +67,6 @@ void XMLTopologyReader::ParseRoot(tools::Property &property) {
       top_->setParticleGroup(it.getAttribute<string>("name"));
     } else if (it.name() == "molecules") {
       mol_index_ = 1;
-      bead_index_ = 0;
       ParseMolecules(it);
     } else if (it.name() == "bonded") {
       ParseBonded(it);
@@ -136,7 +135,9 @@ void XMLTopologyReader::ParseMolecules(tools::Property &p) {
 
 void XMLTopologyReader::ParseMolecule(tools::Property &p, string molname,
                                       Index nmols) {
-  vector<XMLBead *> xmlBeads;
+  XMLMolecule *xmlMolecule = new XMLMolecule(molname, nmols);
+  molecules_.insert(make_pair(molname, xmlMolecule));
+  vector<XMLBead> xmlBeads;
   vector<Index> xmlResidues;
   for (auto &it : p) {
     if (it.name() == "bead") {
@@ -176,19 +177,18 @@ void XMLTopologyReader::ParseMolecule(tools::Property &p, string molname,
               "be declared for all beads or for none");
         }
       }
+      if (!xmlMolecule->name2beads.emplace(atname, Index(xmlBeads.size()))
+               .second) {
+        throw std::runtime_error("Atom " + atname + " in molecule " + molname +
+                                 " already exists.");
+      }
       xmlResidues.push_back(resid);
-      XMLBead *xmlBead = new XMLBead(atname, attype, atmass, atq);
-      xmlBeads.push_back(xmlBead);
+      xmlBeads.emplace_back(atname, attype, atmass, atq);
     } else {
       throw std::runtime_error(
           "Wrong element under topology.molecules.molecule: " + it.name());
     }
   }
-  if (xmlResidues.size() != xmlBeads.size()) {
-    throw std::runtime_error(
-        "Number of elements in bead-vector and residue-vector are not "
-        "identical");
-  }
   // Create molecule in topology. Replicate data.
   Index resnr = top_->ResidueCount();
   if (!xmlResidues.empty()) {
@@ -198,51 +198,41 @@ void XMLTopologyReader::ParseMolecule(tools::Property &p, string molname,
           "greater than the number of residues already in the topology");
     }
   }
+
+  // types and names are the same in every copy, resolve them only once
+  vector<string> bnames;
+  bnames.reserve(xmlBeads.size());
+  for (const XMLBead &b : xmlBeads) {
+    if (!top_->BeadTypeExist(b.type)) {
+      top_->RegisterBeadType(b.type);
+    }
+    bnames.push_back(std::to_string(mol_index_) + ":" + molname + ":" +
+                     b.name);
+  }
+
+  xmlMolecule->first_bead.reserve(nmols);
+  xmlMolecule->instances.reserve(nmols);
   for (Index mn = 0; mn < nmols; mn++) {
     Molecule *mi = top_->CreateMolecule(molname);
-    XMLMolecule *xmlMolecule = new XMLMolecule(molname, nmols);
-    xmlMolecule->pid = mi->getId();
-    xmlMolecule->mi = mi;
-    molecules_.insert(make_pair(molname, xmlMolecule));
-    vector<Index>::iterator resit = xmlResidues.begin();
-    for (vector<XMLBead *>::iterator itb = xmlBeads.begin();
-         itb != xmlBeads.end(); ++itb, ++resit) {
-      stringstream bname;
-      XMLBead &b = **itb;
-      if (*resit != -1) {
-        if (top_->ResidueCount() < *resit) {
-          resnr = *resit - 1;
+    mi->ReserveBeads(Index(xmlBeads.size()));
+    xmlMolecule->first_bead.push_back(top_->BeadCount());
+    xmlMolecule->instances.push_back(mi);
+    for (std::size_t i = 0; i < xmlBeads.size(); ++i) {
+      const XMLBead &b = xmlBeads[i];
+      if (xmlResidues[i] != -1) {
+        if (top_->ResidueCount() < xmlResidues[i]) {
+          resnr = xmlResidues[i] - 1;
           top_->CreateResidue(molname, resnr);
         }
       } else {
         top_->CreateResidue(molname, resnr);
       }
-
-      if (!top_->BeadTypeExist(b.type)) {
-        top_->RegisterBeadType(b.type);
-      }
       Bead *bead =
           top_->CreateBead(Bead::spherical, b.name, b.type, resnr, b.mass, b.q);
-      bname << mol_index_ << ":" << molname << ":" << b.name;
-      mi->AddBead(bead, bname.str());
-
-      // Data for bonded terms.
-      XMLBead *b_rep = new XMLBead(b);
-      b_rep->pid = bead_index_;
-      if (xmlMolecule->name2beads.count(b.name) != 0) {
-        throw std::runtime_error("Atom " + b.name + " in molecule " + molname +
-                                 " already exists.");
-      }
-      xmlMolecule->name2beads.insert(make_pair(b.name, b_rep));
-      bead_index_++;
+      mi->AddBead(bead, bnames[i]);
     }
     resnr++;
   }
-
-  // clean up
-  for (auto &xmlBead : xmlBeads) {
-    delete xmlBead;
-  }
 }
 
 void XMLTopologyReader::ParseBeadTypes(tools::Property &el) {
@@ -279,119 +269,83 @@ void XMLTopologyReader::ParseBonded(tools::Property &el) {
 }
 
 void XMLTopologyReader::ParseBond(tools::Property &p) {
-  string name = p.get("name").as<string>();
-  string beads = p.get("beads").as<string>();
-  vector<string> bead_list = tools::Tokenizer(beads, " \n\t").ToVector();
-  if (bead_list.size() % 2 == 1) {
-    throw runtime_error("Wrong number of beads in bond: " + name);
-  }
-  Interaction *ic = nullptr;
-  typedef pair<MoleculesMap::iterator, MoleculesMap::iterator> MRange;
-  Index b_index = 0;
-  for (vector<string>::iterator it = bead_list.begin();
-       it != bead_list.end();) {
-    BondBead b1(*(it++));
-    BondBead b2(*(it++));
-    if (b1.molname == b2.molname) {
-      // Iterates over molecules and gets atom pids.
-      MRange mRange = molecules_.equal_range(b1.molname);
-      for (MoleculesMap::iterator itm = mRange.first; itm != mRange.second;
-           ++itm) {
-        XMLMolecule &xmlMolecule = *itm->second;
-        XMLBead &xmlBead1 = *xmlMolecule.name2beads[b1.atname];
-        XMLBead &xmlBead2 = *xmlMolecule.name2beads[b2.atname];
-        ic = new IBond(xmlBead1.pid, xmlBead2.pid);
-        ic->setGroup(name);
-        ic->setIndex(b_index);
-        ic->setMolecule(xmlMolecule.pid);
-        xmlMolecule.mi->AddInteraction(ic);
-        top_->AddBondedInteraction(ic);
-        b_index++;
-      }
-    } else {
-      throw std::runtime_error(
-          "Beads from different molecules, not supported!");
-    }
-  }
+  ParseInteractions(p, 2, "bond", [](const vector<Index> &ids) {
+    return new IBond(ids[0], ids[1]);
+  });
 }
 
 void XMLTopologyReader::ParseAngle(tools::Property &p) {
+  ParseInteractions(p, 3, "angle", [](const vector<Index> &ids) {
+    return new IAngle(ids[0], ids[1], ids[2]);
+  });
+}
+
+void XMLTopologyReader::ParseDihedral(tools::Property &p) {
+  ParseInteractions(p, 4, "dihedral", [](const vector<Index> &ids) {
+    return new IDihedral(ids[0], ids[1], ids[2], ids[3]);
+  });
+}
+
+void XMLTopologyReader::ParseInteractions(
+    tools::Property &p, Index nbeads, const string &kind,
+    const std::function<Interaction *(const vector<Index> &)> &create) {
   string name = p.get("name").as<string>();
   string beads = p.get("beads").as<string>();
   vector<string> bead_list = tools::Tokenizer(beads, " \n\t").ToVector();
-  if (bead_list.size() % 3 == 1) {
-    throw runtime_error("Wrong number of beads in angle: " + name);
+  if (bead_list.size() % nbeads != 0) {
+    throw runtime_error("Wrong number of beads in " + kind + ": " + name);
   }
-  Interaction *ic = nullptr;
-  typedef pair<MoleculesMap::iterator, MoleculesMap::iterator> MRange;
-  Index b_index = 0;
-  for (vector<string>::iterator it = bead_list.begin();
-       it != bead_list.end();) {
-    BondBead b1(*(it++));
-    BondBead b2(*(it++));
-    BondBead b3(*(it++));
-    if ((b1.molname == b2.molname) && (b2.molname == b3.molname)) {
-      // Iterates over molecules and gets atom pids.
-      MRange mRange = molecules_.equal_range(b1.molname);
-      for (MoleculesMap::iterator itm = mRange.first; itm != mRange.second;
-           ++itm) {
-        XMLMolecule &xmlMolecule = *itm->second;
-        XMLBead &xmlBead1 = *xmlMolecule.name2beads[b1.atname];
-        XMLBead &xmlBead2 = *xmlMolecule.name2beads[b2.atname];
-        XMLBead &xmlBead3 = *xmlMolecule.name2beads[b3.atname];
-        ic = new IAngle(xmlBead1.pid, xmlBead2.pid, xmlBead3.pid);
-        ic->setGroup(name);
-        ic->setIndex(b_index);
-        ic->setMolecule(xmlMolecule.pid);
-        xmlMolecule.mi->AddInteraction(ic);
-        top_->AddBondedInteraction(ic);
-        b_index++;
+
+  // position of the beads inside the molecule definitions, the bead ids of
+  // every copy follow from the id of its first bead
+  struct Entry {
+    XMLMolecule *molecule;
+    vector<Index> offsets;
+  };
+  vector<Entry> entries;
+  Index count = 0;
+  for (std::size_t i = 0; i < bead_list.size(); i += nbeads) {
+    vector<BondBead> bbeads;
+    for (Index j = 0; j < nbeads; ++j) {
+      bbeads.emplace_back(bead_list[i + j]);
+      if (bbeads[j].molname != bbeads[0].molname) {
+        throw std::runtime_error(
+            "Beads from different molecules, not supported!");
       }
-    } else {
-      throw std::runtime_error(
-          "Beads from different molecules, not supported!");
+    }
+    auto range = molecules_.equal_range(bbeads[0].molname);
+    for (auto itm = range.first; itm != range.second; ++itm) {
+      Entry entry{itm->second, vector<Index>()};
+      for (const BondBead &bb : bbeads) {
+        auto offset = entry.molecule->name2beads.find(bb.atname);
+        if (offset == entry.molecule->name2beads.end()) {
+          throw std::runtime_error("Atom " + bb.atname + " in " + kind + " " +
+                                   name + " does not exist in molecule " +
+                                   bb.molname);
+        }
+        entry.offsets.push_back(offset->second);
+      }
+      count += Index(entry.molecule->instances.size());
+      entries.push_back(std::move(entry));
     }
   }
-}
-void XMLTopologyReader::ParseDihedral(tools::Property &p) {
-  string name = p.get("name").as<string>();
-  string beads = p.get("beads").as<string>();
-  vector<string> bead_list = tools::Tokenizer(beads, " \n\t").ToVector();
-  if (bead_list.size() % 4 == 1) {
-    throw runtime_error("Wrong number of beads in dihedral: " + name);
-  }
-  Interaction *ic = nullptr;
-  typedef pair<MoleculesMap::iterator, MoleculesMap::iterator> MRange;
+
+  top_->ReserveBondedInteractions(count);
   Index b_index = 0;
-  for (vector<string>::iterator it = bead_list.begin();
-       it != bead_list.end();) {
-    BondBead b1(*(it++));
-    BondBead b2(*(it++));
-    BondBead b3(*(it++));
-    BondBead b4(*(it++));
-    if ((b1.molname == b2.molname) && (b3.molname == b4.molname) &&
-        (b1.molname == b4.molname)) {
-      // Iterates over molecules and gets atom pids.
-      MRange mRange = molecules_.equal_range(b1.molname);
-      for (MoleculesMap::iterator itm = mRange.first; itm != mRange.second;
-           ++itm) {
-        XMLMolecule &xmlMolecule = *itm->second;
-        XMLBead &xmlBead1 = *xmlMolecule.name2beads[b1.atname];
-        XMLBead &xmlBead2 = *xmlMolecule.name2beads[b2.atname];
-        XMLBead &xmlBead3 = *xmlMolecule.name2beads[b3.atname];
-        XMLBead &xmlBead4 = *xmlMolecule.name2beads[b4.atname];
-        ic = new IDihedral(xmlBead1.pid, xmlBead2.pid, xmlBead3.pid,
-                           xmlBead4.pid);
-        ic->setGroup(name);
-        ic->setIndex(b_index);
-        ic->setMolecule(xmlMolecule.pid);
-        xmlMolecule.mi->AddInteraction(ic);
-        top_->AddBondedInteraction(ic);
-        b_index++;
+  vector<Index> ids(nbeads);
+  for (const Entry &entry : entries) {
+    const XMLMolecule &xmlMolecule = *entry.molecule;
+    for (std::size_t k = 0; k < xmlMolecule.instances.size(); ++k) {
+      for (Index j = 0; j < nbeads; ++j) {
+        ids[j] = xmlMolecule.first_bead[k] + entry.offsets[j];
       }
-    } else {
-      throw std::runtime_error(
-          "Beads from different molecules, not supported!");
+      Interaction *ic = create(ids);
+      ic->setGroup(name);
+      ic->setIndex(b_index);
+      ic->setMolecule(xmlMolecule.instances[k]->getId());
+      xmlMolecule.instances[k]->AddInteraction(ic);
+      top_->AddBondedInteraction(ic);
+      b_index++;
     }
   }
 }
@@ -399,12 +353,7 @@ void XMLTopologyReader::ParseDihedral(tools::Property &p) {
 XMLTopologyReader::~XMLTopologyReader() {
   // Clean  molecules_ map
   for (auto &molecule_ : molecules_) {
-    XMLMolecule *xmlMolecule = molecule_.second;
-    for (auto &bead : xmlMolecule->beads) {
-      delete bead;
-    }
-    xmlMolecule->beads.clear();
-    delete xmlMolecule;
+    delete molecule_.second;
   }
 }
 
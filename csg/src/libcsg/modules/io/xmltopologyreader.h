@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,8 +19,11 @@
 #define VOTCA_CSG_XMLTOPOLOGYREADER_PRIVATE_H
 
 // Standard includes
+#include <functional>
+#include <map>
 #include <stack>
 #include <string>
+#include <vector>
 
 // Third party includes
 #include <boost/unordered_map.hpp>
@@ -58,22 +61,28 @@ class XMLBead {
       : name(name_), type(type_), mass(mass_), q(q_){};
   XMLBead() = default;
 
-  Index pid;
   std::string name;
   std::string type;
   double mass;
   double q;
 };
 
+/**
+ * \brief one molecule definition of the xml topology and all its copies
+ *
+ * The beads of a definition are identical in every copy, so bead names are
+ * resolved once and the copies only store the id of their first bead.
+ */
 class XMLMolecule {
  public:
   XMLMolecule(std::string name_, Index nmols_) : name(name_), nmols(nmols_) {}
   std::string name;
   Index nmols;
-  Index pid;
-  std::vector<XMLBead *> beads;
-  std::map<std::string, XMLBead *> name2beads;
-  Molecule *mi;
+  // position of a bead inside the molecule by bead name
+  std::map<std::string, Index> name2beads;
+  // first bead id and molecule of every copy
+  std::vector<Index> first_bead;
+  std::vector<Molecule *> instances;
 };
 
 /**
@@ -103,12 +112,14 @@ class XMLTopologyReader : public TopologyReader {
   void ParseBond(tools::Property &p);
   void ParseAngle(tools::Property &p);
   void ParseDihedral(tools::Property &p);
+  void ParseInteractions(
+      tools::Property &p, Index nbeads, const std::string &kind,
+      const std::function<Interaction *(const std::vector<Index> &)> &create);
 
  private:
   Topology *top_;
   MoleculesMap molecules_;
   Index mol_index_;
-  Index bead_index_;
 
   bool has_base_topology_;
 };
@@ -32,7 +32,7 @@ void XYZWriter::Open(std::string file, bool bAppend) {
 void XYZWriter::Close() { out_.close(); }
 
 void XYZWriter::Write(Topology *conf) {
-  std::string header = (boost::format("frame: %1$d time: %2$f\n") %
+  std::string header = (boost::format("frame: %1$d time: %2$f") %
                         (conf->getStep() + 1) % conf->getTime())
                            .str();
   Write<Topology>(*conf, header);
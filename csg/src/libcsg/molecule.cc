@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -28,19 +28,21 @@ using namespace std;
 
 void Molecule::AddBead(Bead *bead, const string &name) {
   beads_.push_back(bead);
-  bead_names_.push_back(name);
-  beadmap_[name] = beads_.size() - 1;
+  bead_names_.emplace_back(name);
+  beadmap_[bead_names_.back().getId()] = beads_.size() - 1;
 
   bead->setMoleculeId(id_);
 }
 
 Index Molecule::getBeadByName(const string &name) const {
-  map<string, Index>::const_iterator iter = beadmap_.find(name);
+  // a name which was never interned cannot be the name of a bead
+  map<Index, Index>::const_iterator iter =
+      beadmap_.find(tools::InternedString::Find(name));
   if (iter == beadmap_.end()) {
     std::cout << "cannot find: <" << name << "> in " << name_ << "\n";
     return -1;
   }
-  return beadmap_.at(name);
+  return iter->second;
 }
 
 }  // namespace csg
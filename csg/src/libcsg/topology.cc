@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -26,6 +26,7 @@
 #include <boost/lexical_cast.hpp>
 
 // VOTCA includes
+#include <votca/tools/internedstring.h>
 #include <votca/tools/rangeparser.h>
 
 // Local VOTCA includes
@@ -63,6 +64,9 @@ void Topology::Cleanup() {
       delete (*i);
     }
     interactions_.clear();
+    interaction_groups_.clear();
+    interactions_by_group_.clear();
+    interaction_tables_.clear();
   }
   // cleanup  bc_ object
   bc_ = std::make_unique<OpenBox>();
@@ -131,8 +135,14 @@ void Topology::CopyTopologyData(Topology *top) {
 }
 
 Index Topology::getBeadTypeId(string type) const {
-  assert(beadtypes_.count(type));
-  return beadtypes_.at(type);
+  Index interned = tools::InternedString::Find(type);
+  assert(beadtypes_.count(interned));
+  return beadtypes_.at(interned);
+}
+
+Index Topology::getBeadTypeId(const tools::InternedString &type) const {
+  assert(beadtypes_.count(type.getId()));
+  return beadtypes_.at(type.getId());
 }
 
 void Topology::RenameMolecules(string range, string name) {
@@ -148,19 +158,18 @@ void Topology::RenameMolecules(string range, string name) {
 }
 
 void Topology::RenameBeadType(string name, string newname) {
-
+  tools::InternedWildcard match(name);
   for (auto &bead : beads_) {
-    string type = bead.getType();
-    if (tools::wildcmp(name, type)) {
+    if (match(bead.getInternedType())) {
       bead.setType(newname);
     }
   }
 }
 
 void Topology::SetBeadTypeMass(string name, double value) {
+  tools::InternedWildcard match(name);
   for (auto &bead : beads_) {
-    string type = bead.getType();
-    if (tools::wildcmp(name, type)) {
+    if (match(bead.getInternedType())) {
       bead.setMass(value);
     }
   }
@@ -186,34 +195,50 @@ void Topology::CheckMoleculeNaming(void) {
 }
 
 void Topology::AddBondedInteraction(Interaction *ic) {
-  map<string, Index>::iterator iter = interaction_groups_.find(ic->getGroup());
+  auto iter = interaction_groups_.find(ic->getInternedGroup().getId());
   if (iter != interaction_groups_.end()) {
     ic->setGroupId(iter->second);
   } else {
     Index i = interaction_groups_.size();
-    interaction_groups_[ic->getGroup()] = i;
+    interaction_groups_[ic->getInternedGroup().getId()] = i;
     ic->setGroupId(i);
   }
+  if (ic->getGroupId() >= Index(interaction_tables_.size())) {
+    interaction_tables_.resize(ic->getGroupId() + 1);
+    interactions_by_group_.resize(ic->getGroupId() + 1);
+  }
+  interaction_tables_[ic->getGroupId()].Add(*ic, Index(interactions_.size()));
   interactions_.push_back(ic);
-  interactions_by_group_[ic->getGroup()].push_back(ic);
+  interactions_by_group_[ic->getGroupId()].push_back(ic);
+}
+
+const std::vector<Interaction *> &Topology::InteractionsInGroup(
+    const string &group) const {
+  static const std::vector<Interaction *> empty;
+  auto iter = interaction_groups_.find(tools::InternedString::Find(group));
+  if (iter == interaction_groups_.end()) {
+    return empty;
+  }
+  return interactions_by_group_[iter->second];
 }
 
-std::vector<Interaction *> Topology::InteractionsInGroup(const string &group) {
-  map<string, vector<Interaction *>>::iterator iter =
-      interactions_by_group_.find(group);
-  if (iter == interactions_by_group_.end()) {
-    return vector<Interaction *>();
+const InteractionTable &Topology::BondedInteractionTable(
+    const string &group) const {
+  static const InteractionTable empty;
+  auto iter = interaction_groups_.find(tools::InternedString::Find(group));
+  if (iter == interaction_groups_.end()) {
+    return empty;
   }
-  return iter->second;
+  return interaction_tables_[iter->second];
 }
 
-bool Topology::BeadTypeExist(string type) const {
-  return beadtypes_.count(type);
+bool Topology::BeadTypeExist(const string &type) const {
+  return beadtypes_.count(tools::InternedString::Find(type));
 }
 
 void Topology::RegisterBeadType(string type) {
   unordered_set<Index> ids;
-  for (pair<const string, Index> type_and_id : beadtypes_) {
+  for (pair<const Index, Index> type_and_id : beadtypes_) {
     ids.insert(type_and_id.second);
   }
 
@@ -232,7 +257,7 @@ void Topology::RegisterBeadType(string type) {
   while (ids.count(id)) {
     ++id;
   }
-  beadtypes_[type] = id;
+  beadtypes_[tools::InternedString(type).getId()] = id;
 }
 
 Eigen::Vector3d Topology::BCShortestConnection(
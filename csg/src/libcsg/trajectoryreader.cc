@@ -29,6 +29,7 @@
 #ifdef GMX_DOUBLE
 #include "modules/io/gmxtrajectoryreader.h"
 #endif
+#include "modules/io/xdrtrajectoryreader.h"
 #include "modules/io/groreader.h"
 #include "modules/io/lammpsdatareader.h"
 #include "modules/io/lammpsdumpreader.h"
@@ -44,7 +45,12 @@ void TrajectoryReader::RegisterPlugins(void) {
 #ifdef GMX_DOUBLE
   TrjReaderFactory().Register<GMXTrajectoryReader>("trr");
   TrjReaderFactory().Register<GMXTrajectoryReader>("xtc");
+#else
+  TrjReaderFactory().Register<XDRTrajectoryReader>("trr");
+  TrjReaderFactory().Register<XDRTrajectoryReader>("xtc");
 #endif
+  // the native reader can also be chosen explicitly, e.g. in gromacs builds
+  TrjReaderFactory().Register<XDRTrajectoryReader>("xdr");
   TrjReaderFactory().Register<GROReader>("gro");
   TrjReaderFactory().Register<PDBReader>("pdb");
   TrjReaderFactory().Register<DLPOLYTrajectoryReader>("dlph");
@@ -21,11 +21,16 @@
 
 // Standard includes
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 // Third party includes
 #include <boost/test/unit_test.hpp>
 
 // VOTCA includes
+#include <votca/tools/graph.h>
+#include <votca/tools/graphalgorithm.h>
+#include <votca/tools/graphdistvisitor.h>
 #include <votca/tools/types.h>
 
 // Local VOTCA includes
@@ -246,6 +251,75 @@ BOOST_AUTO_TEST_CASE(test_beadstructure_isStructureEquivalent) {
   BOOST_CHECK(beadstructure1.isStructureEquivalent(beadstructure2));
 }
 
+BOOST_AUTO_TEST_CASE(test_beadstructure_isStructureEquivalent_ids) {
+  // Same molecule, but the oxygen has the smallest id in the second structure,
+  // so the beads do not match in id order
+  BeadStructure beadstructure1;
+  BeadStructure beadstructure2;
+  std::vector<std::string> names1 = {"Carbon", "Carbon", "Oxygen"};
+  std::vector<std::string> names2 = {"Oxygen", "Carbon", "Carbon"};
+  for (votca::Index i = 0; i < 3; ++i) {
+    TestBead testbead1;
+    testbead1.setName(names1[i]);
+    testbead1.setId(i);
+    beadstructure1.AddBead(testbead1);
+    TestBead testbead2;
+    testbead2.setName(names2[i]);
+    testbead2.setId(i + 10);
+    beadstructure2.AddBead(testbead2);
+  }
+  beadstructure1.ConnectBeads(0, 1);
+  beadstructure1.ConnectBeads(1, 2);
+  beadstructure2.ConnectBeads(10, 11);
+  beadstructure2.ConnectBeads(10, 12);
+  BOOST_CHECK(!beadstructure1.isStructureEquivalent(beadstructure2));
+  beadstructure2.ConnectBeads(11, 12);
+  BOOST_CHECK(!beadstructure1.isStructureEquivalent(beadstructure2));
+
+  BeadStructure beadstructure3;
+  for (votca::Index i = 0; i < 3; ++i) {
+    TestBead testbead;
+    testbead.setName(names2[i]);
+    testbead.setId(i + 20);
+    beadstructure3.AddBead(testbead);
+  }
+  beadstructure3.ConnectBeads(20, 21);
+  beadstructure3.ConnectBeads(21, 22);
+  BOOST_CHECK(beadstructure1.isStructureEquivalent(beadstructure3));
+
+  // Two fused six rings and two five rings joined by a bond have the same
+  // hash, the structure id has to decide
+  BeadStructure decalin;
+  BeadStructure bicyclopentyl;
+  for (votca::Index i = 0; i < 10; ++i) {
+    TestBead testbead;
+    testbead.setName("Carbon");
+    testbead.setId(i);
+    decalin.AddBead(testbead);
+    bicyclopentyl.AddBead(testbead);
+  }
+  for (votca::Index i = 0; i < 9; ++i) {
+    decalin.ConnectBeads(i, i + 1);
+  }
+  decalin.ConnectBeads(9, 0);
+  decalin.ConnectBeads(0, 5);
+  for (votca::Index i = 0; i < 4; ++i) {
+    bicyclopentyl.ConnectBeads(i, i + 1);
+    bicyclopentyl.ConnectBeads(i + 5, i + 6);
+  }
+  bicyclopentyl.ConnectBeads(4, 0);
+  bicyclopentyl.ConnectBeads(9, 5);
+  bicyclopentyl.ConnectBeads(0, 5);
+  BOOST_CHECK_EQUAL(decalin.getStructureHash(),
+                    bicyclopentyl.getStructureHash());
+  Graph decalin_graph = decalin.getGraph();
+  Graph bicyclopentyl_graph = bicyclopentyl.getGraph();
+  bool same_id = findStructureId<GraphDistVisitor>(decalin_graph) ==
+                 findStructureId<GraphDistVisitor>(bicyclopentyl_graph);
+  BOOST_CHECK_EQUAL(decalin.isStructureEquivalent(bicyclopentyl), same_id);
+  BOOST_CHECK(decalin.isStructureEquivalent(decalin));
+}
+
 BOOST_AUTO_TEST_CASE(test_beadstructure_getNeighBeadIds) {
   BeadStructure beadstructure1;
 
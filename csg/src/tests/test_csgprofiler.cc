@@ -0,0 +1,91 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE csgprofiler_test
+
+// Standard includes
+#include <sstream>
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/csgprofiler.h"
+
+using namespace votca::csg;
+
+BOOST_AUTO_TEST_SUITE(csgprofiler_test)
+
+BOOST_AUTO_TEST_CASE(disabled_test) {
+  CsgProfiler profiler;
+  { CsgProfiler::ScopedTimer timer(profiler, "decode"); }
+  profiler.AddCount("frames");
+  BOOST_CHECK_EQUAL(profiler.getCalls(0, "decode"), 0);
+  BOOST_CHECK_EQUAL(profiler.getCount("frames"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(stages_test) {
+  CsgProfiler profiler;
+  profiler.Enable();
+  profiler.AddTime(0, "decode", 1.0);
+  profiler.AddTime(0, "decode", 0.5);
+  profiler.AddTime(0, "evaluate", 2.0);
+  profiler.AddTime(0, "evaluate/nonbonded", 1.5);
+  profiler.AddTime(0, "wait_input", 0.25);
+  profiler.AddTime(1, "merge", 3.0);
+  { CsgProfiler::ScopedTimer timer(profiler, "merge", 1); }
+  profiler.AddCount("pairs", 10);
+  profiler.AddCount("pairs", 5);
+
+  BOOST_CHECK_CLOSE(profiler.getTime(0, "decode"), 1.5, 1e-10);
+  BOOST_CHECK_EQUAL(profiler.getCalls(0, "decode"), 2);
+  BOOST_CHECK_EQUAL(profiler.getCalls(1, "merge"), 2);
+  BOOST_CHECK_EQUAL(profiler.getCount("pairs"), 15);
+  BOOST_CHECK_EQUAL(profiler.getCount("unknown"), 0);
+  // sub stages and waiting do not count as busy time
+  BOOST_CHECK_CLOSE(profiler.getBusyTime(0), 3.5, 1e-10);
+  BOOST_CHECK_CLOSE(profiler.getIdleTime(0), 0.25, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(report_test) {
+  CsgProfiler profiler;
+  profiler.Enable();
+  profiler.AddTime(0, "evaluate/nonbonded", 1.0);
+  profiler.AddCount("frames", 3);
+
+  std::stringstream json;
+  profiler.WriteJSON(json, "csg_test");
+  BOOST_CHECK(json.str().find("\"program\": \"csg_test\"") !=
+              std::string::npos);
+  BOOST_CHECK(json.str().find("\"frames\": 3") != std::string::npos);
+  BOOST_CHECK(json.str().find("\"evaluate/nonbonded\": {\"time\": 1, "
+                              "\"calls\": 1}") != std::string::npos);
+
+  votca::tools::Property report = profiler.Report("csg_test");
+  BOOST_CHECK_EQUAL(report.get("profile.program").as<std::string>(),
+                    "csg_test");
+  BOOST_CHECK_EQUAL(report.get("profile.counters.counter").as<votca::Index>(),
+                    3);
+  BOOST_CHECK_EQUAL(
+      report.get("profile.thread.stage").getAttribute<std::string>("name"),
+      "evaluate/nonbonded");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE interactiontable_test
+
+// Standard includes
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/interaction.h"
+#include "votca/csg/interactiontable.h"
+#include "votca/csg/topology.h"
+
+using namespace std;
+using namespace votca::csg;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(interactiontable_test)
+
+namespace {
+
+void CreateChain(Topology &top) {
+  Eigen::Matrix3d box = 5.0 * Eigen::Matrix3d::Identity();
+  top.setBox(box);
+  const std::vector<Eigen::Vector3d> pos = {
+      {0.1, 0.2, 0.3}, {4.8, 0.4, 0.1}, {4.5, 4.9, 0.6},
+      {0.3, 4.6, 1.2}, {0.9, 0.3, 1.1}, {1.1, 1.0, 0.4}};
+  for (Index i = 0; i < Index(pos.size()); ++i) {
+    Bead *bead = top.CreateBead(Bead::spherical, "a" + std::to_string(i), "C",
+                                0, 1.0, 0.0);
+    bead->setPos(pos[i]);
+  }
+  for (Index i = 0; i + 1 < Index(pos.size()); ++i) {
+    Interaction *ic = new IBond(i, i + 1);
+    ic->setGroup("bond");
+    top.AddBondedInteraction(ic);
+  }
+  for (Index i = 0; i + 2 < Index(pos.size()); ++i) {
+    Interaction *ic = new IAngle(i, i + 1, i + 2);
+    ic->setGroup("angle");
+    top.AddBondedInteraction(ic);
+  }
+  for (Index i = 0; i + 3 < Index(pos.size()); ++i) {
+    Interaction *ic = new IDihedral(i, i + 1, i + 2, i + 3);
+    ic->setGroup("dihedral");
+    top.AddBondedInteraction(ic);
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(table_layout_test) {
+  Topology top;
+  CreateChain(top);
+  BOOST_CHECK_EQUAL(top.BondedInteractionTables().size(), 3);
+
+  const InteractionTable &angles = top.BondedInteractionTable("angle");
+  BOOST_CHECK_EQUAL(angles.size(), 4);
+  BOOST_CHECK_EQUAL(angles.Arity(), 3);
+  BOOST_CHECK_EQUAL(angles.getBeadId(2, 0), 2);
+  BOOST_CHECK_EQUAL(angles.getBeadId(2, 2), 4);
+  // 5 bonds were added before the angles
+  BOOST_CHECK_EQUAL(angles.getInteractionId(0), 5);
+
+  BOOST_CHECK(top.BondedInteractionTable("unknown").empty());
+
+  top.Cleanup();
+  BOOST_CHECK(top.BondedInteractionTables().empty());
+}
+
+BOOST_AUTO_TEST_CASE(mixed_group_test) {
+  InteractionTable table;
+  IBond bond(0, 1);
+  bond.setGroup("mixed");
+  IAngle angle(0, 1, 2);
+  angle.setGroup("mixed");
+  table.Add(bond, 0);
+  BOOST_CHECK_THROW(table.Add(angle, 1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(kernel_test) {
+  Topology top;
+  CreateChain(top);
+
+  for (const std::string group : {"bond", "angle", "dihedral"}) {
+    const InteractionTable &table = top.BondedInteractionTable(group);
+    std::vector<Interaction *> ics = top.InteractionsInGroup(group);
+    BOOST_REQUIRE_EQUAL(table.size(), Index(ics.size()));
+
+    Eigen::VectorXd values;
+    Eigen::Matrix3Xd grads;
+    table.EvaluateVarAndGrad(top, values, grads);
+    Eigen::VectorXd values_only;
+    table.EvaluateVar(top, values_only);
+    BOOST_CHECK(values.isApprox(values_only, 1e-12));
+
+    for (Index i = 0; i < table.size(); ++i) {
+      BOOST_CHECK_CLOSE(values[i], ics[i]->EvaluateVar(top), 1e-8);
+      for (Index j = 0; j < table.Arity(); ++j) {
+        Eigen::Vector3d ref = ics[i]->Grad(top, j);
+        Eigen::Vector3d grad = grads.col(i * table.Arity() + j);
+        BOOST_CHECK(grad.isApprox(ref, 1e-8));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(finite_difference_test) {
+  Topology top;
+  CreateChain(top);
+  const double h = 1e-6;
+
+  for (const std::string group : {"bond", "angle", "dihedral"}) {
+    const InteractionTable &table = top.BondedInteractionTable(group);
+    Eigen::VectorXd values;
+    Eigen::Matrix3Xd grads;
+    table.EvaluateVarAndGrad(top, values, grads);
+
+    for (Index i = 0; i < table.size(); ++i) {
+      for (Index j = 0; j < table.Arity(); ++j) {
+        Bead *bead = top.getBead(table.getBeadId(i, j));
+        const Eigen::Vector3d pos = bead->getPos();
+        for (Index k = 0; k < 3; ++k) {
+          Eigen::Vector3d shifted = pos;
+          shifted[k] += h;
+          bead->setPos(shifted);
+          Eigen::VectorXd plus;
+          table.EvaluateVar(top, plus);
+          shifted[k] -= 2 * h;
+          bead->setPos(shifted);
+          Eigen::VectorXd minus;
+          table.EvaluateVar(top, minus);
+          bead->setPos(pos);
+          double numeric = (plus[i] - minus[i]) / (2 * h);
+          BOOST_CHECK_SMALL(numeric - grads(k, i * table.Arity() + j), 1e-5);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -150,6 +150,16 @@ BOOST_AUTO_TEST_CASE(test_trajectoryreader) {
   votca::Index numDihedralInter = 97;
   votca::Index totalInter = numBondInter + numAngleInter + numDihedralInter;
   BOOST_CHECK_EQUAL(interaction_cont.size(), totalInter);
+
+  // the masses are only needed to build the topology
+  string nomassesfilename = std::string(CSG_TEST_DATA_FOLDER) +
+                            "/lammpsdatareader/test_polymer4_nomasses.data";
+  std::unique_ptr<TrajectoryReader> noMassesReaderTrj =
+      TrjReaderFactory().Create(nomassesfilename);
+  noMassesReaderTrj->Open(nomassesfilename);
+  BOOST_CHECK_NO_THROW(noMassesReaderTrj->FirstFrame(top));
+  noMassesReaderTrj->Close();
+  BOOST_CHECK(last_bead_correct_pos.isApprox(top.getBead(99)->getPos(), 1e-3));
 }
 
 BOOST_AUTO_TEST_CASE(test_molecules) {
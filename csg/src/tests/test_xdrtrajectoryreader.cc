@@ -0,0 +1,365 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE xdrtrajectoryreader_test
+
+// Standard includes
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// VOTCA includes
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/bead.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/trajectoryreader.h"
+
+using namespace std;
+using namespace votca::csg;
+using votca::Index;
+
+namespace {
+
+// writes big endian xdr data
+class XDRWriter {
+ public:
+  void Int(std::int64_t value) {
+    std::uint32_t v = std::uint32_t(value);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      data_.push_back(char((v >> shift) & 0xff));
+    }
+  }
+  void Float(double value) {
+    float f = float(value);
+    std::uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    Int(bits);
+  }
+  void Opaque(const std::vector<unsigned char> &bytes) {
+    for (unsigned char c : bytes) {
+      data_.push_back(char(c));
+    }
+    while (data_.size() % 4 != 0) {
+      data_.push_back(0);
+    }
+  }
+  void WriteTo(const string &filename) const {
+    ofstream out(filename, ios::binary);
+    out.write(data_.data(), std::streamsize(data_.size()));
+  }
+
+ private:
+  std::vector<char> data_;
+};
+
+// writes a bit stream most significant bit first, as xtc does
+class BitWriter {
+ public:
+  void Bits(std::uint64_t value, int nbits) {
+    for (int i = nbits - 1; i >= 0; --i) {
+      if (pos_ % 8 == 0) {
+        bytes_.push_back(0);
+      }
+      if ((value >> i) & 1U) {
+        bytes_.back() |= (unsigned char)(1U << (7 - pos_ % 8));
+      }
+      ++pos_;
+    }
+  }
+  // packs three integers in mixed radix sizes, little endian bytes
+  void Ints(int nbits, const std::array<std::uint64_t, 3> &sizes,
+            const std::array<std::uint64_t, 3> &nums) {
+    std::uint64_t big = (nums[0] * sizes[1] + nums[1]) * sizes[2] + nums[2];
+    while (nbits > 8) {
+      Bits(big & 0xff, 8);
+      big >>= 8;
+      nbits -= 8;
+    }
+    Bits(big, nbits);
+  }
+  const std::vector<unsigned char> &Bytes() const { return bytes_; }
+
+ private:
+  std::vector<unsigned char> bytes_;
+  std::size_t pos_ = 0;
+};
+
+int BitLength(std::uint64_t value) {
+  int nbits = 0;
+  while (value >> nbits) {
+    ++nbits;
+  }
+  return nbits;
+}
+
+void WriteXTCHeader(XDRWriter &xdr, Index natoms, Index step, double time,
+                    const Eigen::Matrix3d &box) {
+  xdr.Int(1995);
+  xdr.Int(natoms);
+  xdr.Int(step);
+  xdr.Float(time);
+  for (Index j = 0; j < 3; ++j) {
+    for (Index i = 0; i < 3; ++i) {
+      xdr.Float(box(i, j));
+    }
+  }
+  xdr.Int(natoms);
+}
+
+void CreateBeads(Topology &top, Index natoms) {
+  top.RegisterBeadType("A");
+  for (Index i = 0; i < natoms; ++i) {
+    top.CreateBead(Bead::spherical, "A" + std::to_string(i), "A", 1, 1.0,
+                   0.0);
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(xdrtrajectoryreader_test)
+
+BOOST_AUTO_TEST_CASE(trr_test) {
+  const string filename = "test_xdr.trr";
+  const Index natoms = 2;
+  XDRWriter xdr;
+  for (Index frame = 0; frame < 3; ++frame) {
+    xdr.Int(1993);
+    xdr.Int(13);
+    xdr.Int(12);
+    std::string version = "GMX_trn_file";
+    xdr.Opaque(std::vector<unsigned char>(version.begin(), version.end()));
+    // ir, e, box, vir, pres, top, sym, x, v, f, natoms, step, nre
+    std::array<Index, 13> header = {0,  0,  36,     0,         0, 0, 0,
+                                    24, 24, 24, natoms, 10 * frame, 0};
+    for (Index value : header) {
+      xdr.Int(value);
+    }
+    xdr.Float(0.5 * double(frame));
+    xdr.Float(0.0);
+    for (Index i = 0; i < 9; ++i) {
+      xdr.Float((i % 4 == 0) ? 3.0 + double(frame) : 0.0);
+    }
+    for (Index i = 0; i < 3 * natoms; ++i) {
+      xdr.Float(0.1 * double(i + frame));
+    }
+    for (Index i = 0; i < 3 * natoms; ++i) {
+      xdr.Float(-0.2 * double(i));
+    }
+    for (Index i = 0; i < 3 * natoms; ++i) {
+      xdr.Float(double(i * frame));
+    }
+  }
+  xdr.WriteTo(filename);
+
+  Topology top;
+  CreateBeads(top, natoms);
+
+  TrajectoryReader::RegisterPlugins();
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  BOOST_REQUIRE(reader != nullptr);
+  reader->Open(filename);
+  Index frame = 0;
+  for (bool ok = reader->FirstFrame(top); ok; ok = reader->NextFrame(top)) {
+    BOOST_CHECK_EQUAL(top.getStep(), 10 * frame);
+    BOOST_CHECK_SMALL(top.getTime() - 0.5 * double(frame), 1e-6);
+    BOOST_CHECK_CLOSE(top.getBox()(1, 1), 3.0 + double(frame), 1e-5);
+    for (Index i = 0; i < natoms; ++i) {
+      for (Index d = 0; d < 3; ++d) {
+        Index k = 3 * i + d;
+        BOOST_CHECK_SMALL(
+            top.getBead(i)->getPos()[d] - 0.1 * double(k + frame), 1e-6);
+        BOOST_CHECK_SMALL(top.getBead(i)->getVel()[d] + 0.2 * double(k),
+                          1e-6);
+        BOOST_CHECK_SMALL(top.getBead(i)->getF()[d] - double(k * frame),
+                          1e-6);
+      }
+    }
+    ++frame;
+  }
+  reader->Close();
+  BOOST_CHECK_EQUAL(frame, 3);
+}
+
+BOOST_AUTO_TEST_CASE(xtc_uncompressed_test) {
+  const string filename = "test_xdr_small.xtc";
+  const Index natoms = 3;
+  Eigen::Matrix3d box = Eigen::Matrix3d::Identity() * 2.5;
+  XDRWriter xdr;
+  for (Index frame = 0; frame < 2; ++frame) {
+    WriteXTCHeader(xdr, natoms, frame, 2.0 * double(frame), box);
+    for (Index i = 0; i < 3 * natoms; ++i) {
+      xdr.Float(0.25 * double(i) + double(frame));
+    }
+  }
+  xdr.WriteTo(filename);
+
+  Topology top;
+  CreateBeads(top, natoms);
+  TrajectoryReader::RegisterPlugins();
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  BOOST_REQUIRE(reader != nullptr);
+  reader->Open(filename);
+  reader->FirstFrame(top);
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_EQUAL(top.getStep(), 1);
+  BOOST_CHECK_CLOSE(top.getTime(), 2.0, 1e-5);
+  BOOST_CHECK_CLOSE(top.getBox()(2, 2), 2.5, 1e-5);
+  BOOST_CHECK_CLOSE(top.getBead(2)->getPos()[1], 0.25 * 7.0 + 1.0, 1e-5);
+  BOOST_CHECK(!reader->NextFrame(top));
+  reader->Close();
+}
+
+BOOST_AUTO_TEST_CASE(xtc_compressed_test) {
+  const string filename = "test_xdr.xtc";
+  const Index natoms = 12;
+  const double precision = 1000.0;
+  Eigen::Matrix3d box = Eigen::Matrix3d::Identity() * 4.0;
+
+  // integer coordinates, the last three atoms are close and stored as a run
+  // of small differences
+  std::vector<std::array<std::int64_t, 3>> coords;
+  for (Index i = 0; i < 9; ++i) {
+    coords.push_back({100 * i + 5, 2000 - 37 * i, 50 + 211 * (i % 4)});
+  }
+  coords.push_back({1500, 1200, 700});
+  coords.push_back({1503, 1195, 702});
+  coords.push_back({1499, 1201, 706});
+
+  std::array<std::int64_t, 3> minint = coords[0];
+  std::array<std::int64_t, 3> maxint = coords[0];
+  for (const auto &c : coords) {
+    for (Index d = 0; d < 3; ++d) {
+      minint[d] = std::min(minint[d], c[d]);
+      maxint[d] = std::max(maxint[d], c[d]);
+    }
+  }
+  std::array<std::uint64_t, 3> sizeint;
+  for (Index d = 0; d < 3; ++d) {
+    sizeint[d] = std::uint64_t(maxint[d] - minint[d] + 1);
+  }
+  const int bitsize = BitLength(sizeint[0] * sizeint[1] * sizeint[2]);
+  // magicints[12] = 16, so differences from -8 to 7 fit
+  const int smallidx = 12;
+  const std::int64_t smallnum = 8;
+  const std::array<std::uint64_t, 3> sizesmall = {16, 16, 16};
+
+  auto large = [&](BitWriter &bits, const std::array<std::int64_t, 3> &c) {
+    bits.Ints(bitsize, sizeint,
+              {std::uint64_t(c[0] - minint[0]), std::uint64_t(c[1] - minint[1]),
+               std::uint64_t(c[2] - minint[2])});
+  };
+  auto small = [&](BitWriter &bits, const std::array<std::int64_t, 3> &c,
+                   const std::array<std::int64_t, 3> &ref) {
+    bits.Ints(4 * 3, sizesmall,
+              {std::uint64_t(c[0] - ref[0] + smallnum),
+               std::uint64_t(c[1] - ref[1] + smallnum),
+               std::uint64_t(c[2] - ref[2] + smallnum)});
+  };
+
+  BitWriter bits;
+  for (Index i = 0; i < 9; ++i) {
+    large(bits, coords[i]);
+    bits.Bits(0, 1);
+  }
+  // the second atom of a run is stored as large coordinate, the first one
+  // relative to it and every further one relative to the previous
+  large(bits, coords[10]);
+  bits.Bits(1, 1);
+  bits.Bits(3 * 2 + 1, 5);
+  small(bits, coords[9], coords[10]);
+  small(bits, coords[11], coords[9]);
+
+  XDRWriter xdr;
+  WriteXTCHeader(xdr, natoms, 42, 1.5, box);
+  xdr.Float(precision);
+  for (std::int64_t m : minint) {
+    xdr.Int(m);
+  }
+  for (std::int64_t m : maxint) {
+    xdr.Int(m);
+  }
+  xdr.Int(smallidx);
+  xdr.Int(Index(bits.Bytes().size()));
+  xdr.Opaque(bits.Bytes());
+  xdr.WriteTo(filename);
+
+  Topology top;
+  CreateBeads(top, natoms);
+  TrajectoryReader::RegisterPlugins();
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  BOOST_REQUIRE(reader != nullptr);
+  reader->Open(filename);
+  reader->FirstFrame(top);
+  BOOST_CHECK_EQUAL(top.getStep(), 42);
+  BOOST_CHECK_CLOSE(top.getTime(), 1.5, 1e-5);
+  for (Index i = 0; i < natoms; ++i) {
+    for (Index d = 0; d < 3; ++d) {
+      BOOST_CHECK_CLOSE(top.getBead(i)->getPos()[d],
+                        double(coords[i][d]) / precision, 1e-4);
+    }
+  }
+  BOOST_CHECK(!reader->NextFrame(top));
+  reader->Close();
+}
+
+BOOST_AUTO_TEST_CASE(select_native_reader_test) {
+  const string filename = "test_xdr_select.xtc";
+  const Index natoms = 2;
+  Eigen::Matrix3d box = Eigen::Matrix3d::Identity() * 1.5;
+  XDRWriter xdr;
+  WriteXTCHeader(xdr, natoms, 7, 3.0, box);
+  for (Index i = 0; i < 3 * natoms; ++i) {
+    xdr.Float(0.5 * double(i));
+  }
+  xdr.WriteTo(filename);
+
+  // in gromacs builds xtc files use the gromacs reader by default, the
+  // native one has to be available under its own name in every build
+  TrajectoryReader::RegisterPlugins();
+  BOOST_CHECK(TrjReaderFactory().IsRegistered("xdr"));
+  BOOST_CHECK_THROW(TrjReaderFactory().Create(filename, "no_such_format"),
+                    std::runtime_error);
+
+  Topology top;
+  CreateBeads(top, natoms);
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename, "xdr");
+  BOOST_REQUIRE(reader != nullptr);
+  reader->Open(filename);
+  reader->FirstFrame(top);
+  BOOST_CHECK_EQUAL(top.getStep(), 7);
+  BOOST_CHECK_CLOSE(top.getTime(), 3.0, 1e-5);
+  BOOST_CHECK_CLOSE(top.getBead(1)->getPos()[2], 2.5, 1e-5);
+  BOOST_CHECK(!reader->NextFrame(top));
+  reader->Close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE xmltopologyreader_test
+
+// Standard includes
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/interaction.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/topologyreader.h"
+
+using namespace std;
+using namespace votca::csg;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(xmltopologyreader_test)
+
+BOOST_AUTO_TEST_CASE(test_molecules) {
+  TopologyReader::RegisterPlugins();
+  string file =
+      std::string(CSG_TEST_DATA_FOLDER) + "/xmltopologyreader/topol.xml";
+  std::unique_ptr<TopologyReader> reader = TopReaderFactory().Create(file);
+  BOOST_REQUIRE(reader != nullptr);
+  Topology top;
+  reader->ReadTopology(file, top);
+
+  BOOST_CHECK_EQUAL(top.BeadCount(), 11);
+  BOOST_CHECK_EQUAL(top.MoleculeCount(), 5);
+  vector<string> names = {"A1", "B1", "A2"};
+  vector<string> types = {"A", "B", "A"};
+  for (Index m = 0; m < 3; ++m) {
+    const Molecule *mol = top.MoleculeByIndex(m);
+    BOOST_CHECK_EQUAL(mol->getName(), "propane");
+    BOOST_REQUIRE_EQUAL(mol->BeadCount(), 3);
+    for (Index b = 0; b < 3; ++b) {
+      const Bead *bead = mol->getBead(b);
+      BOOST_CHECK_EQUAL(bead->getId(), 3 * m + b);
+      BOOST_CHECK_EQUAL(bead->getName(), names[b]);
+      BOOST_CHECK_EQUAL(bead->getType(), types[b]);
+      BOOST_CHECK_EQUAL(bead->getResnr(), m);
+      BOOST_CHECK_EQUAL(bead->getMoleculeId(), m);
+      BOOST_CHECK_EQUAL(mol->getBeadName(b), "1:propane:" + names[b]);
+    }
+  }
+  for (Index m = 3; m < 5; ++m) {
+    const Molecule *mol = top.MoleculeByIndex(m);
+    BOOST_CHECK_EQUAL(mol->getName(), "water");
+    BOOST_REQUIRE_EQUAL(mol->BeadCount(), 1);
+    BOOST_CHECK_EQUAL(mol->getBead(0)->getId(), 6 + m);
+    BOOST_CHECK_CLOSE(mol->getBead(0)->getMass(), 18.0, 1e-10);
+  }
+  BOOST_CHECK(top.BeadTypeExist("W"));
+}
+
+BOOST_AUTO_TEST_CASE(test_bonded) {
+  TopologyReader::RegisterPlugins();
+  string file =
+      std::string(CSG_TEST_DATA_FOLDER) + "/xmltopologyreader/topol.xml";
+  std::unique_ptr<TopologyReader> reader = TopReaderFactory().Create(file);
+  Topology top;
+  reader->ReadTopology(file, top);
+
+  // two bonds and one angle in each of the three propanes
+  BOOST_REQUIRE_EQUAL(top.BondedInteractions().size(), 9);
+  vector<Interaction *> bonds = top.InteractionsInGroup("bond");
+  BOOST_REQUIRE_EQUAL(bonds.size(), 6);
+  for (Index i = 0; i < 6; ++i) {
+    // all copies of the first bond, then all copies of the second bond
+    Index mol = i % 3;
+    Index first = 3 * mol + i / 3;
+    BOOST_CHECK_EQUAL(bonds[i]->getMolecule(), mol);
+    BOOST_CHECK_EQUAL(bonds[i]->getIndex(), i);
+    BOOST_CHECK_EQUAL(bonds[i]->getBeadId(0), first);
+    BOOST_CHECK_EQUAL(bonds[i]->getBeadId(1), first + 1);
+  }
+  vector<Interaction *> angles = top.InteractionsInGroup("angle");
+  BOOST_REQUIRE_EQUAL(angles.size(), 3);
+  for (Index mol = 0; mol < 3; ++mol) {
+    BOOST_CHECK_EQUAL(angles[mol]->getBeadId(0), 3 * mol);
+    BOOST_CHECK_EQUAL(angles[mol]->getBeadId(2), 3 * mol + 2);
+    BOOST_CHECK_EQUAL(top.MoleculeByIndex(mol)->Interactions().size(), 3);
+  }
+  // bonded beads are excluded
+  BOOST_CHECK(top.getExclusions().IsExcluded(top.getBead(0), top.getBead(1)));
+  BOOST_CHECK(!top.getExclusions().IsExcluded(top.getBead(0), top.getBead(3)));
+
+  string missing = std::string(CSG_TEST_DATA_FOLDER) +
+                   "/xmltopologyreader/missing_bead.xml";
+  Topology top2;
+  BOOST_CHECK_THROW(reader->ReadTopology(missing, top2), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE xyzreaderwriter_test
+
+// Standard includes
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// VOTCA includes
+#include <votca/tools/constants.h>
+
+// Local VOTCA includes
+#include "votca/csg/bead.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/trajectoryreader.h"
+#include "votca/csg/trajectorywriter.h"
+
+using namespace std;
+using namespace votca::csg;
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(xyzreaderwriter_test)
+
+/**
+ * \brief Pins the output of the xyz writer for a topology
+ *
+ * Beads are written with their bead names, cut or padded to three characters,
+ * and their positions converted from nm to Angstrom. The header is a single
+ * line, so the file can be read back by the xyz reader.
+ */
+BOOST_AUTO_TEST_CASE(test_trajectorywriter) {
+
+  Topology top;
+  top.setStep(4);
+  top.setTime(0.5);
+  top.RegisterBeadType("C");
+  top.RegisterBeadType("H");
+  Bead *b1 = top.CreateBead(Bead::spherical, "C1", "C", 0, 12.0, 0.0);
+  b1->setPos(Eigen::Vector3d(0.1, -0.2, 0.3));
+  Bead *b2 = top.CreateBead(Bead::spherical, "HW12", "H", 0, 1.0, 0.0);
+  b2->setPos(Eigen::Vector3d(1.0, 0.0, 2.5));
+
+  string filename = "test_xyzwriter.xyz";
+  TrajectoryWriter::RegisterPlugins();
+  std::unique_ptr<TrajectoryWriter> writer =
+      TrjWriterFactory().Create(filename);
+  writer->Open(filename);
+  writer->Write(&top);
+  writer->Close();
+
+  std::ifstream in(filename);
+  std::stringstream written;
+  written << in.rdbuf();
+  in.close();
+
+  string ref =
+      "2\n"
+      "frame: 5 time: 0.500000\n"
+      " C1   1.00000  -2.00000   3.00000\n"
+      "HW1  10.00000   0.00000  25.00000\n";
+  BOOST_CHECK_EQUAL(written.str(), ref);
+
+  Topology top_read;
+  top_read.RegisterBeadType("C");
+  top_read.RegisterBeadType("H");
+  top_read.CreateBead(Bead::spherical, "C1", "C", 0, 12.0, 0.0);
+  top_read.CreateBead(Bead::spherical, "HW12", "H", 0, 1.0, 0.0);
+  TrajectoryReader::RegisterPlugins();
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  reader->Open(filename);
+  reader->FirstFrame(top_read);
+  reader->Close();
+  BOOST_CHECK(top_read.getBead(0)->getPos().isApprox(b1->getPos(), 1e-5));
+  BOOST_CHECK(top_read.getBead(1)->getPos().isApprox(b2->getPos(), 1e-5));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -41,18 +41,42 @@ class CsgDensityApp : public CsgApplication {
   bool DoMapping() override { return true; }
   bool DoMappingDefault(void) override { return false; }
 
+  // frames are binned into thread-local histograms
+  bool DoThreaded() override { return true; }
+  // ordered merging is only needed when writing blocks
+  bool SynchronizeThreads() override { return block_length_ != 0; }
+
   // write out results in EndEvaluate
   void EndEvaluate() override;
   void BeginEvaluate(Topology *top, Topology *top_atom) override;
-  void EvalConfiguration(Topology *top, Topology *top_ref) override;
 
   bool EvaluateOptions() override {
     CsgApplication::EvaluateOptions();
     CheckRequired("out", "no output topology specified");
     CheckRequired("trj", "no trajectory file specified");
+    if (OptionsMap().count("block-length")) {
+      block_length_ = OptionsMap()["block-length"].as<votca::Index>();
+    } else {
+      block_length_ = 0;
+    }
     return true;
   };
 
+  class DensityWorker : public CsgApplication::Worker {
+   public:
+    DensityWorker(const CsgDensityApp *app) : density_app_(app) {}
+    void EvalConfiguration(Topology *top, Topology *top_ref) override;
+
+    const CsgDensityApp *density_app_;
+    votca::tools::HistogramNew dist_;
+    votca::Index frames_ = 0;
+  };
+
+  std::unique_ptr<CsgApplication::Worker> ForkWorker() override {
+    return std::make_unique<DensityWorker>(this);
+  }
+  void MergeWorker(CsgApplication::Worker *worker) override;
+
  protected:
   string filter_, out_;
   votca::tools::HistogramNew dist_;
@@ -110,12 +134,6 @@ void CsgDensityApp::BeginEvaluate(Topology *top, Topology *) {
     rmax_ = OptionsMap()["rmax"].as<double>();
   }
 
-  if (OptionsMap().count("block-length")) {
-    block_length_ = OptionsMap()["block-length"].as<votca::Index>();
-  } else {
-    block_length_ = 0;
-  }
-
   if (axisname_ == "r") {
     if (!OptionsMap().count("ref")) {
       ref_ = a / 2 + b / 2 + c / 2;
@@ -136,26 +154,33 @@ void CsgDensityApp::BeginEvaluate(Topology *top, Topology *) {
   nblock_ = 0;
 }
 
-void CsgDensityApp::EvalConfiguration(Topology *top, Topology *) {
+void CsgDensityApp::DensityWorker::EvalConfiguration(Topology *top,
+                                                     Topology *) {
+  const CsgDensityApp &app = *density_app_;
+  // the histogram layout is only known after BeginEvaluate
+  if (dist_.getNBins() != app.nbin_) {
+    dist_.setPeriodic(app.axisname_ != "r");
+    dist_.Initialize(0, app.rmax_, app.nbin_);
+  }
   // loop over all molecules
   bool did_something = false;
   for (const auto &mol : top->Molecules()) {
-    if (!votca::tools::wildcmp(molname_, mol.getName())) {
+    if (!votca::tools::wildcmp(app.molname_, mol.getName())) {
       continue;
     }
     votca::Index N = mol.BeadCount();
     for (votca::Index i = 0; i < N; i++) {
       const Bead *b = mol.getBead(i);
-      if (!votca::tools::wildcmp(filter_, b->getName())) {
+      if (!votca::tools::wildcmp(app.filter_, b->getName())) {
         continue;
       }
       double r;
-      if (axisname_ == "r") {
-        r = (top->BCShortestConnection(ref_, b->getPos()).norm());
+      if (app.axisname_ == "r") {
+        r = (top->BCShortestConnection(app.ref_, b->getPos()).norm());
       } else {
-        r = b->getPos().dot(axis_);
+        r = b->getPos().dot(app.axis_);
       }
-      if (dens_type_ == "mass") {
+      if (app.dens_type_ == "mass") {
         dist_.Process(r, b->getMass());
       } else {
         dist_.Process(r, 1.0);
@@ -167,8 +192,20 @@ void CsgDensityApp::EvalConfiguration(Topology *top, Topology *) {
   if (!did_something) {
     throw std::runtime_error("No molecule in selection");
   }
+}
+
+void CsgDensityApp::MergeWorker(CsgApplication::Worker *worker) {
+  DensityWorker *density_worker = dynamic_cast<DensityWorker *>(worker);
+  if (density_worker->frames_ == 0) {
+    return;
+  }
+  dist_.data().y() += density_worker->dist_.data().y();
+  frames_ += density_worker->frames_;
+  density_worker->dist_.Clear();
+  density_worker->frames_ = 0;
+
   if (block_length_ != 0) {
-    if ((nframes_ % block_length_) == 0) {
+    if ((frames_ % block_length_) == 0) {
       nblock_++;
       string suffix = string("_") + boost::lexical_cast<string>(nblock_);
       WriteDensity(block_length_, suffix);
@@ -570,38 +570,35 @@ void CGForceMatching::LoadOptions(const string &file) {
 
 void CGForceMatching::EvalBonded(Topology *conf, SplineInfo *sinfo) {
 
-  std::vector<Interaction *> interList =
-      conf->InteractionsInGroup(sinfo->splineName);
+  const InteractionTable &table =
+      conf->BondedInteractionTable(sinfo->splineName);
 
-  for (Interaction *inter : interList) {
+  // value of bond, angle, or dihedral and gradients for the whole group
+  Eigen::VectorXd vars;
+  Eigen::Matrix3Xd gradients;
+  table.EvaluateVarAndGrad(*conf, vars, gradients);
 
-    votca::Index beads_in_int = inter->BeadCount();  // 2 for bonds, 3 for
-                                                     // angles, 4 for dihedrals
+  votca::tools::CubicSpline &SP = sinfo->Spline;
+  votca::Index mpos = sinfo->matr_pos;
+  votca::Index offset = least_sq_offset_ + 3 * nbeads_ * frame_counter_;
 
-    votca::tools::CubicSpline &SP = sinfo->Spline;
-
-    votca::Index mpos = sinfo->matr_pos;
-
-    double var = inter->EvaluateVar(*conf);  // value of bond, angle,
-                                             // or dihedral
+  // 2 for bonds, 3 for angles, 4 for dihedrals
+  votca::Index beads_in_int = table.Arity();
 
+  // every interaction adds to the x, y and z rows of each of its beads
+  votca::tools::CubicSpline::IndexMatrix rows(3 * beads_in_int, table.size());
+  Eigen::MatrixXd scale(3 * beads_in_int, table.size());
+  for (votca::Index i = 0; i < table.size(); i++) {
     for (votca::Index loop = 0; loop < beads_in_int; loop++) {
-      votca::Index ii = inter->getBeadId(loop);
-      Eigen::Vector3d gradient = inter->Grad(*conf, loop);
-
-      SP.AddToFitMatrix(A_, var,
-                        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + ii,
-                        mpos, -gradient.x());
-      SP.AddToFitMatrix(
-          A_, var,
-          least_sq_offset_ + 3 * nbeads_ * frame_counter_ + nbeads_ + ii, mpos,
-          -gradient.y());
-      SP.AddToFitMatrix(
-          A_, var,
-          least_sq_offset_ + 3 * nbeads_ * frame_counter_ + 2 * nbeads_ + ii,
-          mpos, -gradient.z());
+      votca::Index ii = table.getBeadId(i, loop);
+      const auto gradient = gradients.col(i * beads_in_int + loop);
+      for (votca::Index dim = 0; dim < 3; dim++) {
+        rows(3 * loop + dim, i) = offset + dim * nbeads_ + ii;
+        scale(3 * loop + dim, i) = -gradient[dim];
+      }
     }
   }
+  SP.AddToFitMatrix(A_, vars, rows, mpos, scale);
 }
 
 void CGForceMatching::EvalNonbonded(Topology *conf, SplineInfo *sinfo) {
@@ -644,43 +641,34 @@ void CGForceMatching::EvalNonbonded(Topology *conf, SplineInfo *sinfo) {
     nb->Generate(beads1, beads2, true);
   }
 
+  votca::tools::CubicSpline &SP = sinfo->Spline;
+  votca::Index mpos = sinfo->matr_pos;
+  votca::Index offset = least_sq_offset_ + 3 * nbeads_ * frame_counter_;
+
+  // collect all pairs, so the spline terms are evaluated once per pair
+  const votca::Index npairs = nb->size();
+  Eigen::VectorXd vars(npairs);
+  votca::tools::CubicSpline::IndexMatrix rows(6, npairs);
+  Eigen::MatrixXd scale(6, npairs);
+  votca::Index k = 0;
   for (BeadPair *pair : *nb) {
     votca::Index iatom = pair->first()->getId();
     votca::Index jatom = pair->second()->getId();
-    double var = pair->dist();
+    vars[k] = pair->dist();
     Eigen::Vector3d gradient = pair->r();
     gradient.normalize();
 
-    votca::tools::CubicSpline &SP = sinfo->Spline;
-
-    votca::Index mpos = sinfo->matr_pos;
-
-    // add iatom
-    SP.AddToFitMatrix(A_, var,
-                      least_sq_offset_ + 3 * nbeads_ * frame_counter_ + iatom,
-                      mpos, gradient.x());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + nbeads_ + iatom, mpos,
-        gradient.y());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + 2 * nbeads_ + iatom,
-        mpos, gradient.z());
-
-    // add jatom
-    SP.AddToFitMatrix(A_, var,
-                      least_sq_offset_ + 3 * nbeads_ * frame_counter_ + jatom,
-                      mpos, -gradient.x());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + nbeads_ + jatom, mpos,
-        -gradient.y());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + 2 * nbeads_ + jatom,
-        mpos, -gradient.z());
+    for (votca::Index dim = 0; dim < 3; dim++) {
+      // add iatom
+      rows(dim, k) = offset + dim * nbeads_ + iatom;
+      scale(dim, k) = gradient[dim];
+      // add jatom
+      rows(3 + dim, k) = offset + dim * nbeads_ + jatom;
+      scale(3 + dim, k) = -gradient[dim];
+    }
+    k++;
   }
+  SP.AddToFitMatrix(A_, vars, rows, mpos, scale);
 }
 
 void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
@@ -740,6 +728,29 @@ void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
     nb->Generate(beads1, beads2, beads3, true);
   }
 
+  votca::tools::CubicSpline &SP = sinfo->Spline;
+  votca::Index mpos = sinfo->matr_pos;
+  votca::Index offset = least_sq_offset_ + 3 * nbeads_ * frame_counter_;
+
+  // collect all triples, so the spline terms are evaluated once per triple
+  const votca::Index ntriples = votca::Index(nb->size());
+  Eigen::VectorXd vars(ntriples);
+  votca::tools::CubicSpline::IndexMatrix rows(9, ntriples);
+  Eigen::MatrixXd scale1(9, ntriples);
+  Eigen::MatrixXd scale2(9, ntriples);
+  votca::Index k = 0;
+
+  // adds the rows of one atom of the triple
+  auto add_atom = [&](votca::Index atom_in_triple, votca::Index atom,
+                      const Eigen::Vector3d &gradient1,
+                      const Eigen::Vector3d &gradient2) {
+    for (votca::Index dim = 0; dim < 3; dim++) {
+      rows(3 * atom_in_triple + dim, k) = offset + dim * nbeads_ + atom;
+      scale1(3 * atom_in_triple + dim, k) = -gradient1[dim];
+      scale2(3 * atom_in_triple + dim, k) = -gradient2[dim];
+    }
+  };
+
   for (BeadTriple *triple : *nb) {
     votca::Index iatom = triple->bead1()->getId();
     votca::Index jatom = triple->bead2()->getId();
@@ -755,11 +766,7 @@ void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
     double expij = std::exp(gamma_sigma / denomij);
     double expik = std::exp(gamma_sigma / denomik);
 
-    votca::tools::CubicSpline &SP = sinfo->Spline;
-
-    votca::Index mpos = sinfo->matr_pos;
-
-    double var =
+    vars[k] =
         std::acos(rij.dot(rik) / sqrt(rij.squaredNorm() * rik.squaredNorm()));
 
     double acos_prime =
@@ -778,17 +785,7 @@ void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
         expij * expik;
 
     // add iatom
-    SP.AddToFitMatrix(A_, var,
-                      least_sq_offset_ + 3 * nbeads_ * frame_counter_ + iatom,
-                      mpos, -gradient1.x(), -gradient2.x());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + nbeads_ + iatom, mpos,
-        -gradient1.y(), -gradient2.y());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + 2 * nbeads_ + iatom,
-        mpos, -gradient1.z(), -gradient2.z());
+    add_atom(0, iatom, gradient1, gradient2);
 
     // evaluate gradient1 and gradient2 for jatom:
     gradient1 = acos_prime *
@@ -800,17 +797,7 @@ void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
                 expij * expik;
 
     // add jatom
-    SP.AddToFitMatrix(A_, var,
-                      least_sq_offset_ + 3 * nbeads_ * frame_counter_ + jatom,
-                      mpos, -gradient1.x(), -gradient2.x());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + nbeads_ + jatom, mpos,
-        -gradient1.y(), -gradient2.y());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + 2 * nbeads_ + jatom,
-        mpos, -gradient1.z(), -gradient2.z());
+    add_atom(1, jatom, gradient1, gradient2);
 
     // evaluate gradient1 and gradient2 for katom:
     gradient1 = acos_prime *
@@ -822,16 +809,8 @@ void CGForceMatching::EvalNonbonded_Threebody(Topology *conf,
                 expij * expik;
 
     // add katom
-    SP.AddToFitMatrix(A_, var,
-                      least_sq_offset_ + 3 * nbeads_ * frame_counter_ + katom,
-                      mpos, -gradient1.x(), -gradient2.x());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + nbeads_ + katom, mpos,
-        -gradient1.y(), -gradient2.y());
-    SP.AddToFitMatrix(
-        A_, var,
-        least_sq_offset_ + 3 * nbeads_ * frame_counter_ + 2 * nbeads_ + katom,
-        mpos, -gradient1.z(), -gradient2.z());
+    add_atom(2, katom, gradient1, gradient2);
+    k++;
   }
+  SP.AddToFitMatrix(A_, vars, rows, mpos, scale1, scale2);
 }
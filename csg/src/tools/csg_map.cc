@@ -18,6 +18,7 @@
 // Standard includes
 #include <cstddef>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -80,83 +81,30 @@ class CsgMapApp : public CsgApplication {
     return true;
   }
 
+  // frames are mapped in parallel by the workers and written in order while
+  // the other workers continue mapping
+  bool DoThreaded() override { return true; }
+  bool SynchronizeThreads() override { return true; }
+
   void BeginEvaluate(Topology *top, Topology *top_ref) override;
-  void EvalConfiguration(Topology *top, Topology *top_ref) override {
-    if (!do_hybrid_) {
-      // simply write the topology mapped by csgapplication class
-      if (do_vel_) {
-        top->SetHasVel(true);
-      }
-      if (do_force_) {
-        top->SetHasForce(true);
-      }
-      writer_->Write(top);
-    } else {
-      // we want to combine atomistic and coarse-grained into one topology
-      Topology hybtol;
-
-      hybtol.setBox(top->getBox());
-      hybtol.setTime(top->getTime());
-      hybtol.setStep(top->getStep());
-
-      // copy all residues from both
-      for (const auto &residue : top_ref->Residues()) {
-        hybtol.CreateResidue(residue.getName());
-      }
-      for (const auto &residue : top->Residues()) {
-        hybtol.CreateResidue(residue.getName());
-      }
 
-      // copy all molecules and beads
-
-      for (const auto &molecule : top_ref->Molecules()) {
-        Molecule *mi = hybtol.CreateMolecule(molecule.getName());
-        for (votca::Index i = 0; i < molecule.BeadCount(); i++) {
-          // copy atomistic beads of molecule
-          votca::Index beadid = molecule.getBead(i)->getId();
-
-          const Bead *bi = molecule.getBead(i);
-          if (!hybtol.BeadTypeExist(bi->getType())) {
-            hybtol.RegisterBeadType(bi->getType());
-          }
-
-          Bead *bn =
-              hybtol.CreateBead(bi->getSymmetry(), bi->getName(), bi->getType(),
-                                bi->getResnr(), bi->getMass(), bi->getQ());
-          bn->setPos(bi->getPos());
-          if (bi->HasVel()) {
-            bn->setVel(bi->getVel());
-          }
-          if (bi->HasF()) {
-            bn->setF(bi->getF());
-          }
-
-          mi->AddBead(&hybtol.Beads()[beadid], molecule.getBeadName(i));
-        }
+  class MapWorker : public CsgApplication::Worker {
+   public:
+    MapWorker(const CsgMapApp *app) : map_app_(app) {}
+    void EvalConfiguration(Topology *top, Topology *top_ref) override;
 
-        if (mi->getId() < top->MoleculeCount()) {
-          // copy cg beads of molecule
-          Molecule *cgmol = top->getMolecule(mi->getId());
-          for (votca::Index i = 0; i < cgmol->BeadCount(); i++) {
-            Bead *bi = cgmol->getBead(i);
-            // todo: this is a bit dirty as a cg bead will always have the resid
-            // of its first parent
-            const Bead *bparent = molecule.getBead(0);
-            Bead *bn = hybtol.CreateBead(bi->getSymmetry(), bi->getName(),
-                                         bi->getType(), bparent->getResnr(),
-                                         bi->getMass(), bi->getQ());
-            bn->setPos(bi->getPos());
-            if (bi->HasVel()) {
-              bn->setVel(bi->getVel());
-            }
-            mi->AddBead(bi, bi->getName());
-          }
-        }
-      }
-      hybtol.setBox(top_ref->getBox());
+    const CsgMapApp *map_app_;
+    /// topology of the current frame that is written in MergeWorker
+    Topology *out_ = nullptr;
+    std::unique_ptr<Topology> hybtol_;
+  };
 
-      writer_->Write(&hybtol);
-    }
+  std::unique_ptr<CsgApplication::Worker> ForkWorker() override {
+    return std::make_unique<MapWorker>(this);
+  }
+
+  void MergeWorker(CsgApplication::Worker *worker) override {
+    writer_->Write(dynamic_cast<MapWorker *>(worker)->out_);
   }
 
   void EndEvaluate() override { writer_->Close(); }
@@ -198,6 +146,87 @@ void CsgMapApp::BeginEvaluate(Topology *, Topology *) {
   writer_->Open(out);
 }
 
+// we want to combine atomistic and coarse-grained into one topology
+static void CreateHybridTopology(Topology *top, Topology *top_ref,
+                                 Topology &hybtol) {
+  hybtol.setBox(top->getBox());
+  hybtol.setTime(top->getTime());
+  hybtol.setStep(top->getStep());
+
+  // copy all residues from both
+  for (const auto &residue : top_ref->Residues()) {
+    hybtol.CreateResidue(residue.getName());
+  }
+  for (const auto &residue : top->Residues()) {
+    hybtol.CreateResidue(residue.getName());
+  }
+
+  // copy all molecules and beads
+
+  for (const auto &molecule : top_ref->Molecules()) {
+    Molecule *mi = hybtol.CreateMolecule(molecule.getName());
+    for (votca::Index i = 0; i < molecule.BeadCount(); i++) {
+      // copy atomistic beads of molecule
+      votca::Index beadid = molecule.getBead(i)->getId();
+
+      const Bead *bi = molecule.getBead(i);
+      if (!hybtol.BeadTypeExist(bi->getType())) {
+        hybtol.RegisterBeadType(bi->getType());
+      }
+
+      Bead *bn =
+          hybtol.CreateBead(bi->getSymmetry(), bi->getName(), bi->getType(),
+                            bi->getResnr(), bi->getMass(), bi->getQ());
+      bn->setPos(bi->getPos());
+      if (bi->HasVel()) {
+        bn->setVel(bi->getVel());
+      }
+      if (bi->HasF()) {
+        bn->setF(bi->getF());
+      }
+
+      mi->AddBead(&hybtol.Beads()[beadid], molecule.getBeadName(i));
+    }
+
+    if (mi->getId() < top->MoleculeCount()) {
+      // copy cg beads of molecule
+      Molecule *cgmol = top->getMolecule(mi->getId());
+      for (votca::Index i = 0; i < cgmol->BeadCount(); i++) {
+        Bead *bi = cgmol->getBead(i);
+        // todo: this is a bit dirty as a cg bead will always have the resid
+        // of its first parent
+        const Bead *bparent = molecule.getBead(0);
+        Bead *bn = hybtol.CreateBead(bi->getSymmetry(), bi->getName(),
+                                     bi->getType(), bparent->getResnr(),
+                                     bi->getMass(), bi->getQ());
+        bn->setPos(bi->getPos());
+        if (bi->HasVel()) {
+          bn->setVel(bi->getVel());
+        }
+        mi->AddBead(bi, bi->getName());
+      }
+    }
+  }
+  hybtol.setBox(top_ref->getBox());
+}
+
+void CsgMapApp::MapWorker::EvalConfiguration(Topology *top, Topology *top_ref) {
+  if (!map_app_->do_hybrid_) {
+    // simply write the topology mapped by csgapplication class
+    if (map_app_->do_vel_) {
+      top->SetHasVel(true);
+    }
+    if (map_app_->do_force_) {
+      top->SetHasForce(true);
+    }
+    out_ = top;
+  } else {
+    hybtol_ = std::make_unique<Topology>();
+    CreateHybridTopology(top, top_ref, *hybtol_);
+    out_ = hybtol_.get();
+  }
+}
+
 int main(int argc, char **argv) {
   CsgMapApp app;
   return app.Exec(argc, argv);
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -23,6 +23,9 @@
 // Third party includes
 #include <boost/program_options.hpp>
 
+// VOTCA includes
+#include <votca/tools/tokenizer.h>
+
 // Local VOTCA includes
 #include "votca/csg/csgapplication.h"
 #include "votca/csg/version.h"
@@ -43,8 +46,11 @@ class CsgStatApp : public CsgApplication {
   bool DoMappingDefault(void) override { return false; }
   bool DoThreaded() override { return true; }
   bool SynchronizeThreads() override { return true; }
+  // merging partial states does not read any trajectory
+  bool NeedsTopology() override { return OptionsMap().count("merge") == 0; }
   void Initialize() override;
   bool EvaluateOptions() override;
+  void Run() override;
 
   void BeginEvaluate(Topology *top, Topology *top_ref) override;
   void EndEvaluate() override;
@@ -71,7 +77,11 @@ void CsgStatApp::HelpText(ostream &out) {
          "program\n"
          "is called inside the inverse scripts. Unlike csg_boltzmann, big "
          "systems\n"
-         "can be treated as well as non-bonded interactions can be evaluated.";
+         "can be treated as well as non-bonded interactions can be evaluated.\n"
+         "Long trajectories can be split into frame ranges (--first-frame, "
+         "--nframes)\n"
+         "which are processed with --write-state and combined with --merge "
+         "afterwards.";
 }
 
 void CsgStatApp::Initialize() {
@@ -86,13 +96,20 @@ void CsgStatApp::Initialize() {
       "write")("ext",
                boost::program_options::value<string>(&extension_)
                    ->default_value("dist.new"),
-               "Extension of the output");
+               "Extension of the output")(
+      "write-state", boost::program_options::value<string>(),
+      "  write the accumulated state to this file instead of the "
+      "distributions")("merge", boost::program_options::value<string>(),
+                       "  merge states written with --write-state, given "
+                       "as comma separated list in frame order");
 }
 
 bool CsgStatApp::EvaluateOptions() {
   CsgApplication::EvaluateOptions();
   CheckRequired("options");
-  CheckRequired("trj", "no trajectory file specified");
+  if (OptionsMap().count("merge") == 0) {
+    CheckRequired("trj", "no trajectory file specified");
+  }
 
   imc_.LoadOptions(OptionsMap()["options"].as<string>());
 
@@ -112,10 +129,28 @@ bool CsgStatApp::EvaluateOptions() {
 
   imc_.Extension(extension_);
 
+  if (OptionsMap().count("write-state")) {
+    imc_.StateFile(OptionsMap()["write-state"].as<string>());
+  }
+  if ((OptionsMap().count("write-state") || OptionsMap().count("merge")) &&
+      OptionsMap().count("block-length")) {
+    throw std::runtime_error(
+        "--block-length can not be combined with --write-state or --merge");
+  }
+
   imc_.Initialize();
   return true;
 }
 
+void CsgStatApp::Run() {
+  if (OptionsMap().count("merge") == 0) {
+    CsgApplication::Run();
+    return;
+  }
+  votca::tools::Tokenizer tok(OptionsMap()["merge"].as<string>(), ",");
+  imc_.MergeStates(tok.ToVector());
+}
+
 void CsgStatApp::BeginEvaluate(Topology *top, Topology *top_ref) {
   imc_.BeginEvaluate(top, top_ref);
 }
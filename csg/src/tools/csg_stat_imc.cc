@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,6 +19,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -84,6 +85,7 @@ void Imc::BeginEvaluate(Topology *top, Topology *) {
   // we didn't process any frames so far
   nframes_ = 0;
   nblock_ = 0;
+  volumes_.clear();
   processed_some_frames_ = false;
 
   // initialize non-bonded structures
@@ -171,8 +173,7 @@ void Imc::BeginEvaluate(Topology *top, Topology *) {
 
   for (tools::Property *prop : bonded_) {
     string name = prop->get("name").value();
-    std::vector<Interaction *> vec = top->InteractionsInGroup(name);
-    if (vec.empty()) {
+    if (top->InteractionsInGroup(name).empty()) {
       throw std::runtime_error(
           "Bonded interaction '" + name +
           "' defined in options xml-file, but not in topology - check name "
@@ -227,8 +228,10 @@ Imc::interaction_t *Imc::AddInteraction(tools::Property *p, bool is_bonded) {
       static_cast<votca::Index>((i->max_ - i->min_) / i->step_ + 1.000000001);
 
   i->average_.Initialize(i->min_, i->max_, n);
+  i->sum_ = Eigen::VectorXd::Zero(n);
   if (i->force_) {
     i->average_force_.Initialize(i->min_, i->max_, n);
+    i->sum_force_ = Eigen::VectorXd::Zero(n);
   }
 
   return i;
@@ -237,7 +240,10 @@ Imc::interaction_t *Imc::AddInteraction(tools::Property *p, bool is_bonded) {
 // end of trajectory, post processing data
 void Imc::EndEvaluate() {
   if (nframes_ > 0) {
-    if (block_length_ == 0) {
+    if (!state_file_.empty()) {
+      WriteState(state_file_);
+    } else if (block_length_ == 0) {
+      UpdateAverages();
       string suffix = string(".") + extension_;
       WriteDist(suffix);
       if (do_imc_) {
@@ -266,9 +272,17 @@ void Imc::Worker::EvalConfiguration(Topology *top, Topology *) {
 
   cur_vol_ = top->BoxVolume();
   // process non-bonded interactions
-  DoNonbonded(top);
+  {
+    CsgProfiler::ScopedTimer timer(app_->Profiler(), "evaluate/nonbonded",
+                                   getId());
+    DoNonbonded(top);
+  }
   // process bonded interactions
-  DoBonded(top);
+  {
+    CsgProfiler::ScopedTimer timer(app_->Profiler(), "evaluate/bonded",
+                                   getId());
+    DoBonded(top);
+  }
 }
 
 void Imc::ClearAverages() {
@@ -276,8 +290,10 @@ void Imc::ClearAverages() {
 
   for (auto &inter : interactions_) {
     inter.second->average_.Clear();
+    inter.second->sum_.setZero();
     if (inter.second->force_) {
       inter.second->average_force_.Clear();
+      inter.second->sum_force_.setZero();
     }
   }
   for (auto &group : groups_) {
@@ -291,9 +307,11 @@ class IMCNBSearchHandler {
       : hist_(*hist) {}
 
   votca::tools::HistogramNew &hist_;
+  votca::Index npairs_ = 0;
 
   bool FoundPair(Bead *, Bead *, const Eigen::Vector3d &, const double dist) {
     hist_.Process(dist);
+    npairs_++;
     return false;
   }
 };
@@ -404,6 +422,7 @@ void Imc::Worker::DoNonbonded(Topology *top) {
         } else {
           nb->Generate(beads1, beads2, !(imc_->include_intra_));
         }
+        app_->Profiler().AddCount("pairs", h.npairs_);
       }
 
       // if one wants to calculate the mean force
@@ -443,7 +462,7 @@ void Imc::Worker::DoNonbonded(Topology *top) {
 // process non-bonded interactions for current frame
 void Imc::Worker::DoBonded(Topology *top) {
   for (tools::Property *prop : imc_->bonded_) {
-    string name = prop->get("name").value();
+    const string &name = prop->get("name").value();
 
     interaction_t &i = *imc_->interactions_[name];
 
@@ -451,8 +470,8 @@ void Imc::Worker::DoBonded(Topology *top) {
     current_hists_[i.index_].Clear();
 
     // now fill with new data
-    for (Interaction *ic : top->InteractionsInGroup(name)) {
-      double v = ic->EvaluateVar(*top);
+    top->BondedInteractionTable(name).EvaluateVar(*top, bonded_values_);
+    for (double v : bonded_values_) {
       current_hists_[i.index_].Process(v);
     }
   }
@@ -532,8 +551,19 @@ void Imc::DoCorrelations(Imc::Worker *worker) {
       Eigen::VectorXd &b = worker->current_hists_[pair.i2_->index_].data().y();
       pair_matrix &M = pair.corr_;
 
-      M = ((((double)nframes_ - 1.0) * M) + a * b.transpose()) /
-          (double)nframes_;
+      M += a * b.transpose();
+    }
+  }
+}
+
+// the histograms hold counts, so their sums are exact and do not depend on
+// how the frames were split between workers or processes
+void Imc::UpdateAverages() {
+  for (auto &inter : interactions_) {
+    auto &i = inter.second;
+    i->average_.data().y() = i->sum_ / (double)nframes_;
+    if (i->force_) {
+      i->average_force_.data().y() = i->sum_force_ / (double)nframes_;
     }
   }
 }
@@ -642,7 +672,7 @@ void Imc::WriteIMCData(const string &suffix) {
 
     // build full set of equations + copy some data to make
     // code better to read
-    group_matrix gmc(grp->corr_);
+    group_matrix gmc = grp->corr_ / (double)nframes_;
     tools::Table dS;
     dS.resize(n);
     // the next two variables are to later extract the individual parts
@@ -757,7 +787,7 @@ void Imc::WriteIMCBlock(const string &suffix) {
     votca::Index n = grp->corr_.rows();
 
     // build full set of equations + copy some data to make code better to read
-    group_matrix gmc(grp->corr_);
+    group_matrix gmc = grp->corr_ / (double)nframes_;
     Eigen::VectorXd dS(n);
     Eigen::VectorXd r(n);
     // the next two variables are to later extract the individual parts
@@ -815,9 +845,9 @@ void Imc::WriteIMCBlock(const string &suffix) {
       throw runtime_error(string("error, cannot open file ") + name_cor);
     }
 
-    for (votca::Index i = 0; i < grp->corr_.rows(); ++i) {
-      for (votca::Index j = 0; j < grp->corr_.cols(); ++j) {
-        out_cor << grp->corr_(i, j) << " ";
+    for (votca::Index i = 0; i < gmc.rows(); ++i) {
+      for (votca::Index j = 0; j < gmc.cols(); ++j) {
+        out_cor << gmc(i, j) << " ";
       }
       out_cor << endl;
     }
@@ -856,18 +886,13 @@ void Imc::MergeWorker(CsgApplication::Worker *worker_) {
 
   ++nframes_;
   avg_vol_.Process(worker->cur_vol_);
+  volumes_.push_back(worker->cur_vol_);
   for (auto &interaction : interactions_) {
     auto &i = interaction.second;
-    i->average_.data().y() =
-        (((double)nframes_ - 1.0) * i->average_.data().y() +
-         worker->current_hists_[i->index_].data().y()) /
-        (double)nframes_;
+    i->sum_ += worker->current_hists_[i->index_].data().y();
     // preliminary
     if (i->force_) {
-      i->average_force_.data().y() =
-          (((double)nframes_ - 1.0) * i->average_force_.data().y() +
-           worker->current_hists_force_[i->index_].data().y()) /
-          (double)nframes_;
+      i->sum_force_ += worker->current_hists_force_[i->index_].data().y();
     }
   }
 
@@ -881,6 +906,7 @@ void Imc::MergeWorker(CsgApplication::Worker *worker_) {
       nblock_++;
       string suffix = string("_") + boost::lexical_cast<string>(nblock_) +
                       string(".") + extension_;
+      UpdateAverages();
       WriteDist(suffix);
       WriteIMCData(suffix);
       WriteIMCBlock(suffix);
@@ -889,5 +915,164 @@ void Imc::MergeWorker(CsgApplication::Worker *worker_) {
   }
 }
 
+// the state is written as text with enough digits to restore every double
+// exactly, so merged runs give the same output as a single run
+void Imc::WriteState(const string &file) const {
+  ofstream out(file);
+  if (!out) {
+    throw runtime_error(string("error, cannot open file ") + file);
+  }
+  out << setprecision(std::numeric_limits<double>::max_digits10);
+  out << "csg_stat_state 1\n";
+  out << "nframes " << nframes_ << "\n";
+  out << "volumes " << volumes_.size() << "\n";
+  for (double volume : volumes_) {
+    out << volume << "\n";
+  }
+  out << "interactions " << interactions_.size() << "\n";
+  for (const auto &interaction : interactions_) {
+    const interaction_t &i = *interaction.second;
+    out << "interaction " << interaction.first << " " << i.sum_.size() << " "
+        << i.norm_ << " " << i.force_ << "\n";
+    for (Index k = 0; k < i.sum_.size(); ++k) {
+      out << i.sum_[k] << "\n";
+    }
+    for (Index k = 0; k < i.sum_force_.size(); ++k) {
+      out << i.sum_force_[k] << "\n";
+    }
+  }
+  out << "groups " << groups_.size() << "\n";
+  for (const auto &group : groups_) {
+    const group_matrix &corr = group.second->corr_;
+    out << "group " << group.first << " " << corr.rows() << "\n";
+    for (Index row = 0; row < corr.rows(); ++row) {
+      for (Index col = 0; col < corr.cols(); ++col) {
+        out << corr(row, col) << " ";
+      }
+      out << "\n";
+    }
+  }
+  cout << "written " << file << endl;
+}
+
+void Imc::ReadState(const string &file) {
+  ifstream in(file);
+  if (!in) {
+    throw runtime_error(string("error, cannot open file ") + file);
+  }
+  auto expect = [&in, &file](const string &keyword) {
+    string word;
+    in >> word;
+    if (word != keyword) {
+      throw runtime_error("error reading state " + file + ": expected '" +
+                          keyword + "' but got '" + word + "'");
+    }
+  };
+
+  expect("csg_stat_state");
+  Index version = 0;
+  in >> version;
+  if (version != 1) {
+    throw runtime_error("unsupported state version in " + file);
+  }
+  expect("nframes");
+  Index nframes = 0;
+  in >> nframes;
+  nframes_ += nframes;
+
+  expect("volumes");
+  size_t nvolumes = 0;
+  in >> nvolumes;
+  for (size_t k = 0; k < nvolumes; ++k) {
+    double volume;
+    in >> volume;
+    volumes_.push_back(volume);
+    avg_vol_.Process(volume);
+  }
+
+  expect("interactions");
+  size_t ninteractions = 0;
+  in >> ninteractions;
+  if (ninteractions != interactions_.size()) {
+    throw runtime_error("state " + file +
+                        " was written with different interactions");
+  }
+  for (size_t n = 0; n < ninteractions; ++n) {
+    expect("interaction");
+    string name;
+    Index nbins = 0;
+    bool force = false;
+    double norm = 0;
+    in >> name >> nbins >> norm >> force;
+    auto iter = interactions_.find(name);
+    if (iter == interactions_.end() || iter->second->sum_.size() != nbins ||
+        iter->second->force_ != force) {
+      throw runtime_error("interaction " + name + " in state " + file +
+                          " does not match the options file");
+    }
+    interaction_t &i = *iter->second;
+    // the normalization depends on the topology, which is not read when
+    // merging
+    i.norm_ = norm;
+    for (Index k = 0; k < nbins; ++k) {
+      double value;
+      in >> value;
+      i.sum_[k] += value;
+    }
+    for (Index k = 0; k < i.sum_force_.size(); ++k) {
+      double value;
+      in >> value;
+      i.sum_force_[k] += value;
+    }
+  }
+
+  expect("groups");
+  size_t ngroups = 0;
+  in >> ngroups;
+  if (ngroups != groups_.size()) {
+    throw runtime_error("state " + file + " was written with different groups");
+  }
+  for (size_t n = 0; n < ngroups; ++n) {
+    expect("group");
+    string name;
+    Index size = 0;
+    in >> name >> size;
+    auto iter = groups_.find(name);
+    if (iter == groups_.end() || iter->second->corr_.rows() != size) {
+      throw runtime_error("group " + name + " in state " + file +
+                          " does not match the options file");
+    }
+    group_matrix &corr = iter->second->corr_;
+    for (Index row = 0; row < size; ++row) {
+      for (Index col = 0; col < size; ++col) {
+        double value;
+        in >> value;
+        corr(row, col) += value;
+      }
+    }
+  }
+  if (!in) {
+    throw runtime_error("error reading state " + file);
+  }
+  if (nframes > 0) {
+    processed_some_frames_ = true;
+  }
+}
+
+// the states have to be given in the order of their frames, so the volumes
+// are averaged in the same order as in a single run
+void Imc::MergeStates(const vector<string> &files) {
+  nframes_ = 0;
+  nblock_ = 0;
+  volumes_.clear();
+  avg_vol_.Clear();
+  processed_some_frames_ = false;
+  for (const string &file : files) {
+    ReadState(file);
+    cout << "read " << file << endl;
+  }
+  EndEvaluate();
+}
+
 }  // namespace csg
 }  // namespace votca
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -53,6 +53,15 @@ class Imc {
   void DoImc(bool do_imc) { do_imc_ = do_imc; }
   void IncludeIntra(bool include_intra) { include_intra_ = include_intra; }
   void Extension(std::string ext) { extension_ = ext; }
+  /// write the accumulated state to this file instead of the distributions
+  void StateFile(std::string file) { state_file_ = file; }
+
+  /// write the complete accumulated state, which can be merged later
+  void WriteState(const std::string &file) const;
+  /// add the state of a partial run to the current one
+  void ReadState(const std::string &file);
+  /// combine the states of partial runs and write the distributions
+  void MergeStates(const std::vector<std::string> &files);
 
  protected:
   tools::Average<double> avg_vol_;
@@ -66,6 +75,9 @@ class Imc {
     tools::Property *p_;
     tools::HistogramNew average_;
     tools::HistogramNew average_force_;
+    // sum of the histograms of all frames, averages are calculated from it
+    Eigen::VectorXd sum_;
+    Eigen::VectorXd sum_force_;
     double min_, max_, step_;
     double norm_;
     double cut_;
@@ -87,6 +99,7 @@ class Imc {
   /// struct to store collected information for groups (e.g. crosscorrelations)
   struct group_t {
     std::vector<interaction_t *> interactions_;
+    // sum of the correlations of all frames
     group_matrix corr_;
     std::vector<pair_t> pairs_;
   };
@@ -102,10 +115,14 @@ class Imc {
 
   // file extension for the distributions
   std::string extension_;
+  // file to write the accumulated state to
+  std::string state_file_;
 
   // number of frames we processed
   votca::Index nframes_;
   votca::Index nblock_;
+  // box volume of every processed frame
+  std::vector<double> volumes_;
 
   /// list of bonded interactions
   std::vector<tools::Property *> bonded_;
@@ -126,6 +143,8 @@ class Imc {
   /// initializes the group structs after interactions were added
   void InitializeGroups();
 
+  /// calculate the average histograms from the sums
+  void UpdateAverages();
   void WriteDist(const std::string &suffix = "");
   void WriteIMCData(const std::string &suffix = "");
   void WriteIMCBlock(const std::string &suffix);
@@ -141,6 +160,8 @@ class Imc {
     std::vector<tools::HistogramNew> current_hists_force_;
     Imc *imc_;
     double cur_vol_;
+    /// buffer for the values of a bonded interaction group
+    Eigen::VectorXd bonded_values_;
 
     /// evaluate current conformation
     void EvalConfiguration(Topology *top, Topology *top_atom) override;
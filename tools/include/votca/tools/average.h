@@ -28,6 +28,8 @@ template <typename T>
 class Average {
  public:
   void Process(const T &value);
+  /// \brief combine with the samples processed by another average
+  void Merge(const Average<T> &other);
   void Clear();
   template <typename iterator_type>
   void ProcessRange(const iterator_type &begin, const iterator_type &end);
@@ -51,6 +53,17 @@ inline void Average<T>::Process(const T &value) {
   m2_ += value * value;
 }
 
+template <typename T>
+inline void Average<T>::Merge(const Average<T> &other) {
+  if (other.n_ == 0) {
+    return;
+  }
+  av_ = av_ * (double)n_ / (double)(n_ + other.n_) +
+        other.av_ * (double)other.n_ / (double)(n_ + other.n_);
+  n_ += other.n_;
+  m2_ += other.m2_;
+}
+
 template <typename T>
 inline void Average<T>::Clear() {
   av_ = 0;
@@ -0,0 +1,118 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_COMPRESSEDGRAPH_H
+#define VOTCA_TOOLS_COMPRESSEDGRAPH_H
+
+// Standard includes
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Local VOTCA includes
+#include "edge.h"
+#include "graphnode.h"
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief Immutable graph stored in compressed sparse row (CSR) format
+ *
+ * The vertices are relabeled to dense local indices 0..VertexCount()-1 and
+ * the neighbours of all vertices are stored in one contiguous array. The
+ * contents of each graph node are encoded as a 64 bit integer label derived
+ * from the string id of the node, so nodes with the same contents have the
+ * same label.
+ *
+ * The class is meant for read-only algorithms on large graphs, e.g. finding
+ * connected components or bucketing structures by a canonical hash, where
+ * the hash map based Graph is slow.
+ */
+class CompressedGraph {
+ public:
+  CompressedGraph() = default;
+
+  /// Constructor, arguments have the same meaning as for the Graph class,
+  /// every vertex appearing in an edge must have a node
+  CompressedGraph(const std::vector<Edge>& edges,
+                  const std::unordered_map<Index, GraphNode>& nodes);
+
+  /// Number of vertices
+  Index VertexCount() const { return Index(vertices_.size()); }
+  /// Number of edges, loops and multiple edges are counted individually
+  Index EdgeCount() const { return edge_count_; }
+
+  /// Original vertex id of the local index
+  Index getVertex(Index local) const { return vertices_[local]; }
+  /// Local index of the original vertex id
+  Index getLocalIndex(Index vertex) const { return local_index_.at(vertex); }
+
+  /// Number of edge ends attached to the vertex, a loop counts twice
+  Index getDegree(Index local) const {
+    return offsets_[local + 1] - offsets_[local];
+  }
+  /// Local indices of the neighbours of a vertex
+  const Index* NeighBegin(Index local) const {
+    return neighbors_.data() + offsets_[local];
+  }
+  const Index* NeighEnd(Index local) const {
+    return neighbors_.data() + offsets_[local + 1];
+  }
+
+  /// Integer encoded contents of the node of a vertex
+  std::uint64_t getLabel(Index local) const { return labels_[local]; }
+
+  /**
+   * \brief Label vertices by connected component
+   *
+   * Components are numbered in order of their lowest local index.
+   * @return component id of every local vertex index
+   */
+  std::vector<Index> ConnectedComponents() const;
+
+  /**
+   * \brief Hash of the graph which does not depend on the vertex numbering
+   *
+   * Uses Weisfeiler-Lehman colour refinement on the node labels until the
+   * partition of the vertices is stable. Isomorphic graphs with equal node
+   * contents always have the same hash, so different hashes prove that two
+   * graphs are not equivalent. Equal hashes are a strong but not a certain
+   * indication of equivalence.
+   */
+  std::uint64_t CanonicalHash() const;
+
+  /// Encode the contents of a graph node as an integer label
+  static std::uint64_t EncodeNode(const GraphNode& node);
+
+ private:
+  std::vector<Index> vertices_;
+  std::unordered_map<Index, Index> local_index_;
+  std::vector<Index> offsets_;
+  std::vector<Index> neighbors_;
+  std::vector<std::uint64_t> labels_;
+  Index edge_count_ = 0;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_COMPRESSEDGRAPH_H
@@ -19,6 +19,7 @@
 #define VOTCA_TOOLS_CUBICSPLINE_H
 
 // Standard includes
+#include <cassert>
 #include <iostream>
 
 // Local VOTCA includes
@@ -74,8 +75,11 @@ class CubicSpline : public Spline {
   // Calculate the function derivative
   double CalculateDerivative(double r) override;
 
-  using Spline::Calculate;
-  using Spline::CalculateDerivative;
+  // Calculate the function values of a batch of points
+  Eigen::VectorXd Calculate(const Eigen::VectorXd &x) override;
+
+  // Calculate the function derivatives of a batch of points
+  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x) override;
 
   // set spline parameters to values that were externally computed
   void setSplineData(const Eigen::VectorXd &f, const Eigen::VectorXd &f2) {
@@ -83,6 +87,8 @@ class CubicSpline : public Spline {
     f2_ = f2;
   }
 
+  using IndexMatrix = Eigen::Matrix<Index, Eigen::Dynamic, Eigen::Dynamic>;
+
   /**
    * \brief Add a point (one entry) to fitting matrix
    * \param M pointer to matrix
@@ -124,6 +130,37 @@ class CubicSpline : public Spline {
   void AddToFitMatrix(matrix_type &M, vector_type &x, Index offset1,
                       Index offset2 = 0);
 
+  /**
+   * \brief Add a batch of points to fitting matrix
+   * \param M pointer to matrix [in] [out]
+   * \param x values of the points [in]
+   * \param rows rows of M to add point k to, column k belongs to x(k) [in]
+   * \param offset2 relative to getInterval(x) [in]
+   * \param scale parameters for terms "A,B,C,D", same shape as rows [in]
+   * Same as adding every point with the scalar version, but the interval and
+   * the terms are only evaluated once per point.
+   */
+  template <typename matrix_type>
+  void AddToFitMatrix(matrix_type &M, const Eigen::VectorXd &x,
+                      const IndexMatrix &rows, Index offset2,
+                      const Eigen::MatrixXd &scale);
+
+  /**
+   * \brief Add a batch of points to fitting matrix
+   * \param M pointer to matrix [in] [out]
+   * \param x values of the points [in]
+   * \param rows rows of M to add point k to, column k belongs to x(k) [in]
+   * \param offset2 relative to getInterval(x) [in]
+   * \param scale1 parameters for terms "A,B,C,D" [in]
+   * \param scale2 parameters for terms "AA,BB,CC,DD" [in]
+   * Batch version of the function with two scales.
+   */
+  template <typename matrix_type>
+  void AddToFitMatrix(matrix_type &M, const Eigen::VectorXd &x,
+                      const IndexMatrix &rows, Index offset2,
+                      const Eigen::MatrixXd &scale1,
+                      const Eigen::MatrixXd &scale2);
+
   /**
    * \brief Add boundary condition of sum_i f_i =0 to fitting matrix
    * \param M pointer to matrix
@@ -151,15 +188,15 @@ class CubicSpline : public Spline {
   // A spline can be written in the form
   // S_i(x) =   A(x,x_i,x_i+1)*f_i     + B(x,x_i,x_i+1)*f'' i_
   //          + C(x,x_i,x_i+1)*f_{i+1} + D(x,x_i,x_i+1)*f''_{i+1}
-  double A(double r);
-  double B(double r);
-  double C(double r);
-  double D(double r);
+  // Terms returns (A,B,C,D) and TermsPrime their derivatives for a point in
+  // the given interval
+  Eigen::Vector4d Terms(double r, Index interval) const;
+  Eigen::Vector4d TermsPrime(double r, Index interval) const;
 
-  double Aprime(double r);
-  double Bprime(double r);
-  double Cprime(double r);
-  double Dprime(double r);
+  // adds the terms (A,B,C,D) of the interval to column offset2 + interval
+  template <typename matrix_type>
+  void AddTerms(matrix_type &M, Index row, Index offset2, Index interval,
+                const Eigen::Vector4d &terms) const;
 
   // tabulated derivatives at grid points. Second argument: 0 - left, 1 - right
   double A_prime_l(Index i);
@@ -172,14 +209,21 @@ class CubicSpline : public Spline {
   double D_prime_r(Index i);
 };
 
+template <typename matrix_type>
+inline void CubicSpline::AddTerms(matrix_type &M, Index row, Index offset2,
+                                  Index interval,
+                                  const Eigen::Vector4d &terms) const {
+  M(row, offset2 + interval) += terms[0];
+  M(row, offset2 + interval + 1) += terms[1];
+  M(row, offset2 + interval + r_.size()) += terms[2];
+  M(row, offset2 + interval + r_.size() + 1) += terms[3];
+}
+
 template <typename matrix_type>
 inline void CubicSpline::AddToFitMatrix(matrix_type &M, double x, Index offset1,
                                         Index offset2, double scale) {
   Index spi = getInterval(x);
-  M(offset1, offset2 + spi) += A(x) * scale;
-  M(offset1, offset2 + spi + 1) += B(x) * scale;
-  M(offset1, offset2 + spi + r_.size()) += C(x) * scale;
-  M(offset1, offset2 + spi + r_.size() + 1) += D(x) * scale;
+  AddTerms(M, offset1, offset2, spi, Terms(x, spi) * scale);
 }
 
 // for adding f'(x)*scale1 + f(x)*scale2 as needed for threebody interactions
@@ -188,12 +232,8 @@ inline void CubicSpline::AddToFitMatrix(matrix_type &M, double x, Index offset1,
                                         Index offset2, double scale1,
                                         double scale2) {
   Index spi = getInterval(x);
-  M(offset1, offset2 + spi) += Aprime(x) * scale1;
-  M(offset1, offset2 + spi + 1) += Bprime(x) * scale1;
-  M(offset1, offset2 + spi + r_.size()) += Cprime(x) * scale1;
-  M(offset1, offset2 + spi + r_.size() + 1) += Dprime(x) * scale1;
-
-  AddToFitMatrix(M, x, offset1, offset2, scale2);
+  AddTerms(M, offset1, offset2, spi,
+           TermsPrime(x, spi) * scale1 + Terms(x, spi) * scale2);
 }
 
 template <typename matrix_type, typename vector_type>
@@ -201,10 +241,48 @@ inline void CubicSpline::AddToFitMatrix(matrix_type &M, vector_type &x,
                                         Index offset1, Index offset2) {
   for (Index i = 0; i < x.size(); ++i) {
     Index spi = getInterval(x(i));
-    M(offset1 + i, offset2 + spi) = A(x(i));
-    M(offset1 + i, offset2 + spi + 1) = B(x(i));
-    M(offset1 + i, offset2 + spi + r_.size()) = C(x(i));
-    M(offset1 + i, offset2 + spi + r_.size() + 1) = D(x(i));
+    Eigen::Vector4d terms = Terms(x(i), spi);
+    M(offset1 + i, offset2 + spi) = terms[0];
+    M(offset1 + i, offset2 + spi + 1) = terms[1];
+    M(offset1 + i, offset2 + spi + r_.size()) = terms[2];
+    M(offset1 + i, offset2 + spi + r_.size() + 1) = terms[3];
+  }
+}
+
+template <typename matrix_type>
+inline void CubicSpline::AddToFitMatrix(matrix_type &M,
+                                        const Eigen::VectorXd &x,
+                                        const IndexMatrix &rows, Index offset2,
+                                        const Eigen::MatrixXd &scale) {
+  assert(rows.cols() == x.size() && "every point needs a column of rows");
+  assert(scale.rows() == rows.rows() && scale.cols() == rows.cols() &&
+         "scale and rows must have the same shape");
+  for (Index k = 0; k < x.size(); ++k) {
+    Index spi = getInterval(x(k));
+    Eigen::Vector4d terms = Terms(x(k), spi);
+    for (Index j = 0; j < rows.rows(); ++j) {
+      AddTerms(M, rows(j, k), offset2, spi, terms * scale(j, k));
+    }
+  }
+}
+
+template <typename matrix_type>
+inline void CubicSpline::AddToFitMatrix(
+    matrix_type &M, const Eigen::VectorXd &x, const IndexMatrix &rows,
+    Index offset2, const Eigen::MatrixXd &scale1,
+    const Eigen::MatrixXd &scale2) {
+  assert(rows.cols() == x.size() && "every point needs a column of rows");
+  assert(scale1.rows() == rows.rows() && scale1.cols() == rows.cols() &&
+         scale2.rows() == rows.rows() && scale2.cols() == rows.cols() &&
+         "scales and rows must have the same shape");
+  for (Index k = 0; k < x.size(); ++k) {
+    Index spi = getInterval(x(k));
+    Eigen::Vector4d terms = Terms(x(k), spi);
+    Eigen::Vector4d terms_prime = TermsPrime(x(k), spi);
+    for (Index j = 0; j < rows.rows(); ++j) {
+      AddTerms(M, rows(j, k), offset2, spi,
+               terms_prime * scale1(j, k) + terms * scale2(j, k));
+    }
   }
 }
 
@@ -21,12 +21,14 @@
 #define VOTCA_TOOLS_GRAPH_H
 
 // Standard includes
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 // Local VOTCA includes
+#include "compressedgraph.h"
 #include "edgecontainer.h"
 #include "graphnode.h"
 
@@ -99,6 +101,20 @@ class Graph {
   /// Returns the id of graph
   std::string getId() const { return id_; }
 
+  /// Returns a read-only copy of the graph in compressed sparse row format.
+  /// The copy is rebuilt in O(V+E) on every call, keep the result when it is
+  /// needed more than once, the graph itself does not cache it.
+  CompressedGraph getCompressedGraph() const {
+    return CompressedGraph(edge_container_.getEdges(), nodes_);
+  }
+
+  /// Returns a hash that does not depend on the vertex numbering, graphs with
+  /// different hashes are not equivalent, see CompressedGraph::CanonicalHash.
+  /// Builds the compressed graph on every call.
+  std::uint64_t getCanonicalHash() const {
+    return getCompressedGraph().CanonicalHash();
+  }
+
   /// Returns all the edges in the graph
   virtual std::vector<Edge> getEdges() { return edge_container_.getEdges(); }
 
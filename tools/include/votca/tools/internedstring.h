@@ -0,0 +1,116 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_INTERNEDSTRING_H
+#define VOTCA_TOOLS_INTERNEDSTRING_H
+
+// Standard includes
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Local VOTCA includes
+#include "tokenizer.h"
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief handle of a string which is stored once in a global table
+ *
+ * Equal strings share one entry of the table, so an InternedString is as
+ * small as a pointer and an id, copies do not allocate and comparisons
+ * compare integers. The ids are dense and start with 0 for the empty string,
+ * they can be used to index lookup tables. Entries are never removed and the
+ * table can be used from several threads.
+ *
+ * The ordering of InternedStrings follows the ids, i.e. the order in which
+ * the strings were interned, not the alphabetical order.
+ */
+class InternedString {
+ public:
+  /// the empty string
+  InternedString();
+  InternedString(std::string_view str);
+  InternedString(const std::string &str)
+      : InternedString(std::string_view(str)) {}
+  InternedString(const char *str) : InternedString(std::string_view(str)) {}
+
+  const std::string &str() const noexcept { return *str_; }
+  Index getId() const noexcept { return id_; }
+  bool empty() const noexcept { return str_->empty(); }
+
+  /// id of str if it was interned before, otherwise -1, str is not added
+  static Index Find(std::string_view str);
+  /// number of strings in the table
+  static Index Count();
+
+  friend bool operator==(const InternedString &a, const InternedString &b) {
+    return a.id_ == b.id_;
+  }
+  friend bool operator!=(const InternedString &a, const InternedString &b) {
+    return a.id_ != b.id_;
+  }
+  friend bool operator<(const InternedString &a, const InternedString &b) {
+    return a.id_ < b.id_;
+  }
+  friend std::ostream &operator<<(std::ostream &out,
+                                  const InternedString &str) {
+    return out << str.str();
+  }
+
+ private:
+  const std::string *str_;
+  Index id_;
+};
+
+/**
+ * \brief matches interned strings against a wildcard pattern
+ *
+ * wildcmp is evaluated once per distinct string, further calls with the same
+ * string are a table lookup. Used to filter beads by name or type, where
+ * many beads share few names.
+ */
+class InternedWildcard {
+ public:
+  explicit InternedWildcard(std::string pattern)
+      : pattern_(std::move(pattern)) {}
+
+  bool operator()(const InternedString &str) {
+    Index id = str.getId();
+    if (id >= Index(matches_.size())) {
+      matches_.resize(id + 1, -1);
+    }
+    if (matches_[id] < 0) {
+      matches_[id] = wildcmp(pattern_, str.str()) ? 1 : 0;
+    }
+    return matches_[id] == 1;
+  }
+
+ private:
+  std::string pattern_;
+  // -1 not evaluated yet, 0 no match, 1 match
+  std::vector<signed char> matches_;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_INTERNEDSTRING_H
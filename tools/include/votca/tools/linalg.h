@@ -39,6 +39,26 @@ Eigen::VectorXd linalg_constrained_qrsolve(const Eigen::MatrixXd& A,
                                            const Eigen::VectorXd& b,
                                            const Eigen::MatrixXd& constr);
 
+/**
+ * \brief solves A*x=b under the constraint B*x = 0 for sparse A and B
+ * @return x
+ * @param A matrix for linear equation system
+ * @param b inhomogenity
+ * @param constr constrained condition
+ *
+ * Solves the same least squares problem as linalg_constrained_qrsolve via
+ * the normal equations of the column scaled matrix with the constraints
+ *
+ *   [ A^T A  B^T ] [ x ]   [ A^T b ]
+ *   [ B      0   ] [ l ] = [ 0     ]
+ *
+ * and a sparse LU decomposition. For banded A and B, e.g. spline fits, the
+ * cost is linear in the number of rows and columns.
+ */
+Eigen::VectorXd linalg_constrained_sparse_solve(
+    const Eigen::SparseMatrix<double>& A, const Eigen::VectorXd& b,
+    const Eigen::SparseMatrix<double>& constr);
+
 }  // namespace tools
 }  // namespace votca
 
@@ -1,5 +1,5 @@
 /*
- *            Copyright 2009-2020 The VOTCA Development Team
+ *            Copyright 2009-2024 The VOTCA Development Team
  *                       (http://www.votca.org)
  *
  *      Licensed under the Apache License, Version 2.0 (the "License")
@@ -24,6 +24,9 @@
 #include <cassert>
 #include <string>
 
+// Local VOTCA includes
+#include "internedstring.h"
+
 namespace votca {
 namespace tools {
 
@@ -32,12 +35,13 @@ namespace tools {
  *
  * This object is meant to be used a derived type for larger objects. In this
  * way the same methods for setting and getting the name of an object will be
- * uniformly defined.
+ * uniformly defined. The name is interned, objects with the same name share
+ * one copy of the string.
  *
  */
 class Name {
  private:
-  std::string name_;
+  InternedString name_;
   bool name_set_{false};
 
  public:
@@ -48,6 +52,11 @@ class Name {
     name_set_ = true;
   }
   const std::string &getName() const {
+    assert(name_set_ && "No name has been set, cannot get name.");
+    return name_.str();
+  }
+  /// interned name, comparing these compares integers instead of strings
+  const InternedString &getInternedName() const {
     assert(name_set_ && "No name has been set, cannot get name.");
     return name_;
   }
@@ -21,11 +21,14 @@
 // Standard includes
 #include <cstdlib>
 #include <exception>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 // Third party includes
 #include <boost/algorithm/string/trim.hpp>
@@ -142,6 +145,8 @@ class Property {
    *
    * returns a list of properties that match the key criteria including
    * wildcard "*". Example: "base.item*.value"
+   * Levels without wildcards are looked up in the index of child names, so
+   * selecting e.g. "jobs.job" does not compare the names of all children.
    */
   std::vector<Property *> Select(const std::string &filter);
   std::vector<const Property *> Select(const std::string &filter) const;
@@ -265,10 +270,29 @@ class Property {
 
   void LoadFromXML(std::string filename);
 
+  /**
+   * \brief reads the elements matching filter one by one from an xml file
+   * @param filename xml file
+   * @param filter path of the elements from the root, e.g. "jobs.job", each
+   * level may contain the wildcards "*" and "?"
+   * @param callback called with every matching element in file order
+   *
+   * Only the subtree of the current element is kept in memory, everything
+   * outside of the matching elements is skipped. This allows to iterate over
+   * files with millions of repeated elements, e.g. job files, without building
+   * the whole tree. The property passed to the callback has the same name,
+   * path, value, attributes and children as the corresponding entry of
+   * Select(filter) after LoadFromXML and may be moved from.
+   */
+  static void StreamFromXML(const std::string &filename,
+                            const std::string &filter,
+                            const std::function<void(Property &)> &callback);
+
   static Index getIOindex() { return IOindex; };
 
  private:
-  std::map<std::string, std::vector<Index>> map_;
+  // transparent comparison allows lookups with string_view without copies
+  std::map<std::string, std::vector<Index>, std::less<>> map_;
   std::map<std::string, std::string> attributes_;
   std::vector<Property> properties_;
 
@@ -313,8 +337,12 @@ inline T Property::getAttribute(const std::string &attribute) const {
 template <typename T>
 inline void Property::setAttribute(const std::string &attribute,
                                    const T &value) {
-  attributes_[attribute] =
-      lexical_cast<std::string>(value, "wrong type to set attribute");
+  if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+    attributes_[attribute] = std::string(std::string_view(value));
+  } else {
+    attributes_[attribute] =
+        lexical_cast<std::string>(value, "wrong type to set attribute");
+  }
 }
 
 template <typename T>
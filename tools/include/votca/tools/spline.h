@@ -113,7 +113,7 @@ class Spline {
    * \param x vector of data values
    * \return vector of y value
    */
-  Eigen::VectorXd Calculate(const Eigen::VectorXd &x);
+  virtual Eigen::VectorXd Calculate(const Eigen::VectorXd &x);
 
   /**
    * \brief Calculate y values for given x values on the derivative of the
@@ -121,7 +121,7 @@ class Spline {
    * \param x vector of data values
    * \return vector of y value
    */
-  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x);
+  virtual Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x);
 
   /**
    * \brief Print spline values (using Calculate()) on output "out" on the
@@ -133,10 +133,13 @@ class Spline {
 
   /**
    * \brief Determine the index of the interval containing value r
+   *
+   * On uniform grids the interval is computed directly from the grid
+   * spacing, otherwise it is found by binary search.
    * \param r
    * \return interval index
    */
-  Index getInterval(double r);
+  Index getInterval(double r) const;
 
   /**
    * \brief Generate the grid for fitting from "min" to "max" in steps of "h"
@@ -149,6 +152,9 @@ class Spline {
 
   /**
    * \brief Get the grid array x
+   *
+   * The grid must only be changed via GenerateGrid, Interpolate or Fit,
+   * otherwise the interval lookup is out of date.
    * \return pointer to the corresponding array
    */
   Eigen::VectorXd &getX() { return r_; }
@@ -168,9 +174,15 @@ class Spline {
   // const Eigen::VectorXd &getSplineF2() const { return  f_; }
 
  protected:
+  /// \brief check if the grid is uniform, call after every change of r_
+  void UpdateGrid();
+
   eBoundary boundaries_ = eBoundary::splineNormal;
   // the grid points
   Eigen::VectorXd r_;
+  // grid spacing is constant, apart from possibly the last interval
+  bool uniform_grid_ = false;
+  double inv_step_ = 0.0;
 };
 
 }  // namespace tools
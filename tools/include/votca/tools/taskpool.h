@@ -0,0 +1,201 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_TASKPOOL_H
+#define VOTCA_TOOLS_TASKPOOL_H
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Local VOTCA includes
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief Work stealing pool of threads executing small tasks
+ *
+ * Every worker owns a queue. Tasks submitted from a worker go to its own
+ * queue and are taken from the back, idle workers steal from the front of the
+ * other queues. Threads waiting for tasks (TaskGroup::Wait, ParallelFor)
+ * execute pending tasks themselves, so parallel loops can be nested inside
+ * tasks without deadlocks and without starting more threads.
+ *
+ * Global() returns a pool shared by all of VOTCA, its size is the thread
+ * budget of the program and can be changed with setGlobalThreadCount.
+ */
+class TaskPool {
+ public:
+  explicit TaskPool(Index nthreads);
+  ~TaskPool();
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  Index ThreadCount() const { return Index(threads_.size()); }
+
+  /// pool shared by the whole program
+  static TaskPool &Global();
+  /**
+   * \brief sets the number of threads of the global pool
+   *
+   * The pool is recreated, so this must not be called while tasks of the
+   * global pool are running. Values smaller than 1 select the number of
+   * hardware threads.
+   */
+  static void setGlobalThreadCount(Index nthreads);
+  /// number of hardware threads, at least 1
+  static Index HardwareThreadCount();
+
+  /// run a task asynchronously, the future holds its result or exception
+  template <class F>
+  std::future<std::invoke_result_t<std::decay_t<F>>> Submit(F &&f);
+
+  /// run a task without tracking its result
+  void Push(std::function<void()> task);
+
+  /**
+   * \brief calls body(i) for all i in [begin, end) in parallel
+   *
+   * The range is split in chunks of grain indices, a grain of 0 picks a size
+   * giving a few chunks per thread. Returns after all calls finished and
+   * rethrows the first exception thrown by body.
+   */
+  template <class F>
+  void ParallelFor(Index begin, Index end, F &&body, Index grain = 0);
+
+  /// executes one pending task on the calling thread, false if there was none
+  bool RunPendingTask();
+
+ private:
+  struct queue_t {
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+  };
+
+  void WorkerLoop(Index id);
+  bool Pop(Index id, std::function<void()> &task);
+  /// worker index of the calling thread in this pool, -1 for other threads
+  Index CurrentWorker() const;
+
+  std::vector<std::unique_ptr<queue_t>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<Index> pending_{0};
+  std::atomic<Index> next_queue_{0};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+/**
+ * \brief set of tasks which can be waited for together
+ *
+ * The destructor waits for all tasks, exceptions of tasks are rethrown by
+ * Wait.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(TaskPool &pool = TaskPool::Global()) : pool_(pool) {}
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  template <class F>
+  void Run(F &&f);
+
+  /// waits for all tasks and executes pending tasks of the pool meanwhile
+  void Wait();
+
+ private:
+  void WaitAll();
+  void Finish();
+
+  TaskPool &pool_;
+  std::atomic<Index> pending_{0};
+  std::mutex done_mutex_;
+  std::condition_variable done_;
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+template <class F>
+inline std::future<std::invoke_result_t<std::decay_t<F>>> TaskPool::Submit(
+    F &&f) {
+  using result_t = std::invoke_result_t<std::decay_t<F>>;
+  // std::function needs a copyable callable, packaged_task is move only
+  auto task =
+      std::make_shared<std::packaged_task<result_t()>>(std::forward<F>(f));
+  std::future<result_t> result = task->get_future();
+  Push([task]() { (*task)(); });
+  return result;
+}
+
+template <class F>
+inline void TaskPool::ParallelFor(Index begin, Index end, F &&body,
+                                  Index grain) {
+  if (end <= begin) {
+    return;
+  }
+  if (grain <= 0) {
+    grain = std::max(Index(1), (end - begin) / (4 * (ThreadCount() + 1)));
+  }
+  TaskGroup group(*this);
+  for (Index start = begin; start < end; start += grain) {
+    Index stop = std::min(end, start + grain);
+    group.Run([start, stop, &body]() {
+      for (Index i = start; i < stop; ++i) {
+        body(i);
+      }
+    });
+  }
+  group.Wait();
+}
+
+template <class F>
+inline void TaskGroup::Run(F &&f) {
+  pending_++;
+  pool_.Push([this, f = std::forward<F>(f)]() mutable {
+    try {
+      f();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    Finish();
+  });
+}
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_TASKPOOL_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,8 +19,14 @@
 #define VOTCA_TOOLS_TOKENIZER_H
 
 // Standard includes
+#include <algorithm>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Third party includes
@@ -119,6 +125,94 @@ class Tokenizer {
   std::string str_;
 };
 
+/**
+ * \brief break string into words without copying them
+ *
+ * Splits like Tokenizer, every character of separators ends a word and empty
+ * words are dropped, but the words are std::string_view pointing into the
+ * original string, which has to outlive the tokenizer and its words. Numbers
+ * are converted with std::from_chars, so reading a line of numbers does not
+ * allocate, if ToVector is called with a vector which is reused.
+ */
+class ViewTokenizer {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view *;
+    using reference = const std::string_view &;
+
+    iterator() = default;
+    iterator(std::string_view str, std::string_view separators,
+             std::size_t pos)
+        : str_(str), separators_(separators) {
+      Find(pos);
+    }
+
+    reference operator*() const { return token_; }
+    pointer operator->() const { return &token_; }
+
+    iterator &operator++() {
+      Find(pos_ + token_.size());
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator old = *this;
+      ++(*this);
+      return old;
+    }
+
+    bool operator==(const iterator &other) const { return pos_ == other.pos_; }
+    bool operator!=(const iterator &other) const { return pos_ != other.pos_; }
+
+   private:
+    void Find(std::size_t pos) {
+      pos_ = str_.find_first_not_of(separators_, pos);
+      if (pos_ == std::string_view::npos) {
+        token_ = std::string_view();
+        return;
+      }
+      std::size_t end = str_.find_first_of(separators_, pos_);
+      token_ = str_.substr(pos_, end - pos_);
+    }
+
+    std::string_view str_;
+    std::string_view separators_;
+    std::string_view token_;
+    std::size_t pos_ = std::string_view::npos;
+  };
+
+  ViewTokenizer(std::string_view str, std::string_view separators)
+      : str_(str), separators_(separators) {}
+
+  iterator begin() const { return iterator(str_, separators_, 0); }
+  iterator end() const { return iterator(); }
+
+  /**
+   * \brief store all words in a vector of type T, does type conversion.
+   * @return storage vector
+   */
+  template <class T = std::string_view>
+  std::vector<T> ToVector() const {
+    std::vector<T> result;
+    ToVector(result);
+    return result;
+  }
+
+  /**
+   * \brief store all words in result, reusing its memory
+   * @param result vector which is cleared and filled
+   */
+  template <class T>
+  void ToVector(std::vector<T> &result) const;
+
+ private:
+  std::string_view str_;
+  std::string_view separators_;
+};
+
 // Matches a string against a wildcard string such as &quot;*.*&quot; or
 // &quot;bl?h.*&quot; etc. This is good for file globbing or to match hostmasks.
 int wildcmp(const char *wild, const char *string);
@@ -156,6 +250,88 @@ T convertFromString(const std::string &s) {
   return internal::convert_impl(s, internal::type<T>{});
 }
 
+namespace internal {
+
+template <typename T,
+          typename std::enable_if_t<std::is_arithmetic<T>::value &&
+                                        !std::is_same<T, bool>::value,
+                                    bool> = true>
+inline T convert_view_impl(std::string_view s, type<T>) {
+  const char *first = s.data();
+  const char *last = s.data() + s.size();
+  // from_chars does not accept a leading plus, lexical_cast does
+  if (first != last && *first == '+' && !std::is_unsigned<T>::value) {
+    ++first;
+  }
+  T value{};
+  std::from_chars_result result;
+#if !defined(__cpp_lib_to_chars)
+  // standard libraries without floating point from_chars
+  if constexpr (std::is_floating_point<T>::value) {
+    std::string copy(first, last);
+    char *end = nullptr;
+    value = T(std::strtod(copy.c_str(), &end));
+    result.ptr = first + (end - copy.c_str());
+    result.ec = (end == copy.c_str()) ? std::errc::invalid_argument
+                                      : std::errc();
+  } else {
+    result = std::from_chars(first, last, value);
+  }
+#else
+  result = std::from_chars(first, last, value);
+#endif
+  if (result.ec != std::errc() || result.ptr != last || first == last) {
+    throw std::runtime_error(
+        "invalid type: Cannot create arithmetic type from" + std::string(s));
+  }
+  return value;
+}
+
+inline bool convert_view_impl(std::string_view s, type<bool>) {
+  auto equal = [s](std::string_view word) {
+    return s.size() == word.size() &&
+           std::equal(s.begin(), s.end(), word.begin(), [](char a, char b) {
+             return std::tolower(static_cast<unsigned char>(a)) == b;
+           });
+  };
+  if (equal("true") || s == "1") {
+    return true;
+  } else if (equal("false") || s == "0") {
+    return false;
+  } else {
+    throw std::runtime_error("'" + std::string(s) +
+                             "' cannot be converted to bool.");
+  }
+}
+
+inline std::string_view convert_view_impl(std::string_view s,
+                                          type<std::string_view>) {
+  return s;
+}
+
+template <typename T,
+          typename std::enable_if_t<
+              std::is_constructible<T, std::string>::value, bool> = true>
+inline T convert_view_impl(std::string_view s, type<T>) {
+  return T(std::string(s));
+}
+
+}  // namespace internal
+
+/// convert a word to T without going through a stream
+template <class T>
+T convertFromStringView(std::string_view s) {
+  return internal::convert_view_impl(s, internal::type<T>{});
+}
+
+template <class T>
+inline void ViewTokenizer::ToVector(std::vector<T> &result) const {
+  result.clear();
+  for (std::string_view word : *this) {
+    result.push_back(convertFromStringView<T>(word));
+  }
+}
+
 }  // namespace tools
 }  // namespace votca
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_BENCHMARK_H
+#define VOTCA_TOOLS_BENCHMARK_H
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Local VOTCA includes
+#include "votca/tools/types.h"
+
+namespace votca {
+namespace tools {
+namespace benchmark {
+
+/*
+ * Helpers shared by the microbenchmarks of tools and csg. Every benchmark
+ * prints one json object per line and case, so results of different versions
+ * can be compared with compare_benchmarks.py.
+ */
+
+struct timing_t {
+  double best = 0.0;
+  double mean = 0.0;
+  Index repeats = 0;
+};
+
+/**
+ * \brief measures the wall time of f
+ *
+ * f is called at least once and repeated until min_seconds have passed or
+ * max_repeats calls were made. The fastest call is the least disturbed by
+ * other processes and is used as result.
+ */
+template <class F>
+inline timing_t Measure(F &&f, double min_seconds = 0.2,
+                        Index max_repeats = 50) {
+  timing_t timing;
+  timing.best = std::numeric_limits<double>::max();
+  double total = 0.0;
+  while (timing.repeats < max_repeats &&
+         (timing.repeats == 0 || total < min_seconds)) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    timing.best = std::min(timing.best, seconds);
+    total += seconds;
+    timing.repeats++;
+  }
+  timing.mean = total / double(timing.repeats);
+  return timing;
+}
+
+/**
+ * \brief discards everything written to std::cout during its lifetime
+ *
+ * Used around code which reports progress on std::cout, so the output of the
+ * benchmarks stays machine readable.
+ */
+class QuietStdout {
+ public:
+  QuietStdout() : old_(std::cout.rdbuf(nullptr)) {}
+  ~QuietStdout() { std::cout.rdbuf(old_); }
+
+  QuietStdout(const QuietStdout &) = delete;
+  QuietStdout &operator=(const QuietStdout &) = delete;
+
+ private:
+  std::streambuf *old_;
+};
+
+/// \brief one line of json output
+class Record {
+ public:
+  Record(const std::string &benchmark, const std::string &name) {
+    Add("benchmark", benchmark);
+    Add("case", name);
+  }
+
+  Record &Add(const std::string &key, const std::string &value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+      if (c == '"' || c == '\\') {
+        quoted += '\\';
+        quoted += c;
+      } else if (c == '\n') {
+        quoted += "\\n";
+      } else if (c != '\r') {
+        quoted += c;
+      }
+    }
+    entries_.emplace_back(key, quoted + "\"");
+    return *this;
+  }
+  Record &Add(const std::string &key, const char *value) {
+    return Add(key, std::string(value));
+  }
+  Record &Add(const std::string &key, Index value) {
+    entries_.emplace_back(key, std::to_string(value));
+    return *this;
+  }
+  Record &Add(const std::string &key, double value) {
+    // json has no inf or nan
+    if (!std::isfinite(value)) {
+      entries_.emplace_back(key, "null");
+      return *this;
+    }
+    std::ostringstream s;
+    s.precision(6);
+    s << value;
+    entries_.emplace_back(key, s.str());
+    return *this;
+  }
+
+  /// adds the timing and the number of items processed per second
+  Record &Add(const timing_t &timing, double items,
+              const std::string &unit) {
+    Add("seconds", timing.best);
+    Add("mean_seconds", timing.mean);
+    Add("repeats", timing.repeats);
+    Add("rate", items / timing.best);
+    return Add("rate_unit", unit);
+  }
+
+  void Print(std::ostream &out = std::cout) const {
+    out << "{";
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+      out << (i ? ", " : "") << "\"" << entries_[i].first
+          << "\": " << entries_[i].second;
+    }
+    out << "}" << std::endl;
+  }
+
+ private:
+  std::vector<std::pair<std::string, std::string>> entries_;
+};
+
+}  // namespace benchmark
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_BENCHMARK_H
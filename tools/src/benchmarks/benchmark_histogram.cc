@@ -0,0 +1,72 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Bins random numbers with HistogramNew for several numbers of bins, prints
+// one json object per case.
+
+// Standard includes
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Local VOTCA includes
+#include "votca/tools/histogramnew.h"
+#include "votca/tools/types.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+
+using namespace votca;
+
+int main(int argc, char **argv) {
+  Index nvalues = (argc > 1) ? std::atol(argv[1]) : 1000000;
+  std::mt19937 gen(42);
+  std::normal_distribution<double> dist(1.0, 0.3);
+  std::vector<double> values(nvalues);
+  for (double &v : values) {
+    v = dist(gen);
+  }
+
+  for (Index nbins : {10, 100, 1000, 10000}) {
+    for (bool periodic : {false, true}) {
+      tools::HistogramNew hist;
+      hist.Initialize(0.0, 2.0, nbins);
+      hist.setPeriodic(periodic);
+      tools::benchmark::timing_t process = tools::benchmark::Measure([&]() {
+        for (double v : values) {
+          hist.Process(v);
+        }
+      });
+      tools::benchmark::Record("histogram", "Process")
+          .Add("nbins", nbins)
+          .Add("periodic", Index(periodic))
+          .Add("values", nvalues)
+          .Add(process, double(nvalues), "values/s")
+          .Print();
+
+      tools::benchmark::timing_t range = tools::benchmark::Measure(
+          [&]() { hist.ProcessRange(values.begin(), values.end()); });
+      tools::benchmark::Record("histogram", "ProcessRange")
+          .Add("nbins", nbins)
+          .Add("periodic", Index(periodic))
+          .Add("values", nvalues)
+          .Add(range, double(nvalues), "values/s")
+          .Print();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Interpolation, fitting and evaluation of cubic splines for several grid
+// sizes, prints one json object per case.
+
+// Standard includes
+#include <cmath>
+#include <cstdlib>
+
+// Local VOTCA includes
+#include "votca/tools/cubicspline.h"
+#include "votca/tools/eigen.h"
+#include "votca/tools/types.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+
+using namespace votca;
+
+int main(int argc, char **argv) {
+  Index npoints = (argc > 1) ? std::atol(argv[1]) : 1000000;
+  const double min = 0.3;
+  const double max = 1.5;
+  Eigen::VectorXd r = Eigen::VectorXd::LinSpaced(npoints, min, max);
+
+  for (Index ngrid : {50, 200, 1000}) {
+    Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(ngrid, min, max);
+    Eigen::VectorXd y = x.unaryExpr([](double v) { return std::cos(5 * v); });
+
+    tools::CubicSpline spline;
+    tools::benchmark::timing_t interpolate =
+        tools::benchmark::Measure([&]() { spline.Interpolate(x, y); });
+    tools::benchmark::Record("spline", "Interpolate")
+        .Add("grid", ngrid)
+        .Add(interpolate, 1.0, "splines/s")
+        .Print();
+
+    double checksum = 0.0;
+    tools::benchmark::timing_t scalar = tools::benchmark::Measure([&]() {
+      checksum = 0.0;
+      for (Index i = 0; i < npoints; ++i) {
+        checksum += spline.Calculate(r[i]);
+      }
+    });
+    tools::benchmark::Record("spline", "Calculate(double)")
+        .Add("grid", ngrid)
+        .Add("points", npoints)
+        .Add(scalar, double(npoints), "points/s")
+        .Add("checksum", checksum)
+        .Print();
+
+    Eigen::VectorXd result;
+    tools::benchmark::timing_t vector =
+        tools::benchmark::Measure([&]() { result = spline.Calculate(r); });
+    tools::benchmark::Record("spline", "Calculate(VectorXd)")
+        .Add("grid", ngrid)
+        .Add("points", npoints)
+        .Add(vector, double(npoints), "points/s")
+        .Add("checksum", result.sum())
+        .Print();
+
+    // fit of noisy data on the same grid, as done in force matching
+    Eigen::VectorXd data =
+        r.unaryExpr([](double v) { return std::cos(5 * v); }) +
+        0.01 * Eigen::VectorXd::Random(npoints);
+    tools::CubicSpline fit;
+    fit.GenerateGrid(min, max, (max - min) / double(ngrid - 1));
+    tools::benchmark::timing_t fitting =
+        tools::benchmark::Measure([&]() { fit.Fit(r, data); });
+    tools::benchmark::Record("spline", "Fit")
+        .Add("grid", ngrid)
+        .Add("points", npoints)
+        .Add(fitting, double(npoints), "points/s")
+        .Print();
+  }
+  return 0;
+}
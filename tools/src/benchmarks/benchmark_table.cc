@@ -0,0 +1,65 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Writes and reads tables of several sizes with Table::Save and Table::Load,
+// prints one json object per case.
+
+// Standard includes
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+// Local VOTCA includes
+#include "votca/tools/table.h"
+#include "votca/tools/types.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+
+using namespace votca;
+
+int main() {
+  const std::string filename = "benchmark_table.dat";
+  for (Index size : {1000, 100000, 1000000}) {
+    tools::Table table;
+    table.resize(size);
+    for (Index i = 0; i < size; ++i) {
+      double x = 0.001 * double(i);
+      table.set(i, x, std::sin(x), 'i');
+    }
+
+    tools::benchmark::timing_t save =
+        tools::benchmark::Measure([&]() { table.Save(filename); });
+    tools::benchmark::Record("table", "Save")
+        .Add("rows", size)
+        .Add(save, double(size), "rows/s")
+        .Print();
+
+    tools::Table loaded;
+    tools::benchmark::timing_t load = tools::benchmark::Measure([&]() {
+      loaded = tools::Table();
+      loaded.Load(filename);
+    });
+    tools::benchmark::Record("table", "Load")
+        .Add("rows", size)
+        .Add(load, double(size), "rows/s")
+        .Add("checksum", loaded.y().sum())
+        .Print();
+  }
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Parses lines like the atoms section of a lammps dump file with the boost
+// based Tokenizer and with ViewTokenizer, prints one json object per case.
+
+// Standard includes
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Local VOTCA includes
+#include "votca/tools/tokenizer.h"
+#include "votca/tools/types.h"
+
+// Local private VOTCA includes
+#include "benchmark.h"
+
+using namespace votca;
+
+namespace {
+
+std::vector<std::string> MakeLines(Index nlines) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-50.0, 50.0);
+  std::vector<std::string> lines;
+  lines.reserve(nlines);
+  for (Index i = 0; i < nlines; ++i) {
+    std::string line = std::to_string(i + 1) + " " + std::to_string(i % 4);
+    for (Index k = 0; k < 6; ++k) {
+      line += " " + std::to_string(dist(gen));
+    }
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+template <class F>
+void Run(const std::string &name, const std::vector<std::string> &lines,
+         F &&parse) {
+  double checksum = 0.0;
+  tools::benchmark::timing_t timing = tools::benchmark::Measure([&]() {
+    checksum = 0.0;
+    for (const std::string &line : lines) {
+      checksum += parse(line);
+    }
+  });
+  tools::benchmark::Record("tokenizer", name)
+      .Add("lines", Index(lines.size()))
+      .Add(timing, double(lines.size()), "lines/s")
+      .Add("checksum", checksum)
+      .Print();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Index nlines = (argc > 1) ? std::atol(argv[1]) : 1000000;
+  std::vector<std::string> lines = MakeLines(nlines);
+
+  Run("Tokenizer::ToVector<double>", lines, [](const std::string &line) {
+    std::vector<double> values =
+        tools::Tokenizer(line, " ").ToVector<double>();
+    return values[2];
+  });
+
+  Run("Tokenizer::ToVector<string>", lines, [](const std::string &line) {
+    std::vector<std::string> words = tools::Tokenizer(line, " ").ToVector();
+    return double(words[2].size());
+  });
+
+  std::vector<double> values;
+  Run("ViewTokenizer::ToVector<double>", lines,
+      [&values](const std::string &line) {
+        tools::ViewTokenizer(line, " ").ToVector(values);
+        return values[2];
+      });
+
+  std::vector<std::string_view> words;
+  Run("ViewTokenizer::ToVector<string_view>", lines,
+      [&words](const std::string &line) {
+        tools::ViewTokenizer(line, " ").ToVector(words);
+        return double(words[2].size());
+      });
+  return 0;
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Compare two files of VOTCA benchmark results and report regressions."""
+#
+# Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import json
+import sys
+
+if not sys.version_info >= (3, 6):
+    raise Exception("This script needs Python 3.6+.")
+
+# keys which are results and not parameters of a case
+RESULT_KEYS = {
+    "seconds",
+    "mean_seconds",
+    "repeats",
+    "rate",
+    "rate_unit",
+    "megabytes_per_second",
+    "checksum",
+    "pairs",
+    "excluded",
+    "frames",
+    "error",
+}
+
+PARSER = argparse.ArgumentParser(
+    description="""Compares the output of two runs of the benchmark programs,
+e.g. of two releases. Every line of the input files is a json object as
+printed by the benchmark_* programs. Cases are matched by all of their
+parameters. Returns 1 if any case got slower than the threshold.""",
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+)
+PARSER.add_argument("baseline", type=argparse.FileType("r"), help="reference results")
+PARSER.add_argument("results", type=argparse.FileType("r"), help="new results")
+PARSER.add_argument(
+    "--threshold",
+    type=float,
+    default=10.0,
+    help="relative slowdown in percent that counts as regression",
+)
+
+
+def read_results(f):
+    """Return a dict from the parameters of a case to its record."""
+    results = {}
+    for line in f:
+        line = line.strip()
+        if not line.startswith("{"):
+            continue
+        record = json.loads(line)
+        key = tuple(
+            sorted((k, str(v)) for k, v in record.items() if k not in RESULT_KEYS)
+        )
+        results[key] = record
+    return results
+
+
+def describe(key):
+    """Return a short name of a case."""
+    return ", ".join(f"{k}={v}" for k, v in key)
+
+
+def main():
+    args = PARSER.parse_args()
+    baseline = read_results(args.baseline)
+    results = read_results(args.results)
+
+    regressions = 0
+    for key, new in results.items():
+        old = baseline.get(key)
+        if old is None:
+            print(f"new      {describe(key)}")
+            continue
+        # a missing rate means the case failed, null that it was too fast
+        if not old.get("rate") or not new.get("rate"):
+            reason = new.get("error", old.get("error", "rate is not finite"))
+            print(f"error    {describe(key)}: {reason}")
+            continue
+        change = 100.0 * (new["rate"] / old["rate"] - 1.0)
+        status = "ok"
+        if change < -args.threshold:
+            status = "SLOWER"
+            regressions += 1
+        elif change > args.threshold:
+            status = "faster"
+        print(
+            f"{status:8} {describe(key)}: {old['rate']:.4g} -> {new['rate']:.4g} "
+            f"{new['rate_unit']} ({change:+.1f}%)"
+        )
+    for key in baseline.keys() - results.keys():
+        print(f"missing  {describe(key)}")
+
+    if regressions:
+        print(f"{regressions} regression(s) above {args.threshold}%")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -46,6 +46,7 @@ void AkimaSpline::Interpolate(const Eigen::VectorXd &x,
 
   // copy the grid points into f
   r_ = x;
+  UpdateGrid();
 
   // initialize vectors p1,p2,p3,p4 and t
   p0 = Eigen::VectorXd::Zero(N);
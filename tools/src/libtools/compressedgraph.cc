@@ -0,0 +1,186 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+
+// Local VOTCA includes
+#include "votca/tools/compressedgraph.h"
+
+using namespace std;
+
+namespace votca {
+namespace tools {
+
+/**********************
+ * Internal Functions *
+ **********************/
+
+namespace {
+
+/// Combine a hash with a value, based on the splitmix64 finalizer
+uint64_t mix_(uint64_t hash, uint64_t value) {
+  uint64_t x = hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+                       (hash >> 2));
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+Index countDistinct_(vector<uint64_t> values) {
+  sort(values.begin(), values.end());
+  return Index(unique(values.begin(), values.end()) - values.begin());
+}
+
+}  // namespace
+
+/********************
+ * Public Functions *
+ ********************/
+
+CompressedGraph::CompressedGraph(const vector<Edge>& edges,
+                                 const unordered_map<Index, GraphNode>& nodes) {
+
+  vertices_.reserve(nodes.size());
+  for (const pair<const Index, GraphNode>& id_and_node : nodes) {
+    vertices_.push_back(id_and_node.first);
+  }
+  for (const Edge& edge : edges) {
+    vertices_.push_back(edge.getEndPoint1());
+    vertices_.push_back(edge.getEndPoint2());
+  }
+  sort(vertices_.begin(), vertices_.end());
+  vertices_.erase(unique(vertices_.begin(), vertices_.end()), vertices_.end());
+
+  local_index_.reserve(vertices_.size());
+  for (Index local = 0; local < VertexCount(); ++local) {
+    local_index_[vertices_[local]] = local;
+  }
+
+  // count the edge ends of every vertex and build the row offsets
+  offsets_.assign(vertices_.size() + 1, 0);
+  for (const Edge& edge : edges) {
+    ++offsets_[local_index_[edge.getEndPoint1()] + 1];
+    ++offsets_[local_index_[edge.getEndPoint2()] + 1];
+  }
+  for (Index local = 0; local < VertexCount(); ++local) {
+    offsets_[local + 1] += offsets_[local];
+  }
+
+  neighbors_.resize(offsets_.back());
+  vector<Index> fill(offsets_.begin(), offsets_.end() - 1);
+  for (const Edge& edge : edges) {
+    Index local1 = local_index_[edge.getEndPoint1()];
+    Index local2 = local_index_[edge.getEndPoint2()];
+    neighbors_[fill[local1]++] = local2;
+    neighbors_[fill[local2]++] = local1;
+  }
+  for (Index local = 0; local < VertexCount(); ++local) {
+    sort(neighbors_.begin() + offsets_[local],
+         neighbors_.begin() + offsets_[local + 1]);
+  }
+  edge_count_ = Index(edges.size());
+
+  const uint64_t empty_label = EncodeNode(GraphNode());
+  labels_.resize(vertices_.size(), empty_label);
+  for (Index local = 0; local < VertexCount(); ++local) {
+    auto id_and_node = nodes.find(vertices_[local]);
+    if (id_and_node != nodes.end()) {
+      labels_[local] = EncodeNode(id_and_node->second);
+    }
+  }
+}
+
+vector<Index> CompressedGraph::ConnectedComponents() const {
+  vector<Index> component(vertices_.size(), -1);
+  vector<Index> queue;
+  queue.reserve(vertices_.size());
+  Index component_id = 0;
+  for (Index start = 0; start < VertexCount(); ++start) {
+    if (component[start] != -1) {
+      continue;
+    }
+    queue.clear();
+    queue.push_back(start);
+    component[start] = component_id;
+    for (size_t next = 0; next < queue.size(); ++next) {
+      Index local = queue[next];
+      for (const Index* neigh = NeighBegin(local); neigh != NeighEnd(local);
+           ++neigh) {
+        if (component[*neigh] == -1) {
+          component[*neigh] = component_id;
+          queue.push_back(*neigh);
+        }
+      }
+    }
+    ++component_id;
+  }
+  return component;
+}
+
+uint64_t CompressedGraph::CanonicalHash() const {
+  vector<uint64_t> colors = labels_;
+  vector<uint64_t> refined(colors.size());
+  vector<uint64_t> neigh_colors;
+  Index classes = countDistinct_(colors);
+
+  // each round can only split classes, so at most VertexCount() rounds are
+  // needed until the partition is stable
+  for (Index round = 0; round < VertexCount(); ++round) {
+    for (Index local = 0; local < VertexCount(); ++local) {
+      neigh_colors.clear();
+      for (const Index* neigh = NeighBegin(local); neigh != NeighEnd(local);
+           ++neigh) {
+        neigh_colors.push_back(colors[*neigh]);
+      }
+      sort(neigh_colors.begin(), neigh_colors.end());
+      uint64_t hash = mix_(colors[local], uint64_t(neigh_colors.size()));
+      for (uint64_t color : neigh_colors) {
+        hash = mix_(hash, color);
+      }
+      refined[local] = hash;
+    }
+    colors.swap(refined);
+    Index refined_classes = countDistinct_(colors);
+    if (refined_classes == classes) {
+      break;
+    }
+    classes = refined_classes;
+  }
+
+  sort(colors.begin(), colors.end());
+  uint64_t hash = mix_(uint64_t(VertexCount()), uint64_t(EdgeCount()));
+  for (uint64_t color : colors) {
+    hash = mix_(hash, color);
+  }
+  return hash;
+}
+
+uint64_t CompressedGraph::EncodeNode(const GraphNode& node) {
+  // FNV-1a, so labels are reproducible between runs
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : node.getStringId()) {
+    hash ^= uint64_t(static_cast<unsigned char>(c));
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+}  // namespace tools
+}  // namespace votca
@@ -18,6 +18,7 @@
 // Standard includes
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 // Local VOTCA includes
 #include "votca/tools/cubicspline.h"
@@ -28,6 +29,44 @@ namespace tools {
 
 using namespace std;
 
+namespace {
+
+// Collects the entries written by AddToFitMatrix and AddBCToFitMatrix. These
+// only add to entries or set entries which are zero, so duplicate entries
+// are summed up when the sparse matrix is built.
+class SparseFitMatrix {
+ public:
+  SparseFitMatrix(Index rows, Index cols) : rows_(rows), cols_(cols) {}
+
+  double &operator()(Index row, Index col) {
+    entries_.push_back({row, col, 0.0});
+    return entries_.back().value_;
+  }
+
+  Eigen::SparseMatrix<double> toSparse() const {
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(entries_.size());
+    for (const entry_t &entry : entries_) {
+      triplets.emplace_back(entry.row_, entry.col_, entry.value_);
+    }
+    Eigen::SparseMatrix<double> M(rows_, cols_);
+    M.setFromTriplets(triplets.begin(), triplets.end());
+    return M;
+  }
+
+ private:
+  struct entry_t {
+    Index row_;
+    Index col_;
+    double value_;
+  };
+  Index rows_;
+  Index cols_;
+  std::vector<entry_t> entries_;
+};
+
+}  // namespace
+
 void CubicSpline::Interpolate(const Eigen::VectorXd &x,
                               const Eigen::VectorXd &y) {
   if (x.size() != y.size()) {
@@ -46,6 +85,7 @@ void CubicSpline::Interpolate(const Eigen::VectorXd &x,
 
   // copy the grid points into f
   r_ = x;
+  UpdateGrid();
   f_ = y;
   Eigen::VectorXd temp = Eigen::VectorXd::Zero(N);
 
@@ -99,16 +139,17 @@ void CubicSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
   // and b[i]=0 for i>=N (for smoothing condition)
   // A[i,j] contains the data fitting + the spline smoothing conditions
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, 2 * ngrid);
-  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(
-      ngrid, 2 * ngrid);  // Matrix with smoothing conditions
+  // both matrices are banded, so they are assembled as sparse matrices
+  SparseFitMatrix A(N, 2 * ngrid);
+  SparseFitMatrix B(ngrid, 2 * ngrid);  // Matrix with smoothing conditions
 
   // Construct smoothing matrix
   AddBCToFitMatrix(B, 0);
   // construct the matrix to fit the points and the vector b
   AddToFitMatrix(A, x, 0);
-  // now do a constrained qr solve
-  Eigen::VectorXd sol = linalg_constrained_qrsolve(A, y, B);
+  // now do a constrained sparse solve
+  Eigen::VectorXd sol =
+      linalg_constrained_sparse_solve(A.toSparse(), y, B.toSparse());
 
 #ifndef __INTEL_LLVM_COMPILER
   /* isnan/isinf is always false in fast floating point modes on intel */
@@ -128,63 +169,73 @@ void CubicSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
 
 double CubicSpline::Calculate(double r) {
   Index interval = getInterval(r);
-  return A(r) * f_[interval] + B(r) * f_[interval + 1] + C(r) * f2_[interval] +
-         D(r) * f2_[interval + 1];
+  return Terms(r, interval)
+      .dot(Eigen::Vector4d(f_[interval], f_[interval + 1], f2_[interval],
+                           f2_[interval + 1]));
 }
 
 double CubicSpline::CalculateDerivative(double r) {
   Index interval = getInterval(r);
-  return Aprime(r) * f_[interval] + Bprime(r) * f_[interval + 1] +
-         Cprime(r) * f2_[interval] + Dprime(r) * f2_[interval + 1];
-}
-
-double CubicSpline::A(double r) {
-  return (1.0 - (r - r_[getInterval(r)]) /
-                    (r_[getInterval(r) + 1] - r_[getInterval(r)]));
-}
-
-double CubicSpline::Aprime(double r) {
-  return -1.0 / (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+  return TermsPrime(r, interval)
+      .dot(Eigen::Vector4d(f_[interval], f_[interval + 1], f2_[interval],
+                           f2_[interval + 1]));
 }
 
-double CubicSpline::B(double r) {
-  return (r - r_[getInterval(r)]) /
-         (r_[getInterval(r) + 1] - r_[getInterval(r)]);
-}
-
-double CubicSpline::Bprime(double r) {
-  return 1.0 / (r_[getInterval(r) + 1] - r_[getInterval(r)]);
-}
-
-double CubicSpline::C(double r) {
-
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
-
-  return (0.5 * xxi * xxi - (1.0 / 6.0) * xxi * xxi * xxi / h -
-          (1.0 / 3.0) * xxi * h);
+Eigen::VectorXd CubicSpline::Calculate(const Eigen::VectorXd &x) {
+  const Index n = x.size();
+  // gather the interval data, so the terms can be evaluated on whole arrays
+  Eigen::ArrayXd xxi(n), h(n), f0(n), f1(n), f20(n), f21(n);
+  for (Index k = 0; k < n; ++k) {
+    Index interval = getInterval(x(k));
+    xxi(k) = x(k) - r_[interval];
+    h(k) = r_[interval + 1] - r_[interval];
+    f0(k) = f_[interval];
+    f1(k) = f_[interval + 1];
+    f20(k) = f2_[interval];
+    f21(k) = f2_[interval + 1];
+  }
+  Eigen::ArrayXd b = xxi / h;
+  Eigen::ArrayXd xxi3_h = xxi.cube() / h;
+  Eigen::ArrayXd c = 0.5 * xxi.square() - (1.0 / 6.0) * xxi3_h -
+                     (1.0 / 3.0) * xxi * h;
+  Eigen::ArrayXd d = (1.0 / 6.0) * xxi3_h - (1.0 / 6.0) * xxi * h;
+  return ((1.0 - b) * f0 + b * f1 + c * f20 + d * f21).matrix();
 }
 
-double CubicSpline::Cprime(double r) {
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
-
-  return (xxi - 0.5 * xxi * xxi / h - h / 3);
+Eigen::VectorXd CubicSpline::CalculateDerivative(const Eigen::VectorXd &x) {
+  const Index n = x.size();
+  Eigen::ArrayXd xxi(n), h(n), f0(n), f1(n), f20(n), f21(n);
+  for (Index k = 0; k < n; ++k) {
+    Index interval = getInterval(x(k));
+    xxi(k) = x(k) - r_[interval];
+    h(k) = r_[interval + 1] - r_[interval];
+    f0(k) = f_[interval];
+    f1(k) = f_[interval + 1];
+    f20(k) = f2_[interval];
+    f21(k) = f2_[interval + 1];
+  }
+  Eigen::ArrayXd xxi2_h = xxi.square() / h;
+  Eigen::ArrayXd cprime = xxi - 0.5 * xxi2_h - h / 3.0;
+  Eigen::ArrayXd dprime = 0.5 * xxi2_h - h / 6.0;
+  return ((f1 - f0) / h + cprime * f20 + dprime * f21).matrix();
 }
 
-double CubicSpline::D(double r) {
-
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
-
-  return ((1.0 / 6.0) * xxi * xxi * xxi / h - (1.0 / 6.0) * xxi * h);
+Eigen::Vector4d CubicSpline::Terms(double r, Index interval) const {
+  double xxi = r - r_[interval];
+  double h = r_[interval + 1] - r_[interval];
+  double b = xxi / h;
+  double xxi3_h = xxi * xxi * xxi / h;
+  return Eigen::Vector4d(
+      1.0 - b, b,
+      0.5 * xxi * xxi - (1.0 / 6.0) * xxi3_h - (1.0 / 3.0) * xxi * h,
+      (1.0 / 6.0) * xxi3_h - (1.0 / 6.0) * xxi * h);
 }
 
-double CubicSpline::Dprime(double r) {
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
-
-  return (0.5 * xxi * xxi / h - (1.0 / 6.0) * h);
+Eigen::Vector4d CubicSpline::TermsPrime(double r, Index interval) const {
+  double xxi = r - r_[interval];
+  double h = r_[interval + 1] - r_[interval];
+  return Eigen::Vector4d(-1.0 / h, 1.0 / h, xxi - 0.5 * xxi * xxi / h - h / 3,
+                         0.5 * xxi * xxi / h - (1.0 / 6.0) * h);
 }
 
 double CubicSpline::A_prime_l(Index i) { return -1.0 / (r_[i + 1] - r_[i]); }
@@ -18,6 +18,7 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <list>
 
 // Local VOTCA includes
@@ -243,47 +244,35 @@ ReducedGraph reduceGraph(Graph graph) {
 
 vector<Graph> decoupleIsolatedSubGraphs(Graph graph) {
 
-  const std::vector<Index>& vertices = graph.getVertices();
-  // bool vector to see if vertex is already part of graph
-  std::vector<bool> vertex_analysed = std::vector<bool>(vertices.size(), false);
-
-  std::vector<Graph> subGraphs;
-  Index i = 0;
-  while (i < Index(vertices.size())) {
-    if (vertex_analysed[i]) {
-      i++;
-      continue;
-    }
-    Graph_BF_Visitor graph_visitor_breadth_first;
-    graph_visitor_breadth_first.setStartingVertex(vertices[i]);
-    exploreGraph(graph, graph_visitor_breadth_first);
-    set<Index> sub_graph_explored_vertices =
-        graph_visitor_breadth_first.getExploredVertices();
-
-    for (Index vertex : sub_graph_explored_vertices) {
-      for (Index j = 0; j < Index(vertices.size()); j++) {
-        if (vertex_analysed[j]) {
-          continue;
-        }
-        if (vertex == vertices[j]) {
-          vertex_analysed[j] = true;
-          break;
-        }
-      }
-    }
+  // the connected components are found with a linear breadth first search on
+  // the compressed copy of the graph
+  CompressedGraph compressed = graph.getCompressedGraph();
+  vector<Index> component = compressed.ConnectedComponents();
+  Index number_of_sub_graphs = 0;
+  if (!component.empty()) {
+    number_of_sub_graphs =
+        *max_element(component.begin(), component.end()) + 1;
+  }
 
-    set<Edge> sub_graph_edges;
-    unordered_map<Index, GraphNode> sub_graph_nodes;
-    for (Index vertex : sub_graph_explored_vertices) {
+  vector<vector<Edge>> sub_graph_edges(number_of_sub_graphs);
+  vector<unordered_map<Index, GraphNode>> sub_graph_nodes(
+      number_of_sub_graphs);
+  for (const Edge& edge : graph.getEdges()) {
+    Index local = compressed.getLocalIndex(edge.getEndPoint1());
+    sub_graph_edges[component[local]].push_back(edge);
+  }
+  for (const pair<Index, GraphNode>& id_and_node : graph.getNodes()) {
+    Index local = compressed.getLocalIndex(id_and_node.first);
+    sub_graph_nodes[component[local]].insert(id_and_node);
+  }
 
-      for (const Edge& sub_graph_edge : graph.getNeighEdges(vertex)) {
-        sub_graph_edges.insert(sub_graph_edge);
-      }
-      sub_graph_nodes[vertex] = graph.getNode(vertex);
-    }
-    subGraphs.push_back(
-        Graph(std::vector<Edge>(sub_graph_edges.begin(), sub_graph_edges.end()),
-              sub_graph_nodes));
+  std::vector<Graph> subGraphs;
+  subGraphs.reserve(number_of_sub_graphs);
+  for (Index i = 0; i < number_of_sub_graphs; ++i) {
+    vector<Edge>& edges = sub_graph_edges[i];
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    subGraphs.push_back(Graph(edges, sub_graph_nodes[i]));
   }
   return subGraphs;
 }
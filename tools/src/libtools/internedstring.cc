@@ -0,0 +1,101 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+// Local VOTCA includes
+#include "votca/tools/internedstring.h"
+
+namespace votca {
+namespace tools {
+
+namespace {
+
+class StringTable {
+ public:
+  StringTable() : empty_(Insert(std::string_view()).first) {}
+
+  std::pair<const std::string *, Index> Intern(std::string_view str) {
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto iter = ids_.find(str);
+      if (iter != ids_.end()) {
+        return {&strings_[iter->second], iter->second};
+      }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // another thread may have added it in the meantime
+    auto iter = ids_.find(str);
+    if (iter != ids_.end()) {
+      return {&strings_[iter->second], iter->second};
+    }
+    return Insert(str);
+  }
+
+  Index Find(std::string_view str) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto iter = ids_.find(str);
+    return (iter == ids_.end()) ? -1 : iter->second;
+  }
+
+  Index Count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return Index(strings_.size());
+  }
+
+  const std::string *Empty() const { return empty_; }
+
+ private:
+  std::pair<const std::string *, Index> Insert(std::string_view str) {
+    Index id = Index(strings_.size());
+    // a deque does not move its elements, so the keys of ids_ stay valid
+    strings_.emplace_back(str);
+    ids_.emplace(std::string_view(strings_.back()), id);
+    return {&strings_.back(), id};
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, Index> ids_;
+  const std::string *empty_;
+};
+
+StringTable &Table() {
+  static StringTable table;
+  return table;
+}
+
+}  // namespace
+
+InternedString::InternedString() : str_(Table().Empty()), id_(0) {}
+
+InternedString::InternedString(std::string_view str) {
+  auto entry = Table().Intern(str);
+  str_ = entry.first;
+  id_ = entry.second;
+}
+
+Index InternedString::Find(std::string_view str) { return Table().Find(str); }
+
+Index InternedString::Count() { return Table().Count(); }
+
+}  // namespace tools
+}  // namespace votca
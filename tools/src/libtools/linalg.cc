@@ -18,6 +18,7 @@
 // Standard includes
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 // Local VOTCA includes
 #include "votca/tools/linalg.h"
@@ -63,5 +64,67 @@ Eigen::VectorXd linalg_constrained_qrsolve(const Eigen::MatrixXd &A,
   return QR.householderQ() * result;
 }
 
+Eigen::VectorXd linalg_constrained_sparse_solve(
+    const Eigen::SparseMatrix<double> &A, const Eigen::VectorXd &b,
+    const Eigen::SparseMatrix<double> &constr) {
+
+  const Index NoVariables = A.cols();
+  const Index NoConstrains = constr.rows();
+
+  // check matrix for zero column
+  Eigen::VectorXd colnorm = Eigen::VectorXd::Zero(NoVariables);
+  for (Index j = 0; j < A.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(A, j); it; ++it) {
+      colnorm(it.col()) += it.value() * it.value();
+    }
+  }
+  if ((colnorm.array() < 1e-18).any()) {
+    throw std::runtime_error("constrained_qrsolve_zero_column_in_matrix");
+  }
+
+  // scale the columns to unit norm, this removes the different magnitudes of
+  // e.g. function values and second derivatives of a spline before the
+  // normal equations square the condition number
+  Eigen::VectorXd scale = colnorm.cwiseSqrt().cwiseInverse();
+  Eigen::SparseMatrix<double> As = A * scale.asDiagonal();
+  Eigen::SparseMatrix<double> Bs = constr * scale.asDiagonal();
+
+  // eliminating the residuals from the augmented system leaves the normal
+  // equations with the constraints, whose size only depends on the number of
+  // variables. The normal matrix of a banded A is banded.
+  Eigen::SparseMatrix<double> AtA = As.transpose() * As;
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(AtA.nonZeros() + 2 * Bs.nonZeros());
+  for (Index j = 0; j < AtA.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(AtA, j); it; ++it) {
+      triplets.emplace_back(it.row(), it.col(), it.value());
+    }
+  }
+  for (Index j = 0; j < Bs.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(Bs, j); it; ++it) {
+      triplets.emplace_back(it.col(), NoVariables + it.row(), it.value());
+      triplets.emplace_back(NoVariables + it.row(), it.col(), it.value());
+    }
+  }
+
+  const Index size = NoVariables + NoConstrains;
+  Eigen::SparseMatrix<double> K(size, size);
+  K.setFromTriplets(triplets.begin(), triplets.end());
+
+  Eigen::VectorXd rhs = Eigen::VectorXd::Zero(size);
+  rhs.head(NoVariables) = As.transpose() * b;
+
+  Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>
+      solver;
+  solver.compute(K);
+  if (solver.info() != Eigen::Success) {
+    throw std::runtime_error(
+        "linalg_constrained_sparse_solve: decomposition failed, the system is "
+        "singular");
+  }
+  Eigen::VectorXd sol = solver.solve(rhs);
+  return scale.cwiseProduct(sol.head(NoVariables));
+}
+
 }  // namespace tools
 }  // namespace votca
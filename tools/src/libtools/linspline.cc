@@ -58,6 +58,7 @@ void LinSpline::Interpolate(const Eigen::VectorXd &x,
 
   // copy the grid points into f
   r_ = x;
+  UpdateGrid();
 
   // LINEAR SPLINE: a(i) * x + b(i)
   // where i=number of interval
@@ -46,33 +46,14 @@ using namespace std;
 const Index Property::IOindex = std::ios_base::xalloc();
 
 const Property &Property::get(const string &key) const {
-  Tokenizer tok(key, ".");
-  Tokenizer::iterator n = tok.begin();
-  if (n == tok.end()) {
-    return *this;
-  }
-
-  const Property *p;
-  map<string, std::vector<Index>>::const_iterator iter;
-  if (*n == "") {
-    p = this;
-  } else {
-    iter = map_.find(*n);
-    if (iter == map_.end()) {
+  const Property *p = this;
+  for (std::string_view name : ViewTokenizer(key, ".")) {
+    auto iter = p->map_.find(name);
+    if (iter == p->map_.end()) {
       throw std::runtime_error("property not found: " + key);
     }
-    p = &properties_[iter->second.back()];
-  }
-  ++n;
-  try {
-    for (; n != tok.end(); ++n) {
-      p = &p->get(*n);
-    }
-  } catch (std::runtime_error &) {  // catch here to get full key in
-                                    // exception
-    throw std::runtime_error("property not found: " + key);
+    p = &p->properties_[iter->second.back()];
   }
-
   return *p;
 }
 
@@ -161,44 +142,64 @@ Property &Property::getOradd(const std::string &key) {
   }
 }
 
+namespace {
+// appends the children of parent matching name to selected, uses the index of
+// child names if name contains no wildcards
+template <class P>
+void SelectChildren(P &parent, std::string_view name,
+                    const std::map<std::string, std::vector<Index>, std::less<>>
+                        &index,
+                    std::vector<P *> &selected) {
+  if (name.find_first_of("*?") == std::string_view::npos) {
+    auto iter = index.find(name);
+    if (iter != index.end()) {
+      for (Index i : iter->second) {
+        selected.push_back(&*(parent.begin() + i));
+      }
+    }
+    return;
+  }
+  const std::string wild(name);
+  for (P &child : parent) {
+    if (wildcmp(wild, child.name())) {
+      selected.push_back(&child);
+    }
+  }
+}
+}  // namespace
+
 std::vector<const Property *> Property::Select(const string &filter) const {
-  Tokenizer tok(filter, ".");
+  ViewTokenizer tok(filter, ".");
   std::vector<const Property *> selection;
   if (tok.begin() == tok.end()) {
     return selection;
   }
   selection.push_back(this);
-  for (const auto &n : tok) {
-    std::vector<const Property *> selected;
+  std::vector<const Property *> selected;
+  for (std::string_view n : tok) {
+    selected.clear();
     for (const Property *p : selection) {
-      for (const Property &child : *p) {
-        if (wildcmp(n, child.name())) {
-          selected.push_back(&child);
-        }
-      }
+      SelectChildren(*p, n, p->map_, selected);
     }
-    selection = selected;
+    std::swap(selection, selected);
   }
   return selection;
 }
 
 std::vector<Property *> Property::Select(const string &filter) {
-  Tokenizer tok(filter, ".");
+  ViewTokenizer tok(filter, ".");
   std::vector<Property *> selection;
   if (tok.begin() == tok.end()) {
     return selection;
   }
   selection.push_back(this);
-  for (const auto &n : tok) {
-    std::vector<Property *> selected;
+  std::vector<Property *> selected;
+  for (std::string_view n : tok) {
+    selected.clear();
     for (Property *p : selection) {
-      for (Property &child : *p) {
-        if (wildcmp(n, child.name())) {
-          selected.push_back(&child);
-        }
-      }
+      SelectChildren(*p, n, p->map_, selected);
     }
-    selection = selected;
+    std::swap(selection, selected);
   }
   return selection;
 }
@@ -235,13 +236,129 @@ void char_hndl(void *data, const char *txt, int txtlen) {
   cur->value().append(txt, txtlen);
 }
 
-void Property::LoadFromXML(string filename) {
+namespace {
+
+// state of the parser in Property::StreamFromXML
+struct stream_state_t {
+  std::vector<std::string> filter;
+  std::vector<std::string> path;
+  // depth of the open elements, elements deeper than filter are only counted
+  Index depth = 0;
+  // number of levels of the open elements matching the filter
+  Index matched = 0;
+  Property element;
+  std::stack<Property *> pstack;
+  const std::function<void(Property &)> *callback = nullptr;
+  std::exception_ptr error;
+};
+
+void stream_start_hndl(void *data, const char *el, const char **attr) {
+  XML_Parser parser = (XML_Parser)data;
+  stream_state_t *state = (stream_state_t *)XML_GetUserData(parser);
+  Index nfilter = Index(state->filter.size());
+  Index depth = state->depth++;
+  if (depth < nfilter) {
+    if (state->matched == depth && wildcmp(state->filter[depth].c_str(), el)) {
+      state->matched++;
+      if (depth < nfilter - 1) {
+        state->path.push_back(el);
+      }
+    }
+    if (state->matched < nfilter || depth != nfilter - 1) {
+      return;
+    }
+    // start of a matching element
+    std::string path = boost::algorithm::join(state->path, ".");
+    state->element = Property(el, "", path);
+    state->pstack.push(&state->element);
+  } else if (state->pstack.empty()) {
+    return;
+  } else {
+    state->pstack.push(&state->pstack.top()->add(el, ""));
+  }
+  Property *np = state->pstack.top();
+  for (Index i = 0; attr[i]; i += 2) {
+    np->setAttribute(attr[i], attr[i + 1]);
+  }
+}
+
+void stream_end_hndl(void *data, const char *) {
+  XML_Parser parser = (XML_Parser)data;
+  stream_state_t *state = (stream_state_t *)XML_GetUserData(parser);
+  Index nfilter = Index(state->filter.size());
+  Index depth = --state->depth;
+  if (depth < nfilter && state->matched > depth) {
+    state->matched = depth;
+    if (depth < nfilter - 1) {
+      state->path.pop_back();
+    }
+  }
+  if (state->pstack.empty()) {
+    return;
+  }
+  state->pstack.pop();
+  if (state->pstack.empty()) {
+    // exceptions must not propagate through the C code of expat
+    try {
+      (*state->callback)(state->element);
+    } catch (...) {
+      state->error = std::current_exception();
+      XML_StopParser(parser, XML_FALSE);
+    }
+    state->element = Property();
+  }
+}
+
+void stream_char_hndl(void *data, const char *txt, int txtlen) {
+  stream_state_t *state =
+      (stream_state_t *)XML_GetUserData((XML_Parser)data);
+  if (!state->pstack.empty()) {
+    state->pstack.top()->value().append(txt, txtlen);
+  }
+}
+
+// feeds the file to the parser in large blocks
+void ParseXMLFile(XML_Parser parser, const std::string &filename,
+                  const std::exception_ptr *error = nullptr) {
   ifstream fl;
-  fl.open(filename);
+  fl.open(filename, std::ios::binary);
   if (!fl.is_open()) {
+    XML_ParserFree(parser);
     throw std::ios_base::failure("Error on open xml file: " + filename);
   }
+  constexpr int blocksize = 1 << 16;
+  bool done = false;
+  while (!done) {
+    void *buffer = XML_GetBuffer(parser, blocksize);
+    if (!buffer) {
+      XML_ParserFree(parser);
+      throw std::runtime_error("Couldn't allocate memory for xml parser");
+    }
+    fl.read(static_cast<char *>(buffer), blocksize);
+    done = fl.eof();
+    if (fl.bad()) {
+      XML_ParserFree(parser);
+      throw std::ios_base::failure("Error reading xml file: " + filename);
+    }
+    if (!XML_ParseBuffer(parser, int(fl.gcount()), done)) {
+      if (error && *error) {
+        XML_ParserFree(parser);
+        std::rethrow_exception(*error);
+      }
+      std::string message =
+          filename + ": Parse error at line " +
+          std::to_string(XML_GetCurrentLineNumber(parser)) + "\n" +
+          XML_ErrorString(XML_GetErrorCode(parser));
+      XML_ParserFree(parser);
+      throw std::ios_base::failure(message);
+    }
+  }
+  XML_ParserFree(parser);
+}
 
+}  // namespace
+
+void Property::LoadFromXML(string filename) {
   XML_Parser parser = XML_ParserCreate(nullptr);
   if (!parser) {
     throw std::runtime_error("Couldn't allocate memory for xml parser");
@@ -255,22 +372,29 @@ void Property::LoadFromXML(string filename) {
   pstack.push(this);
 
   XML_SetUserData(parser, (void *)&pstack);
-  while (!fl.eof()) {
-    string line;
-    tools::getline(fl, line);
-    line = line + "\n";
-    if (line.length() > (size_t)std::numeric_limits<int>::max()) {
-      throw std::runtime_error("Property::LoadFromXML: line is too long");
-    }
-    if (!XML_Parse(parser, line.c_str(), (int)line.length(), fl.eof())) {
-      throw std::ios_base::failure(
-          filename + ": Parse error at line " +
-          boost::lexical_cast<string>(XML_GetCurrentLineNumber(parser)) + "\n" +
-          XML_ErrorString(XML_GetErrorCode(parser)));
-    }
+  ParseXMLFile(parser, filename);
+}
+
+void Property::StreamFromXML(const std::string &filename,
+                             const std::string &filter,
+                             const std::function<void(Property &)> &callback) {
+  stream_state_t state;
+  state.filter = Tokenizer(filter, ".").ToVector();
+  if (state.filter.empty()) {
+    return;
   }
-  fl.close();
-  XML_ParserFree(parser);
+  state.callback = &callback;
+
+  XML_Parser parser = XML_ParserCreate(nullptr);
+  if (!parser) {
+    throw std::runtime_error("Couldn't allocate memory for xml parser");
+  }
+
+  XML_UseParserAsHandlerArg(parser);
+  XML_SetElementHandler(parser, stream_start_hndl, stream_end_hndl);
+  XML_SetCharacterDataHandler(parser, stream_char_hndl);
+  XML_SetUserData(parser, (void *)&state);
+  ParseXMLFile(parser, filename, &state.error);
 }
 
 void PrintNodeTXT(std::ostream &out, const Property &p, const Index start_level,
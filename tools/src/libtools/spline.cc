@@ -15,6 +15,10 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
 // Local VOTCA includes
 #include "votca/tools/spline.h"
 
@@ -34,9 +38,30 @@ Index Spline::GenerateGrid(double min, double max, double h) {
     r_[i++] = r_init;
   }
   r_[i] = max;
+  UpdateGrid();
   return r_.size();
 }
 
+void Spline::UpdateGrid() {
+  uniform_grid_ = false;
+  if (r_.size() < 3) {
+    return;
+  }
+  double step = r_[1] - r_[0];
+  if (!(step > 0.0)) {
+    return;
+  }
+  // the last interval is allowed to be shorter, as GenerateGrid always ends
+  // the grid at max
+  for (Index i = 1; i < r_.size() - 2; ++i) {
+    if (std::abs((r_[i + 1] - r_[i]) - step) > 1e-6 * step) {
+      return;
+    }
+  }
+  uniform_grid_ = true;
+  inv_step_ = 1.0 / step;
+}
+
 Eigen::VectorXd Spline::Calculate(const Eigen::VectorXd &x) {
   Eigen::VectorXd y(x.size());
   for (Index i = 0; i < x.size(); ++i) {
@@ -59,20 +84,28 @@ void Spline::Print(std::ostream &out, double interval) {
   }
 }
 
-Index Spline::getInterval(double r) {
-  if (r < r_[0]) {
+Index Spline::getInterval(double r) const {
+  const Index last = r_.size() - 2;
+  if (!(r >= r_[0])) {
     return 0;
   }
-  if (r > r_[r_.size() - 2]) {
-    return r_.size() - 2;
+  if (r > r_[last]) {
+    return last;
   }
-  Index i;
-  for (i = 0; i < r_.size(); ++i) {
-    if (r_[i] > r) {
-      break;
+  if (uniform_grid_) {
+    Index i = std::min(Index((r - r_[0]) * inv_step_), last);
+    // the grid points carry rounding errors, so correct the estimate
+    while (i > 0 && r_[i] > r) {
+      --i;
+    }
+    while (i < last && r_[i + 1] <= r) {
+      ++i;
     }
+    return i;
   }
-  return i - 1;
+  // first grid point larger than r
+  const double *upper = std::upper_bound(r_.data(), r_.data() + r_.size(), r);
+  return Index(upper - r_.data()) - 1;
 }
 
 double Spline::getGridPoint(int i) {
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Local VOTCA includes
+#include "votca/tools/taskpool.h"
+
+namespace votca {
+namespace tools {
+
+namespace {
+
+// pool and index of the worker running on this thread
+thread_local const TaskPool *current_pool = nullptr;
+thread_local Index current_worker = -1;
+
+std::unique_ptr<TaskPool> &GlobalPool() {
+  static std::unique_ptr<TaskPool> pool;
+  return pool;
+}
+
+std::mutex global_mutex;
+
+}  // namespace
+
+TaskPool::TaskPool(Index nthreads) {
+  if (nthreads < 1) {
+    nthreads = HardwareThreadCount();
+  }
+  for (Index i = 0; i < nthreads; ++i) {
+    queues_.push_back(std::make_unique<queue_t>());
+  }
+  for (Index i = 0; i < nthreads; ++i) {
+    threads_.emplace_back([this, i]() { WorkerLoop(i); });
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+}
+
+TaskPool &TaskPool::Global() {
+  std::lock_guard<std::mutex> lock(global_mutex);
+  std::unique_ptr<TaskPool> &pool = GlobalPool();
+  if (!pool) {
+    pool = std::make_unique<TaskPool>(HardwareThreadCount());
+  }
+  return *pool;
+}
+
+void TaskPool::setGlobalThreadCount(Index nthreads) {
+  std::lock_guard<std::mutex> lock(global_mutex);
+  std::unique_ptr<TaskPool> &pool = GlobalPool();
+  if (nthreads < 1) {
+    nthreads = HardwareThreadCount();
+  }
+  if (!pool || pool->ThreadCount() != nthreads) {
+    pool.reset();
+    pool = std::make_unique<TaskPool>(nthreads);
+  }
+}
+
+Index TaskPool::HardwareThreadCount() {
+  return std::max(Index(1), Index(std::thread::hardware_concurrency()));
+}
+
+Index TaskPool::CurrentWorker() const {
+  return (current_pool == this) ? current_worker : -1;
+}
+
+void TaskPool::Push(std::function<void()> task) {
+  Index id = CurrentWorker();
+  if (id < 0) {
+    id = next_queue_++ % Index(queues_.size());
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[id]->mutex_);
+    queues_[id]->tasks_.push_back(std::move(task));
+  }
+  {
+    // increment under the lock, so no worker misses the wake up
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    pending_++;
+  }
+  wake_.notify_one();
+}
+
+bool TaskPool::Pop(Index id, std::function<void()> &task) {
+  const Index nqueues = Index(queues_.size());
+  // own queue first, newest task is most likely still in cache
+  if (id >= 0) {
+    queue_t &own = *queues_[id];
+    std::lock_guard<std::mutex> lock(own.mutex_);
+    if (!own.tasks_.empty()) {
+      task = std::move(own.tasks_.back());
+      own.tasks_.pop_back();
+      pending_--;
+      return true;
+    }
+  }
+  // steal the oldest task of another queue
+  const Index start = (id >= 0) ? id + 1 : 0;
+  for (Index k = 0; k < nqueues; ++k) {
+    queue_t &other = *queues_[(start + k) % nqueues];
+    std::lock_guard<std::mutex> lock(other.mutex_);
+    if (!other.tasks_.empty()) {
+      task = std::move(other.tasks_.front());
+      other.tasks_.pop_front();
+      pending_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TaskPool::RunPendingTask() {
+  std::function<void()> task;
+  if (!Pop(CurrentWorker(), task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void TaskPool::WorkerLoop(Index id) {
+  current_pool = this;
+  current_worker = id;
+  std::function<void()> task;
+  while (true) {
+    if (Pop(id, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+    if (stop_ && pending_ == 0) {
+      return;
+    }
+  }
+}
+
+TaskGroup::~TaskGroup() { WaitAll(); }
+
+void TaskGroup::Finish() {
+  // decrement under the lock, so WaitAll cannot miss the notification
+  std::lock_guard<std::mutex> lock(done_mutex_);
+  pending_--;
+  done_.notify_all();
+}
+
+void TaskGroup::WaitAll() {
+  while (pending_ > 0) {
+    if (pool_.RunPendingTask()) {
+      continue;
+    }
+    // the remaining tasks run on other threads, sleep until they finish.
+    // The timeout only matters if one of them queues more tasks while all
+    // workers of the pool are blocked, this thread then runs those.
+    std::unique_lock<std::mutex> lock(done_mutex_);
+    done_.wait_for(lock, std::chrono::milliseconds(10),
+                   [this]() { return pending_ == 0; });
+  }
+  // pending_ can be seen as 0 while the last task still holds done_mutex_ in
+  // Finish, the group must not be destroyed before it released it
+  std::lock_guard<std::mutex> lock(done_mutex_);
+}
+
+void TaskGroup::Wait() {
+  WaitAll();
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace tools
+}  // namespace votca
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE compressedgraph_test
+
+// Standard includes
+#include <unordered_map>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/compressedgraph.h"
+#include "votca/tools/edge.h"
+#include "votca/tools/graph.h"
+#include "votca/tools/graphnode.h"
+
+using namespace std;
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(compressedgraph_test)
+
+namespace {
+
+GraphNode makeNode(const string& name) {
+  GraphNode node;
+  node.setStr({{"Name", name}});
+  return node;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(constructors_test) {
+  CompressedGraph empty;
+  BOOST_CHECK_EQUAL(empty.VertexCount(), 0);
+  BOOST_CHECK(empty.ConnectedComponents().empty());
+}
+
+BOOST_AUTO_TEST_CASE(layout_test) {
+  //
+  // 10 - 12 - 14     20 (isolated)
+  //       |
+  //      13
+  //
+  vector<Edge> edges{Edge(10, 12), Edge(12, 14), Edge(12, 13)};
+  unordered_map<Index, GraphNode> nodes;
+  for (Index vertex : {10, 12, 13, 14, 20}) {
+    nodes[vertex] = makeNode("C");
+  }
+  CompressedGraph graph(edges, nodes);
+
+  BOOST_CHECK_EQUAL(graph.VertexCount(), 5);
+  BOOST_CHECK_EQUAL(graph.EdgeCount(), 3);
+  Index local = graph.getLocalIndex(12);
+  BOOST_CHECK_EQUAL(graph.getVertex(local), 12);
+  BOOST_CHECK_EQUAL(graph.getDegree(local), 3);
+  BOOST_CHECK_EQUAL(graph.getDegree(graph.getLocalIndex(20)), 0);
+
+  vector<Index> neighbors;
+  for (const Index* neigh = graph.NeighBegin(local);
+       neigh != graph.NeighEnd(local); ++neigh) {
+    neighbors.push_back(graph.getVertex(*neigh));
+  }
+  vector<Index> neighbors_ref{10, 13, 14};
+  BOOST_CHECK_EQUAL_COLLECTIONS(neighbors.begin(), neighbors.end(),
+                                neighbors_ref.begin(), neighbors_ref.end());
+
+  BOOST_CHECK_EQUAL(graph.getLabel(local),
+                    CompressedGraph::EncodeNode(makeNode("C")));
+}
+
+BOOST_AUTO_TEST_CASE(connectedcomponents_test) {
+  //
+  //  1 - 2 - 3
+  //      |   |            8 - 9 - 10      11
+  //      4 - 5 - 6 -7
+  //
+  vector<Edge> edges{Edge(1, 2), Edge(2, 3), Edge(2, 4), Edge(3, 5),
+                     Edge(4, 5), Edge(5, 6), Edge(6, 7), Edge(8, 9),
+                     Edge(9, 10)};
+  unordered_map<Index, GraphNode> nodes;
+  for (Index vertex = 1; vertex <= 11; ++vertex) {
+    nodes[vertex] = GraphNode();
+  }
+  CompressedGraph graph(edges, nodes);
+  vector<Index> component = graph.ConnectedComponents();
+  BOOST_CHECK_EQUAL(component.size(), 11);
+  for (Index vertex = 1; vertex <= 7; ++vertex) {
+    BOOST_CHECK_EQUAL(component[graph.getLocalIndex(vertex)], 0);
+  }
+  for (Index vertex = 8; vertex <= 10; ++vertex) {
+    BOOST_CHECK_EQUAL(component[graph.getLocalIndex(vertex)], 1);
+  }
+  BOOST_CHECK_EQUAL(component[graph.getLocalIndex(11)], 2);
+}
+
+BOOST_AUTO_TEST_CASE(canonicalhash_test) {
+  // The same branched molecule numbered in two different ways
+  //
+  //  C - C - O        C - C - O
+  //      |                |
+  //      N                N
+  unordered_map<Index, GraphNode> nodes1{{0, makeNode("C")},
+                                         {1, makeNode("C")},
+                                         {2, makeNode("O")},
+                                         {3, makeNode("N")}};
+  vector<Edge> edges1{Edge(0, 1), Edge(1, 2), Edge(1, 3)};
+
+  unordered_map<Index, GraphNode> nodes2{{7, makeNode("N")},
+                                         {5, makeNode("O")},
+                                         {9, makeNode("C")},
+                                         {4, makeNode("C")}};
+  vector<Edge> edges2{Edge(9, 5), Edge(9, 7), Edge(4, 9)};
+
+  CompressedGraph graph1(edges1, nodes1);
+  CompressedGraph graph2(edges2, nodes2);
+  BOOST_CHECK_EQUAL(graph1.CanonicalHash(), graph2.CanonicalHash());
+
+  // Moving the oxygen to the end of the chain changes the structure
+  //
+  //  C - C - N - O
+  vector<Edge> edges3{Edge(9, 4), Edge(9, 7), Edge(7, 5)};
+  CompressedGraph graph3(edges3, nodes2);
+  BOOST_CHECK_NE(graph1.CanonicalHash(), graph3.CanonicalHash());
+
+  // Changing the contents of a node changes the hash
+  unordered_map<Index, GraphNode> nodes4 = nodes1;
+  nodes4[2] = makeNode("S");
+  CompressedGraph graph4(edges1, nodes4);
+  BOOST_CHECK_NE(graph1.CanonicalHash(), graph4.CanonicalHash());
+
+  // The Graph facade gives the same hash
+  Graph graph(edges1, nodes1);
+  BOOST_CHECK_EQUAL(graph.getCanonicalHash(), graph1.CanonicalHash());
+}
+
+BOOST_AUTO_TEST_CASE(canonicalhash_regular_test) {
+  // A ring of six and two rings of three have the same degree sequence but
+  // are not equivalent
+  unordered_map<Index, GraphNode> nodes;
+  for (Index vertex = 0; vertex < 6; ++vertex) {
+    nodes[vertex] = makeNode("C");
+  }
+  vector<Edge> ring{Edge(0, 1), Edge(1, 2), Edge(2, 3),
+                    Edge(3, 4), Edge(4, 5), Edge(5, 0)};
+  vector<Edge> two_rings{Edge(0, 1), Edge(1, 2), Edge(2, 0),
+                         Edge(3, 4), Edge(4, 5), Edge(5, 3)};
+  CompressedGraph graph_ring(ring, nodes);
+  CompressedGraph graph_two_rings(two_rings, nodes);
+  // Weisfeiler-Lehman refinement can not distinguish regular graphs of the
+  // same degree, the hash is only a necessary criterion for equivalence
+  BOOST_CHECK_EQUAL(graph_ring.CanonicalHash(),
+                    graph_two_rings.CanonicalHash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,6 +29,7 @@
 #include "votca/tools/cubicspline.h"
 
 using namespace votca::tools;
+using votca::Index;
 
 BOOST_AUTO_TEST_SUITE(cubicspline_test)
 
@@ -189,4 +190,79 @@ BOOST_AUTO_TEST_CASE(cubicspline_matrix_test) {
   BOOST_CHECK_EQUAL(equalMatrix, true);
 }
 
+BOOST_AUTO_TEST_CASE(cubicspline_interval_test) {
+  // uniform grid, the last interval is shorter
+  CubicSpline uniform;
+  uniform.GenerateGrid(0.0, 1.05, 0.1);
+  // non uniform grid
+  CubicSpline nonuniform;
+  Eigen::VectorXd x(6);
+  x << 0.0, 0.1, 0.3, 0.35, 0.8, 1.0;
+  nonuniform.Interpolate(x, Eigen::VectorXd::Ones(6));
+
+  for (const CubicSpline *spline : {&uniform, &nonuniform}) {
+    const Eigen::VectorXd &grid = spline->getX();
+    const Index last = grid.size() - 2;
+    BOOST_CHECK_EQUAL(spline->getInterval(-1.0), 0);
+    BOOST_CHECK_EQUAL(spline->getInterval(2.0), last);
+    for (double r = 0.0; r < grid[grid.size() - 1]; r += 0.0123) {
+      Index ref = 0;
+      while (ref < last && grid[ref + 1] <= r) {
+        ref++;
+      }
+      BOOST_CHECK_EQUAL(spline->getInterval(r), ref);
+    }
+    // grid points belong to the interval to their right
+    for (Index i = 0; i <= last; ++i) {
+      BOOST_CHECK_EQUAL(spline->getInterval(grid[i]), i);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cubicspline_batch_test) {
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(10, 0.0, 0.9);
+  Eigen::VectorXd y = x.array().sin();
+  CubicSpline cspline;
+  cspline.Interpolate(x, y);
+
+  Eigen::VectorXd points(7);
+  points << -0.1, 0.0, 0.05, 0.333, 0.5, 0.89, 1.2;
+  Eigen::VectorXd values = cspline.Calculate(points);
+  Eigen::VectorXd derivatives = cspline.CalculateDerivative(points);
+  for (Index k = 0; k < points.size(); ++k) {
+    BOOST_CHECK_CLOSE(values[k], cspline.Calculate(points[k]), 1e-10);
+    BOOST_CHECK_CLOSE(derivatives[k], cspline.CalculateDerivative(points[k]),
+                      1e-10);
+  }
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(4, 20);
+  Eigen::MatrixXd Aref = Eigen::MatrixXd::Zero(4, 20);
+  CubicSpline::IndexMatrix rows(2, 2);
+  rows << 0, 1, 2, 1;
+  Eigen::MatrixXd scale1(2, 2);
+  scale1 << 1.0, 2.0, -0.5, 3.0;
+  Eigen::MatrixXd scale2(2, 2);
+  scale2 << 0.2, 0.0, 1.0, -1.0;
+  Eigen::VectorXd batch(2);
+  batch << 0.25, 0.61;
+  cspline.AddToFitMatrix(A, batch, rows, 2, scale1, scale2);
+  for (Index k = 0; k < 2; ++k) {
+    for (Index j = 0; j < 2; ++j) {
+      cspline.AddToFitMatrix(Aref, batch[k], rows(j, k), 2, scale1(j, k),
+                             scale2(j, k));
+    }
+  }
+  BOOST_CHECK(A.isApprox(Aref, 1e-12));
+
+  A.setZero();
+  Aref.setZero();
+  cspline.AddToFitMatrix(A, batch, rows, 0, scale1);
+  for (Index k = 0; k < 2; ++k) {
+    for (Index j = 0; j < 2; ++j) {
+      cspline.AddToFitMatrix(Aref, batch[k], rows(j, k), 0, scale1(j, k));
+    }
+  }
+  BOOST_CHECK(A.isApprox(Aref, 1e-12));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE internedstring_test
+
+// Standard includes
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/internedstring.h"
+
+using namespace std;
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(internedstring_test)
+
+BOOST_AUTO_TEST_CASE(constructors_test) {
+  InternedString empty;
+  BOOST_CHECK(empty.empty());
+  BOOST_CHECK_EQUAL(empty.getId(), 0);
+  BOOST_CHECK_EQUAL(empty, InternedString(""));
+
+  InternedString a("interned_a");
+  InternedString b(std::string("interned_") + "a");
+  InternedString c(std::string_view("interned_c"));
+  BOOST_CHECK_EQUAL(a.str(), "interned_a");
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(a != c);
+  // equal strings share one copy
+  BOOST_CHECK_EQUAL(&a.str(), &b.str());
+  BOOST_CHECK_EQUAL(a.getId(), b.getId());
+}
+
+BOOST_AUTO_TEST_CASE(find_test) {
+  Index count = InternedString::Count();
+  BOOST_CHECK_EQUAL(InternedString::Find("never_interned_string"), -1);
+  BOOST_CHECK_EQUAL(InternedString::Count(), count);
+  InternedString s("now_interned_string");
+  BOOST_CHECK_EQUAL(InternedString::Find("now_interned_string"), s.getId());
+  BOOST_CHECK_EQUAL(InternedString::Count(), count + 1);
+  BOOST_CHECK_LT(s.getId(), InternedString::Count());
+}
+
+BOOST_AUTO_TEST_CASE(threads_test) {
+  // all threads intern the same names and must get the same ids
+  const Index nthreads = 4;
+  const Index nnames = 200;
+  vector<vector<Index>> ids(nthreads, vector<Index>(nnames));
+  vector<std::thread> threads;
+  for (Index t = 0; t < nthreads; ++t) {
+    threads.emplace_back([&ids, t, nnames]() {
+      for (Index i = 0; i < nnames; ++i) {
+        ids[t][i] = InternedString("thread_name_" + to_string(i)).getId();
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (Index t = 1; t < nthreads; ++t) {
+    BOOST_CHECK(ids[t] == ids[0]);
+  }
+  for (Index i = 0; i < nnames; ++i) {
+    BOOST_CHECK_EQUAL(InternedString::Find("thread_name_" + to_string(i)),
+                      ids[0][i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(wildcard_test) {
+  InternedWildcard match("CH*");
+  BOOST_CHECK(match(InternedString("CH3")));
+  BOOST_CHECK(match(InternedString("CH2")));
+  BOOST_CHECK(!match(InternedString("OH")));
+  // second evaluation uses the stored result
+  BOOST_CHECK(match(InternedString("CH3")));
+  BOOST_CHECK(!match(InternedString("OH")));
+  InternedWildcard all("*");
+  BOOST_CHECK(all(InternedString()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
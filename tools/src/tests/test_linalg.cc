@@ -20,6 +20,7 @@
 #define BOOST_TEST_MODULE linalg_test
 
 // Standard includes
+#include <cmath>
 #include <iostream>
 
 // Third party includes
@@ -68,4 +69,55 @@ BOOST_AUTO_TEST_CASE(linalg_constrained_qrsolve_test) {
   BOOST_CHECK_EQUAL(equal, true);
 }
 
+BOOST_AUTO_TEST_CASE(linalg_constrained_sparse_solve_test) {
+
+  Eigen::VectorXd b = Eigen::VectorXd::Zero(3);
+  b << 11, -3, 8;
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(3, 3);
+  A << 1, 1, 1, 1, -1, 0, 0, 1, 1;
+  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(1, 3);
+  B << 0, -1, 3;
+
+  Eigen::VectorXd x =
+      linalg_constrained_sparse_solve(A.sparseView(), b, B.sparseView());
+  Eigen::VectorXd x_ref = Eigen::VectorXd::Zero(3);
+  x_ref << 3, 6, 2;
+
+  bool equal = x_ref.isApprox(x, 1e-7);
+  if (!equal) {
+    std::cout << "result" << std::endl;
+    std::cout << x << std::endl;
+    std::cout << "ref" << std::endl;
+    std::cout << x_ref << std::endl;
+  }
+  BOOST_CHECK_EQUAL(equal, true);
+
+  // overdetermined banded system
+  const votca::Index rows = 40;
+  const votca::Index cols = 12;
+  Eigen::MatrixXd A2 = Eigen::MatrixXd::Zero(rows, cols);
+  Eigen::VectorXd b2(rows);
+  for (votca::Index i = 0; i < rows; ++i) {
+    votca::Index col = (i * (cols - 1)) / rows;
+    A2(i, col) = 1.0 + 0.1 * double(i % 3);
+    A2(i, col + 1) = 0.5 - 0.05 * double(i % 5);
+    b2(i) = std::sin(0.3 * double(i));
+  }
+  Eigen::MatrixXd B2 = Eigen::MatrixXd::Zero(2, cols);
+  B2(0, 0) = 1;
+  B2(0, 1) = -1;
+  B2(1, cols - 1) = 1;
+
+  Eigen::VectorXd x_dense = linalg_constrained_qrsolve(A2, b2, B2);
+  Eigen::VectorXd x_sparse =
+      linalg_constrained_sparse_solve(A2.sparseView(), b2, B2.sparseView());
+  BOOST_CHECK(x_dense.isApprox(x_sparse, 1e-8));
+
+  Eigen::MatrixXd A3 = A2;
+  A3.col(3).setZero();
+  BOOST_CHECK_THROW(
+      linalg_constrained_sparse_solve(A3.sparseView(), b2, B2.sparseView()),
+      std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
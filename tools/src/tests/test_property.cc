@@ -22,6 +22,9 @@
 // Standard includes
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // Third party includes
 #include <boost/test/unit_test.hpp>
@@ -206,4 +209,59 @@ BOOST_AUTO_TEST_CASE(addTree) {
   BOOST_CHECK(three.exists("a.b.c"));
 }
 
+BOOST_AUTO_TEST_CASE(streamfromxml) {
+  std::ofstream xmlfile("test_stream.xml");
+  xmlfile << "<jobs>" << std::endl;
+  xmlfile << "  <header>skipped</header>" << std::endl;
+  for (votca::Index i = 0; i < 5; ++i) {
+    xmlfile << "  <job status=\"AVAILABLE\">" << std::endl;
+    xmlfile << "    <id>" << i << "</id>" << std::endl;
+    xmlfile << "    <input><job>nested</job></input>" << std::endl;
+    xmlfile << "  </job>" << std::endl;
+  }
+  xmlfile << "</jobs>" << std::endl;
+  xmlfile.close();
+
+  Property full;
+  full.LoadFromXML("test_stream.xml");
+  std::vector<Property*> selected = full.Select("jobs.job");
+  BOOST_REQUIRE_EQUAL(selected.size(), 5);
+
+  std::vector<Property> streamed;
+  Property::StreamFromXML("test_stream.xml", "jobs.job",
+                          [&streamed](Property& job) {
+                            streamed.push_back(std::move(job));
+                          });
+  BOOST_REQUIRE_EQUAL(streamed.size(), 5);
+  for (votca::Index i = 0; i < 5; ++i) {
+    const Property& ref = *selected[i];
+    const Property& job = streamed[i];
+    BOOST_CHECK_EQUAL(job.name(), "job");
+    BOOST_CHECK_EQUAL(job.path(), ref.path());
+    BOOST_CHECK_EQUAL(job.value(), ref.value());
+    BOOST_CHECK_EQUAL(job.getAttribute<std::string>("status"), "AVAILABLE");
+    BOOST_CHECK_EQUAL(job.get("id").as<votca::Index>(), i);
+    BOOST_CHECK_EQUAL(job.get("input.job").path(), "jobs.job.input");
+    BOOST_CHECK_EQUAL(job.get("input.job").as<std::string>(), "nested");
+  }
+
+  votca::Index count = 0;
+  Property::StreamFromXML("test_stream.xml", "j*.?d*",
+                          [&count](Property&) { count++; });
+  BOOST_CHECK_EQUAL(count, 0);
+  Property::StreamFromXML("test_stream.xml", "*.job.id",
+                          [&count](Property&) { count++; });
+  BOOST_CHECK_EQUAL(count, 5);
+
+  BOOST_CHECK_THROW(Property::StreamFromXML("test_stream.xml", "jobs.job",
+                                            [](Property&) {
+                                              throw std::runtime_error("stop");
+                                            }),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(
+      Property::StreamFromXML("does_not_exist.xml", "jobs.job",
+                              [](Property&) {}),
+      std::ios_base::failure);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
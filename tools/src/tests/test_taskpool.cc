@@ -0,0 +1,157 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE taskpool_test
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/taskpool.h"
+#include "votca/tools/types.h"
+
+using namespace std;
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(taskpool_test)
+
+BOOST_AUTO_TEST_CASE(submit_test) {
+  TaskPool pool(2);
+  BOOST_CHECK_EQUAL(pool.ThreadCount(), 2);
+  std::vector<std::future<Index>> results;
+  for (Index i = 0; i < 100; ++i) {
+    results.push_back(pool.Submit([i]() { return i * i; }));
+  }
+  for (Index i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(results[i].get(), i * i);
+  }
+
+  std::future<void> failed =
+      pool.Submit([]() { throw std::runtime_error("task failed"); });
+  BOOST_CHECK_THROW(failed.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_test) {
+  TaskPool pool(3);
+  std::vector<Index> values(1000, 0);
+  pool.ParallelFor(0, Index(values.size()), [&values](Index i) {
+    values[i] = 2 * i;
+  });
+  for (Index i = 0; i < Index(values.size()); ++i) {
+    BOOST_CHECK_EQUAL(values[i], 2 * i);
+  }
+
+  // empty range and explicit grain
+  pool.ParallelFor(5, 5, [](Index) { throw std::runtime_error("called"); });
+  std::atomic<Index> sum{0};
+  pool.ParallelFor(0, 10, [&sum](Index i) { sum += i; }, 3);
+  BOOST_CHECK_EQUAL(sum.load(), 45);
+
+  BOOST_CHECK_THROW(pool.ParallelFor(0, 10,
+                                     [](Index i) {
+                                       if (i == 7) {
+                                         throw std::runtime_error("failed");
+                                       }
+                                     }),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(nested_test) {
+  // more outer tasks than threads, each waiting for an inner loop, must not
+  // deadlock because waiting threads execute pending tasks
+  TaskPool pool(2);
+  std::atomic<Index> count{0};
+  pool.ParallelFor(
+      0, 8,
+      [&pool, &count](Index) {
+        pool.ParallelFor(0, 50, [&count](Index) { count++; }, 1);
+      },
+      1);
+  BOOST_CHECK_EQUAL(count.load(), 400);
+}
+
+BOOST_AUTO_TEST_CASE(taskgroup_test) {
+  TaskPool pool(2);
+  std::atomic<Index> count{0};
+  {
+    TaskGroup group(pool);
+    for (Index i = 0; i < 20; ++i) {
+      group.Run([&count]() { count++; });
+    }
+    group.Wait();
+    BOOST_CHECK_EQUAL(count.load(), 20);
+    group.Run([]() { throw std::runtime_error("failed"); });
+    BOOST_CHECK_THROW(group.Wait(), std::runtime_error);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(blocking_wait_test) {
+  TaskPool pool(1);
+  std::atomic<bool> started{false};
+  TaskGroup group(pool);
+  group.Run([&started]() {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+  // the task runs on the worker, waiting for it must not use the cpu
+  std::clock_t start = std::clock();
+  group.Wait();
+  double cputime = double(std::clock() - start) / CLOCKS_PER_SEC;
+  BOOST_CHECK_LT(cputime, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(short_lived_groups_test) {
+  // groups are destroyed right after their last task finished, while the
+  // worker may still be notifying the waiter
+  TaskPool pool(4);
+  std::atomic<Index> count{0};
+  for (Index i = 0; i < 20000; ++i) {
+    TaskGroup group(pool);
+    group.Run([&count]() { count++; });
+    if (i % 2 == 0) {
+      group.Run([&count]() { count++; });
+    }
+  }
+  BOOST_CHECK_EQUAL(count.load(), 30000);
+  for (Index i = 0; i < 2000; ++i) {
+    pool.ParallelFor(0, 8, [&count](Index) { count++; }, 1);
+  }
+  BOOST_CHECK_EQUAL(count.load(), 46000);
+}
+
+BOOST_AUTO_TEST_CASE(global_test) {
+  TaskPool::setGlobalThreadCount(3);
+  BOOST_CHECK_EQUAL(TaskPool::Global().ThreadCount(), 3);
+  std::future<Index> result =
+      TaskPool::Global().Submit([]() { return Index(7); });
+  BOOST_CHECK_EQUAL(result.get(), 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
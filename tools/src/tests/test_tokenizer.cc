@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2020 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -156,4 +156,44 @@ BOOST_AUTO_TEST_CASE(fromstring) {
   BOOST_CHECK(s.isApprox(Eigen::Vector3i{3, 4, 5}));
 }
 
+BOOST_AUTO_TEST_CASE(viewtokenizer_test) {
+  string line = "  12 CA\t1.5e-1 -2 +3.25  ";
+  ViewTokenizer tok(line, " \t");
+  std::vector<std::string_view> words = tok.ToVector();
+  BOOST_REQUIRE_EQUAL(words.size(), 5);
+  BOOST_CHECK_EQUAL(words[0], "12");
+  BOOST_CHECK_EQUAL(words[1], "CA");
+  BOOST_CHECK_EQUAL(words[4], "+3.25");
+  // the words point into the original string
+  BOOST_CHECK(words[1].data() == line.data() + 5);
+
+  // same words as the boost based tokenizer
+  std::vector<std::string> reference = Tokenizer(line, " \t").ToVector();
+  BOOST_REQUIRE_EQUAL(reference.size(), words.size());
+  for (size_t i = 0; i < words.size(); ++i) {
+    BOOST_CHECK_EQUAL(reference[i], words[i]);
+  }
+
+  BOOST_CHECK(ViewTokenizer("", ",").begin() == ViewTokenizer("", ",").end());
+  BOOST_CHECK(ViewTokenizer(",,", ",").ToVector().empty());
+
+  std::vector<double> values;
+  ViewTokenizer("1.5 -2 +3.25 1e3", " ").ToVector(values);
+  BOOST_CHECK((values == std::vector<double>{1.5, -2.0, 3.25, 1000.0}));
+  // the vector is reused
+  ViewTokenizer("4", " ").ToVector(values);
+  BOOST_CHECK((values == std::vector<double>{4.0}));
+
+  std::vector<std::string> strings =
+      ViewTokenizer("a,b", ",").ToVector<std::string>();
+  BOOST_CHECK((strings == std::vector<std::string>{"a", "b"}));
+
+  BOOST_CHECK_EQUAL(convertFromStringView<votca::Index>("-42"), -42);
+  BOOST_CHECK_EQUAL(convertFromStringView<bool>("TRUE"), true);
+  BOOST_CHECK_EQUAL(convertFromStringView<bool>("0"), false);
+  BOOST_CHECK_THROW(convertFromStringView<int>("12a"), std::runtime_error);
+  BOOST_CHECK_THROW(convertFromStringView<double>(""), std::runtime_error);
+  BOOST_CHECK_THROW(convertFromStringView<bool>("yes"), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,9 @@
 #ifndef VOTCA_XTP_ERIS_H
 #define VOTCA_XTP_ERIS_H
 
+// Standard includes
+#include <cstdint>
+
 // Local VOTCA includes
 #include "threecenter.h"
 
@@ -38,6 +41,15 @@ class ERIs {
   void Initialize(const AOBasis& dftbasis, const AOBasis& auxbasis);
   void Initialize_4c(const AOBasis& dftbasis);
 
+  /**
+   * \brief Keeps the most expensive shell quartets in memory (semi-direct)
+   *
+   * The quartets are computed once and reused by all later calls of the 4c
+   * functions, all other quartets are still computed on the fly. Returns the
+   * memory in MB which is used, at most memory_MB.
+   */
+  double CacheIntegrals(double memory_MB);
+
   Eigen::MatrixXd CalculateERIs_3c(const Eigen::MatrixXd& DMAT) const;
 
   std::array<Eigen::MatrixXd, 2> CalculateERIs_EXX_3c(
@@ -82,11 +94,38 @@ class ERIs {
   Eigen::MatrixXd CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const;
   Eigen::MatrixXd CalculateEXX_mos(const Eigen::MatrixXd& occMos) const;
 
+  // number of aux functions processed at once for the exchange matrix
+  Index AuxBatchSize() const;
+  // whether the exchange matrix is built from sparse or from dense products
+  bool UseSparseExchange() const;
+  // dense matrices of aux functions start to start+size-1, side by side
+  void UnpackAuxBatch(Index start, Index size, Eigen::MatrixXd& batch) const;
+  // nonzeros of the sparse matrices of aux functions start to start+size-1,
+  // one column per aux function
+  void GatherAuxBatch(Index start, Index size, Eigen::MatrixXd& values) const;
+
   std::vector<std::vector<libint2::ShellPair>> ComputeShellPairData(
       const std::vector<libint2::Shell>& basis,
       const std::vector<std::vector<Index>>& shellpairs) const;
 
   Eigen::MatrixXd ComputeSchwarzShells(const AOBasis& dftbasis) const;
+
+  // calls func(pair, s2, s3, s4, sp12, sp34) for all quartets (s1 s2|s3 s4)
+  // of significant shell pairs, which are unique under permutation symmetry,
+  // pair is the position of s2 in shellpairs_[s1]
+  template <class Func>
+  void ForEachQuartet(Index s1, Func&& func) const;
+
+  // bra pairs (s1 s2) with s2 at the positions [begin, end) of
+  // shellpairs_[s1], whose quartets with all kets are built by one thread
+  struct FockTask {
+    Index s1;
+    Index begin;
+    Index end;
+    double cost;
+  };
+  // tasks of similar estimated cost, sorted from the most expensive one
+  std::vector<FockTask> PartitionFockTasks(Index nthreads) const;
   Eigen::MatrixXd ComputeShellBlockNorm(const Eigen::MatrixXd& dmat) const;
 
   template <bool with_exchange>
@@ -97,6 +136,27 @@ class ERIs {
 
   Eigen::MatrixXd schwarzscreen_;  // Square matrix containing <ab|ab> for all
                                    // shells
+
+  // integrals of the semi-direct mode, grouped by the bra pair and in the
+  // order in which Compute4c visits the kets
+  struct CachedQuartet {
+    enum class Storage : std::int32_t { zero, single, full };
+    std::int32_t s3;
+    std::int32_t s4;
+    Storage storage;
+    Index offset;
+  };
+  struct CachedShell {
+    // first quartet of every bra pair of the shell and the end
+    std::vector<Index> pair_start;
+    std::vector<CachedQuartet> quartets;
+    std::vector<double> values;
+    std::vector<float> values_single;
+  };
+  std::vector<CachedShell> cache_;
+  // quartets below it are not cached, blocks whose rounding error in single
+  // precision stays below it are stored as float
+  static constexpr double cache_threshold_ = 1e-12;
 };                                 // namespace xtp
 
 }  // namespace xtp
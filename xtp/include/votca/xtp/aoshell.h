@@ -132,6 +132,10 @@ class AOShell {
   };
 
   AOValues EvalAOspace(const Eigen::Vector3d& grid_pos) const;
+  // writes the values into existing storage, e.g. a segment of a larger vector
+  void EvalAOspace(const Eigen::Vector3d& grid_pos,
+                   Eigen::Ref<Eigen::VectorXd> AOvalues,
+                   Eigen::Ref<Eigen::MatrixX3d> gradAOvalues) const;
 
   // iterator over pairs (decay constant; contraction coefficient)
   using GaussianIterator = std::vector<AOGaussianPrimitive>::const_iterator;
@@ -54,6 +54,9 @@ class DensityIntegration {
 
  private:
   void SetupDensityContainer();
+  // weighted densities of a block of gridpoints of a box
+  Eigen::VectorXd CalcDensities(const GridBox& box, const GridboxRange& block,
+                                const Eigen::MatrixXd& DMAT_here) const;
   const Grid grid_;
 
   std::vector<std::vector<double> > densities_;
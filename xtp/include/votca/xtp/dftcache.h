@@ -0,0 +1,104 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_DFTCACHE_H
+#define VOTCA_XTP_DFTCACHE_H
+
+// Standard includes
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Local VOTCA includes
+#include "basisset.h"
+#include "ecpbasisset.h"
+#include "eigen.h"
+#include "grid_containers.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Process wide store of the geometry independent input of DFT runs
+ *
+ * eQM and iQM evaluate the same molecule in thousands of conformations, so
+ * basis sets and ECP libraries are read from their xml files and the pruned
+ * integration grids of the elements are built only once per process. The
+ * converged densities of the atomic guess can in addition be shared between
+ * processes via files in a directory. Names ending in .xml are files and are
+ * stored by their absolute path. All functions are thread safe, objects
+ * returned before Clear stay valid.
+ */
+class DFTCache {
+ public:
+  using ElementGrid = std::vector<GridContainers::Cartesian_gridpoint>;
+  static constexpr Index MaxElementGrids = 256;
+
+  static std::shared_ptr<const BasisSet> getBasisSet(const std::string& name);
+
+  static std::shared_ptr<const ECPBasisSet> getECPBasisSet(
+      const std::string& name);
+
+  /**
+   * \brief pruned grid of a single atom at the origin
+   *
+   * The grid is determined by the element, the grid type and the radial grid,
+   * whose extent depends on the basis set. build is only called if no such
+   * grid is stored yet. The extent also grows with the distances to the
+   * neighbouring atoms, rounded to whole bohr, so a few grids per element
+   * appear over many conformations. Only the last MaxElementGrids grids are
+   * kept.
+   */
+  static std::shared_ptr<const ElementGrid> getElementGrid(
+      const std::string& element, const std::string& gridtype,
+      const GridContainers::radial_grid& radial_grid,
+      const std::function<ElementGrid()>& build);
+
+  /**
+   * \brief converged density matrix of a single atom
+   *
+   * key has to contain everything the atomic calculation depends on. The
+   * density is looked up in memory and then, if directory is not empty, in
+   * the files written there by addAtomicDensity. Returns nullptr if it is not
+   * found.
+   */
+  static std::shared_ptr<const Eigen::MatrixXd> getAtomicDensity(
+      const std::string& key, const std::string& directory = "");
+
+  /**
+   * \brief stores the density of a single atom in memory and, if directory
+   * is not empty, in a file in it
+   *
+   * Files are written to a temporary name and renamed, so processes sharing
+   * the directory never read partial files. Returns false if the file could
+   * not be written.
+   */
+  static bool addAtomicDensity(const std::string& key,
+                               const Eigen::MatrixXd& dmat,
+                               const std::string& directory = "");
+
+  static void Clear();
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_DFTCACHE_H
@@ -30,6 +30,7 @@
 #include "ecpaobasis.h"
 #include "logger.h"
 #include "qmmolecule.h"
+#include "seminumerical_exchange.h"
 #include "staticsite.h"
 #include "vxc_grid.h"
 #include "vxc_potential.h"
@@ -100,6 +101,7 @@ class DFTEngine {
   Eigen::MatrixXd AtomicGuess(const QMMolecule& mol) const;
 
   Eigen::MatrixXd RunAtomicDFT_unrestricted(const QMAtom& uniqueAtom) const;
+  std::string AtomicDensityKey(const std::string& element) const;
 
   double NuclearRepulsion(const QMMolecule& mol) const;
   double ExternalRepulsion(
@@ -136,11 +138,16 @@ class DFTEngine {
 
   // numerical integration Vxc
   std::string grid_name_;
+  // memory in MB for AO values kept on the grid during the SCF
+  double ao_cache_memory_ = 0.0;
+  bool ao_cache_single_ = false;
 
   // AO Matrices
   AOOverlap dftAOoverlap_;
 
   std::string initial_guess_;
+  // directory in which atomic guess densities are shared between processes
+  std::string atomic_guess_cache_;
 
   // Convergence
   Index numofelectrons_ = 0;
@@ -150,6 +157,12 @@ class DFTEngine {
   ConvergenceAcc conv_accelerator_;
   // Electron repulsion integrals
   ERIs ERIs_;
+  // memory in MB for 4c integrals reused during the SCF
+  double eri_cache_memory_ = 0.0;
+  // ri, 4c or cosx
+  std::string exact_exchange_ = "auto";
+  double cosx_threshold_ = 1e-10;
+  std::unique_ptr<SeminumericalExchange> cosx_;
 
   // external charges
   std::vector<std::unique_ptr<StaticSite> >* externalsites_ = nullptr;
@@ -21,6 +21,10 @@
 #ifndef VOTCA_XTP_GRIDBOX_H
 #define VOTCA_XTP_GRIDBOX_H
 
+// Standard includes
+#include <array>
+#include <memory>
+
 // Local VOTCA includes
 #include "aoshell.h"
 #include "grid_containers.h"
@@ -35,8 +39,58 @@ struct GridboxRange {
 class GridBox {
 
  public:
+  // values and gradients of all significant AOs for a block of gridpoints,
+  // one row per gridpoint, so that densities and matrix elements of all
+  // points can be formed with matrix-matrix products
+  template <class T>
+  struct AOBlockT {
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> values;
+    std::array<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>, 3> derivatives;
+  };
+  using AOBlock = AOBlockT<double>;
+
   void FindSignificantShells(const AOBasis& basis);
   AOShell::AOValues CalcAOValues(const Eigen::Vector3d& point) const;
+  AOBlock CalcAOValues(const GridboxRange& points) const;
+
+  // splits the gridpoints into consecutive blocks of at most blocksize points,
+  // which bounds the memory of the AOBlocks of large boxes
+  std::vector<GridboxRange> getPointBlocks(
+      Index blocksize = default_blocksize) const;
+  static constexpr Index default_blocksize = 128;
+
+  /**
+   * \brief AO values of a block of gridpoints
+   *
+   * If the block is cached in double precision a reference to the cache is
+   * returned, otherwise buffer is filled from the single precision cache or
+   * by CalcAOValues and returned.
+   */
+  const AOBlock& getAOValues(const GridboxRange& points, AOBlock& buffer) const;
+
+  /**
+   * \brief computes and keeps the AO values of all blocks of getPointBlocks()
+   *
+   * The geometry and the grid do not change during a SCF, so the AO values
+   * can be reused by all integrations on this grid. Copies of the box share
+   * the cache.
+   */
+  void CacheAOValues(bool single_precision);
+  void ClearAOCache() { ao_cache_ = nullptr; }
+  bool hasAOCache() const { return ao_cache_ != nullptr; }
+  // memory in bytes needed to cache the AO values of this box
+  Index AOCacheSize(bool single_precision) const {
+    return 4 * size() * Matrixsize() *
+           Index(single_precision ? sizeof(float) : sizeof(double));
+  }
+
+  /**
+   * \brief caches the AO values of boxes until max_memory is used up
+   *
+   * Boxes are filled in order, returns the memory in MB actually used.
+   */
+  static double CacheAOValues(std::vector<GridBox>& boxes, double max_memory,
+                              bool single_precision);
 
   const std::vector<Eigen::Vector3d>& getGridPoints() const { return grid_pos; }
 
@@ -102,6 +156,12 @@ class GridBox {
   std::vector<Eigen::Vector3d> grid_pos;
   std::vector<const AOShell*> significant_shells;
   std::vector<double> weights;
+
+  struct AOCache {
+    std::vector<AOBlock> blocks;
+    std::vector<AOBlockT<float>> blocks_single;
+  };
+  std::shared_ptr<const AOCache> ao_cache_ = nullptr;
 };
 
 }  // namespace xtp
@@ -0,0 +1,87 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_SEMINUMERICAL_EXCHANGE_H
+#define VOTCA_XTP_SEMINUMERICAL_EXCHANGE_H
+
+// Local VOTCA includes
+#include "aobasis.h"
+#include "eigen.h"
+#include "vxc_grid.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Exchange matrix of hybrid functionals integrated seminumerically
+ * (chain of spheres) on the Vxc grid
+ *
+ * One electron of (mu lambda|nu sigma) is integrated on the grid and the
+ * other one analytically via the potential integrals of a unit charge at
+ * each gridpoint:
+ * K_mu,nu = -sum_g w_g phi_mu(g) sum_sigma A_nu,sigma(g) F_sigma(g) with
+ * F_sigma(g) = sum_lambda phi_lambda(g) D_lambda,sigma.
+ * Shells sigma whose F is negligible on the points of a block and points
+ * which do not contribute are skipped, so the cost grows about linearly with
+ * the molecule. The AO values are taken from the cache of the grid.
+ */
+class SeminumericalExchange {
+ public:
+  SeminumericalExchange(const Vxc_Grid& grid, const AOBasis& basis,
+                        double threshold);
+
+  // same sign and normalisation as ERIs::CalculateERIs_EXX_3c
+  Eigen::MatrixXd IntegrateEXX(const Eigen::MatrixXd& DMAT) const;
+
+ private:
+  // shells and the first row of each of them in a compressed matrix
+  struct ShellSelection {
+    std::vector<Index> shells;
+    std::vector<Index> start;
+    Index size = 0;
+  };
+
+  void addShell(ShellSelection& selection, Index shell) const;
+
+  /**
+   * \brief G(rows,g) = -sum_cols A_rows,cols(g) F(cols,g) for all points g
+   *
+   * F and G hold one column per point, pairs contains for every shell of
+   * rows the positions of the shells of cols with which it overlaps.
+   */
+  Eigen::MatrixXd ContractPotentials(
+      const std::vector<Eigen::Vector3d>& points, const Eigen::MatrixXd& F,
+      const ShellSelection& rows, const ShellSelection& cols,
+      const std::vector<std::vector<Index>>& pairs) const;
+
+  const Vxc_Grid grid_;
+  double threshold_;
+  std::vector<libint2::Shell> shells_;
+  std::vector<Index> starts_;
+  // all shells with which a shell overlaps, including itself
+  std::vector<std::vector<Index>> neighbours_;
+  Index maxnprim_;
+  Index maxL_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_SEMINUMERICAL_EXCHANGE_H
@@ -49,18 +49,72 @@ class TCMatrix {
   Eigen::MatrixXd inv_sqrt_;
 };
 
+/**
+ * \brief three center integrals (P|mu nu) of all aux functions P in one
+ * contiguous matrix
+ *
+ * Column P holds the lower triangle of the symmetric dft basis matrix of aux
+ * function P, packed rowwise. Only the shell pairs found by
+ * AOBasis::ComputeShellPairs are stored, so each row of the triangle is a
+ * list of segments and the memory grows about linearly with the size of
+ * extended molecules. Coulomb and exchange matrices are then products with
+ * the whole tensor or with the sparse matrices of blocks of aux functions.
+ */
 class TCMatrix_dft final : public TCMatrix {
  public:
+  // elements (row,col) to (row,col+size-1) of the lower triangle are stored
+  // in the rows start to start+size-1 of Matrix()
+  struct Segment {
+    Index row;
+    Index col;
+    Index size;
+    Index start;
+  };
+
+  // nonzeros of the full symmetric dft basis matrices in compressed column
+  // storage, nonzero k is stored in row position[k] of Matrix()
+  struct SparsityPattern {
+    std::vector<Index> outer;
+    std::vector<Index> inner;
+    std::vector<Index> position;
+  };
+
   void Fill(const AOBasis& auxbasis, const AOBasis& dftbasis);
 
-  Index size() const { return Index(matrix_.size()); }
+  // number of aux functions
+  Index size() const { return matrix_.cols(); }
+
+  Index dftsize() const { return dftsize_; }
 
-  Symmetric_Matrix& operator[](Index i) { return matrix_[i]; }
+  const Eigen::MatrixXd& Matrix() const { return matrix_; }
 
-  const Symmetric_Matrix& operator[](Index i) const { return matrix_[i]; }
+  const std::vector<Segment>& Segments() const { return segments_; }
+
+  const SparsityPattern& Pattern() const { return pattern_; }
+
+  // symmetric dft basis matrix of aux function i
+  Eigen::MatrixXd FullMatrix(Index i) const {
+    Eigen::MatrixXd result(dftsize_, dftsize_);
+    Unpack(matrix_.col(i), result);
+    return result;
+  }
+
+  // packs a symmetric matrix like the columns of the tensor, offdiagonal
+  // elements are multiplied by offdiag_factor
+  Eigen::VectorXd Pack(const Eigen::MatrixXd& full,
+                       double offdiag_factor = 1.0) const;
+
+  // elements of shell pairs which are not stored are set to zero
+  void Unpack(const Eigen::Ref<const Eigen::VectorXd>& packed,
+              Eigen::Ref<Eigen::MatrixXd> full) const;
 
  private:
-  std::vector<Symmetric_Matrix> matrix_;
+  Eigen::MatrixXd matrix_;
+  Index dftsize_ = 0;
+  std::vector<Segment> segments_;
+  SparsityPattern pattern_;
+
+  void BuildSparsityPattern();
 
   void FillBlock(std::vector<Eigen::MatrixXd>& block, Index shellindex,
                  const AOBasis& dftbasis, const AOBasis& auxbasis);
@@ -22,11 +22,13 @@
 #define VOTCA_XTP_VXC_GRID_H
 
 // Local VOTCA includes
+#include "dftcache.h"
 #include "grid_containers.h"
 #include "gridbox.h"
 
 namespace votca {
 namespace xtp {
+class EulerMaclaurinGrid;
 class LebedevGrid;
 class QMMolecule;
 class aobasis;
@@ -41,6 +43,12 @@ class Vxc_Grid {
   Index getGridSize() const { return totalgridsize_; }
   Index getBoxesSize() const { return Index(grid_boxes_.size()); }
 
+  // keeps the AO values of the boxes for all following integrations on this
+  // grid, max_memory in MB, returns the memory used
+  double CacheAOValues(double max_memory, bool single_precision) {
+    return GridBox::CacheAOValues(grid_boxes_, max_memory, single_precision);
+  }
+
   const GridBox& operator[](Index index) const { return grid_boxes_[index]; }
   GridBox& operator[](Index index) { return grid_boxes_[index]; }
 
@@ -65,25 +73,32 @@ class Vxc_Grid {
       const std::vector<std::vector<GridContainers::Cartesian_gridpoint> >&
           grid);
 
-  Eigen::MatrixXd CalcInverseAtomDist(const QMMolecule& atoms) const;
+  // all other atoms of each atom as pairs of (distance, index), sorted by
+  // distance
+  using NeighbourList = std::vector<std::vector<std::pair<double, Index> > >;
+  NeighbourList CalcNeighbourList(const QMMolecule& atoms) const;
+
   Index UpdateOrder(LebedevGrid& sphericalgridofElement, Index maxorder,
                     std::vector<double>& PruningIntervals, double r) const;
 
+  DFTCache::ElementGrid BuildElementGrid(
+      const std::string& type, const std::string& element,
+      const GridContainers::radial_grid& radial_grid,
+      EulerMaclaurinGrid& radialgridofElement) const;
+
   GridContainers::Cartesian_gridpoint CreateCartesianGridpoint(
       const Eigen::Vector3d& atomA_pos,
-      GridContainers::radial_grid& radial_grid,
-      GridContainers::spherical_grid& spherical_grid, Index i_rad,
+      const GridContainers::radial_grid& radial_grid,
+      const GridContainers::spherical_grid& spherical_grid, Index i_rad,
       Index i_sph) const;
 
-  Eigen::VectorXd SSWpartition(const Eigen::VectorXd& rq_i,
-                               const Eigen::MatrixXd& Rij) const;
-  void SSWpartitionAtom(
-      const QMMolecule& atoms,
-      std::vector<GridContainers::Cartesian_gridpoint>& atomgrid, Index i_atom,
-      const Eigen::MatrixXd& Rij) const;
-  Eigen::MatrixXd CalcDistanceAtomsGridpoints(
-      const QMMolecule& atoms,
-      std::vector<GridContainers::Cartesian_gridpoint>& atomgrid) const;
+  double SSWstep(double mu) const;
+  double SSWpartitionProduct(const Eigen::Vector3d& point, Index i_atom,
+                             double r_i, const QMMolecule& atoms,
+                             const NeighbourList& neighbours) const;
+  double SSWpartitionWeight(const Eigen::Vector3d& point, Index i_atom,
+                            const QMMolecule& atoms,
+                            const NeighbourList& neighbours) const;
 
   Index totalgridsize_;
   std::vector<GridBox> grid_boxes_;
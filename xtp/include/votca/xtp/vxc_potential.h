@@ -44,14 +44,17 @@ class Vxc_Potential {
   Mat_p_Energy IntegrateVXC(const Eigen::MatrixXd& density_matrix) const;
 
  private:
+  // values of the functional for all points of a block
   struct XC_entry {
-    double f_xc = 0;  // E_xc[n] = int{n(r)*eps_xc[n(r)] d3r} = int{ f_xc(r) d3r
-    double df_drho = 0;    // v_xc_rho(r) = df/drho
-    double df_dsigma = 0;  // df/dsigma ( df/dgrad(rho) = df/dsigma *
-                           // dsigma/dgrad(rho) = df/dsigma * 2*grad(rho))
+    Eigen::VectorXd f_xc;  // E_xc[n] = int{n(r)*eps_xc[n(r)] d3r} = int{
+                           // f_xc(r) d3r
+    Eigen::VectorXd df_drho;    // v_xc_rho(r) = df/drho
+    Eigen::VectorXd df_dsigma;  // df/dsigma ( df/dgrad(rho) = df/dsigma *
+                                // dsigma/dgrad(rho) = df/dsigma * 2*grad(rho))
   };
 
-  XC_entry EvaluateXC(double rho, double sigma) const;
+  XC_entry EvaluateXC(const Eigen::VectorXd& rho,
+                      const Eigen::VectorXd& sigma) const;
 
   const Grid grid_;
   int xfunc_id;
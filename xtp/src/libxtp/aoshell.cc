@@ -89,13 +89,20 @@ void AOShell::normalizeContraction() {
 }
 
 AOShell::AOValues AOShell::EvalAOspace(const Eigen::Vector3d& grid_pos) const {
+  AOShell::AOValues AO(getNumFunc());
+  EvalAOspace(grid_pos, AO.values, AO.derivatives);
+  return AO;
+}
+
+void AOShell::EvalAOspace(const Eigen::Vector3d& grid_pos,
+                          Eigen::Ref<Eigen::VectorXd> AOvalues,
+                          Eigen::Ref<Eigen::MatrixX3d> gradAOvalues) const {
 
   // need position of shell
   const Eigen::Vector3d center = (grid_pos - pos_);
   const double distsq = center.squaredNorm();
-  AOShell::AOValues AO(getNumFunc());
-  Eigen::VectorXd& AOvalues = AO.values;
-  Eigen::MatrixX3d& gradAOvalues = AO.derivatives;
+  AOvalues.setZero();
+  gradAOvalues.setZero();
 
   // iterate over Gaussians in this shell
   for (const AOGaussianPrimitive& gaussian : gaussians_) {
@@ -300,7 +307,7 @@ AOShell::AOValues AOShell::EvalAOspace(const Eigen::Vector3d& grid_pos) const {
         break;
     }
   }  // contractions
-  return AO;
+  return;
 }
 
 std::ostream& operator<<(std::ostream& out, const AOShell& shell) {
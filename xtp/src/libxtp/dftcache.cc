@@ -0,0 +1,243 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <tuple>
+
+// Local VOTCA includes
+#include "votca/xtp/dftcache.h"
+
+namespace votca {
+namespace xtp {
+
+namespace {
+
+std::mutex cache_mutex;
+std::map<std::string, std::shared_ptr<const BasisSet> > basissets;
+std::map<std::string, std::shared_ptr<const ECPBasisSet> > ecpbasissets;
+// element, grid type, number of radial points and largest radius
+using ElementGridKey = std::tuple<std::string, std::string, Index, double>;
+std::map<ElementGridKey, std::shared_ptr<const DFTCache::ElementGrid> >
+    elementgrids;
+// keys of elementgrids, oldest first
+std::deque<ElementGridKey> elementgrid_order;
+
+std::map<std::string, std::shared_ptr<const Eigen::MatrixXd> > atomicdensities;
+
+const std::string atomicdensity_header = "votca atomic density";
+
+std::string CacheKey(const std::string& name) {
+  if (name.find(".xml") != std::string::npos) {
+    return std::filesystem::absolute(name).lexically_normal().string();
+  }
+  return name;
+}
+
+template <class T>
+std::shared_ptr<const T> LoadOnce(
+    std::map<std::string, std::shared_ptr<const T> >& cache,
+    const std::string& name) {
+  const std::string key = CacheKey(name);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+  // parse outside of the lock, if two threads load the same file the first
+  // one wins
+  auto loaded = std::make_shared<T>();
+  loaded->Load(name);
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return cache.try_emplace(key, loaded).first->second;
+}
+
+// file names must be the same for all processes and builds, so a fixed hash
+// (FNV-1a) is used instead of std::hash
+std::string AtomicDensityFile(const std::string& key,
+                              const std::string& directory) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (char c : key) {
+    hash ^= std::uint64_t(static_cast<unsigned char>(c));
+    hash *= 1099511628211ULL;
+  }
+  std::stringstream name;
+  name << "atomicdensity_" << std::hex << std::setw(16) << std::setfill('0')
+       << hash << ".dat";
+  return (std::filesystem::path(directory) / name.str()).string();
+}
+
+std::shared_ptr<const Eigen::MatrixXd> ReadAtomicDensity(
+    const std::string& key, const std::string& filename) {
+  std::ifstream in(filename);
+  if (!in.is_open()) {
+    return nullptr;
+  }
+  std::string header;
+  std::string filekey;
+  Index rows = 0;
+  Index cols = 0;
+  std::getline(in, header);
+  std::getline(in, filekey);
+  in >> rows >> cols;
+  // other key with the same hash or file from another version
+  if (!in || header != atomicdensity_header || filekey != key || rows < 1 ||
+      cols < 1) {
+    return nullptr;
+  }
+  auto dmat = std::make_shared<Eigen::MatrixXd>(rows, cols);
+  for (Index i = 0; i < dmat->size(); ++i) {
+    in >> dmat->data()[i];
+  }
+  if (!in) {
+    return nullptr;
+  }
+  return dmat;
+}
+
+bool WriteAtomicDensity(const std::string& key, const Eigen::MatrixXd& dmat,
+                        const std::string& filename) {
+  std::error_code error;
+  std::filesystem::path path(filename);
+  std::filesystem::create_directories(path.parent_path(), error);
+  std::random_device random;
+  std::filesystem::path tmp =
+      path.string() + ".tmp" + std::to_string(random());
+  {
+    std::ofstream out(tmp);
+    if (!out.is_open()) {
+      return false;
+    }
+    out << atomicdensity_header << "\n" << key << "\n"
+        << dmat.rows() << " " << dmat.cols() << "\n";
+    out << std::setprecision(17);
+    for (Index i = 0; i < dmat.size(); ++i) {
+      out << dmat.data()[i] << "\n";
+    }
+    if (!out) {
+      out.close();
+      std::filesystem::remove(tmp, error);
+      return false;
+    }
+  }
+  std::filesystem::rename(tmp, path, error);
+  if (error) {
+    std::filesystem::remove(tmp, error);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::shared_ptr<const BasisSet> DFTCache::getBasisSet(
+    const std::string& name) {
+  return LoadOnce(basissets, name);
+}
+
+std::shared_ptr<const ECPBasisSet> DFTCache::getECPBasisSet(
+    const std::string& name) {
+  return LoadOnce(ecpbasissets, name);
+}
+
+std::shared_ptr<const DFTCache::ElementGrid> DFTCache::getElementGrid(
+    const std::string& element, const std::string& gridtype,
+    const GridContainers::radial_grid& radial_grid,
+    const std::function<ElementGrid()>& build) {
+  const Index size = radial_grid.radius.size();
+  ElementGridKey key(element, gridtype, size,
+                     (size > 0) ? radial_grid.radius.maxCoeff() : 0.0);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = elementgrids.find(key);
+    if (it != elementgrids.end()) {
+      return it->second;
+    }
+  }
+  // build outside of the lock, so threads setting up different grids do not
+  // wait for each other, if two threads build the same grid the first wins
+  auto grid = std::make_shared<const ElementGrid>(build());
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto [it, inserted] = elementgrids.try_emplace(key, grid);
+  if (inserted) {
+    elementgrid_order.push_back(key);
+    // the radial extent depends on the geometry, drop the oldest grids
+    if (Index(elementgrid_order.size()) > MaxElementGrids) {
+      elementgrids.erase(elementgrid_order.front());
+      elementgrid_order.pop_front();
+    }
+  }
+  return it->second;
+}
+
+std::shared_ptr<const Eigen::MatrixXd> DFTCache::getAtomicDensity(
+    const std::string& key, const std::string& directory) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = atomicdensities.find(key);
+    if (it != atomicdensities.end()) {
+      return it->second;
+    }
+  }
+  if (directory.empty()) {
+    return nullptr;
+  }
+  std::shared_ptr<const Eigen::MatrixXd> dmat =
+      ReadAtomicDensity(key, AtomicDensityFile(key, directory));
+  if (dmat) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return atomicdensities.try_emplace(key, dmat).first->second;
+  }
+  return nullptr;
+}
+
+bool DFTCache::addAtomicDensity(const std::string& key,
+                                const Eigen::MatrixXd& dmat,
+                                const std::string& directory) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    atomicdensities[key] = std::make_shared<const Eigen::MatrixXd>(dmat);
+  }
+  if (directory.empty()) {
+    return true;
+  }
+  return WriteAtomicDensity(key, dmat, AtomicDensityFile(key, directory));
+}
+
+void DFTCache::Clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  basissets.clear();
+  ecpbasissets.clear();
+  elementgrids.clear();
+  elementgrid_order.clear();
+  atomicdensities.clear();
+}
+
+}  // namespace xtp
+}  // namespace votca
@@ -17,13 +17,32 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+
+// Third party includes
+#include <Eigen/Sparse>
+
 // Local VOTCA includes
 #include "votca/xtp/ERIs.h"
 #include "votca/xtp/aobasis.h"
-#include "votca/xtp/symmetric_matrix.h"
 namespace votca {
 namespace xtp {
 
+namespace {
+using SparseMap =
+    Eigen::Map<const Eigen::SparseMatrix<double, Eigen::ColMajor, Index>>;
+
+// sparse dft basis matrix of aux function i of a batch
+SparseMap AuxMatrix(const TCMatrix_dft& threecenter,
+                    const Eigen::MatrixXd& values, Index i) {
+  const TCMatrix_dft::SparsityPattern& pattern = threecenter.Pattern();
+  return SparseMap(threecenter.dftsize(), threecenter.dftsize(),
+                   values.rows(), pattern.outer.data(), pattern.inner.data(),
+                   values.col(i).data());
+}
+}  // namespace
+
 void ERIs::Initialize(const AOBasis& dftbasis, const AOBasis& auxbasis) {
   threecenter_.Fill(auxbasis, dftbasis);
   return;
@@ -31,6 +50,7 @@ void ERIs::Initialize(const AOBasis& dftbasis, const AOBasis& auxbasis) {
 
 void ERIs::Initialize_4c(const AOBasis& dftbasis) {
 
+  cache_.clear();
   basis_ = dftbasis.GenerateLibintBasis();
   shellpairs_ = dftbasis.ComputeShellPairs();
   starts_ = dftbasis.getMapToBasisFunctions();
@@ -80,31 +100,127 @@ Eigen::MatrixXd ERIs::ComputeShellBlockNorm(const Eigen::MatrixXd& dmat) const {
 Eigen::MatrixXd ERIs::CalculateERIs_3c(const Eigen::MatrixXd& DMAT) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd ERIs2 = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
-  Symmetric_Matrix dmat_sym = Symmetric_Matrix(DMAT);
-#pragma omp parallel for schedule(guided) reduction(+ : ERIs2)
-  for (Index i = 0; i < threecenter_.size(); i++) {
-    const Symmetric_Matrix& threecenter = threecenter_[i];
-    // Trace over prod::DMAT,I(l)=componentwise product over
-    const double factor = threecenter.TraceofProd(dmat_sym);
-    Eigen::SelfAdjointView<Eigen::MatrixXd, Eigen::Upper> m =
-        ERIs2.selfadjointView<Eigen::Upper>();
-    threecenter.AddtoEigenUpperMatrix(m, factor);
+  const Eigen::MatrixXd& tc = threecenter_.Matrix();
+  // offdiagonal elements appear twice in the trace
+  const Eigen::VectorXd dmat_packed = threecenter_.Pack(DMAT, 2.0);
+  Eigen::VectorXd fit(tc.cols());
+  Eigen::VectorXd ERIs_packed(tc.rows());
+  // Eigen does not parallelize matrix vector products, so each thread
+  // computes a contiguous part of the result
+  const Index nchunks = OPENMP::getMaxThreads();
+#pragma omp parallel for schedule(static)
+  for (Index chunk = 0; chunk < nchunks; chunk++) {
+    Index size = (tc.cols() + nchunks - 1) / nchunks;
+    Index start = std::min(tc.cols(), chunk * size);
+    size = std::min(size, tc.cols() - start);
+    fit.segment(start, size).noalias() =
+        tc.middleCols(start, size).transpose() * dmat_packed;
+  }
+#pragma omp parallel for schedule(static)
+  for (Index chunk = 0; chunk < nchunks; chunk++) {
+    Index size = (tc.rows() + nchunks - 1) / nchunks;
+    Index start = std::min(tc.rows(), chunk * size);
+    size = std::min(size, tc.rows() - start);
+    ERIs_packed.segment(start, size).noalias() =
+        tc.middleRows(start, size) * fit;
+  }
+  Eigen::MatrixXd ERIs2(DMAT.rows(), DMAT.cols());
+  threecenter_.Unpack(ERIs_packed, ERIs2);
+  return ERIs2;
+}
+
+Index ERIs::AuxBatchSize() const {
+  // the dense exchange keeps three dftsize x dftsize blocks per aux function
+  // of a batch (the unpacked batch, D times it and the reordered copy W).
+  // Each of the three matrices is limited to about 64 MB, so about 192 MB
+  // in total
+  const Index max_elements = Index(1) << 23;
+  const Index dftsize = threecenter_.dftsize();
+  Index batchsize = max_elements / std::max(Index(1), dftsize * dftsize);
+  return std::clamp(batchsize, Index(1), threecenter_.size());
+}
+
+bool ERIs::UseSparseExchange() const {
+  // products with sparse matrices take about four times longer per nonzero
+  // than dense matrix products per element
+  const double dftsize = double(threecenter_.dftsize());
+  return double(threecenter_.Pattern().inner.size()) <
+         0.25 * dftsize * dftsize;
+}
+
+void ERIs::UnpackAuxBatch(Index start, Index size,
+                          Eigen::MatrixXd& batch) const {
+  const Index dftsize = threecenter_.dftsize();
+  batch.resize(dftsize, size * dftsize);
+#pragma omp parallel for schedule(static)
+  for (Index i = 0; i < size; i++) {
+    threecenter_.Unpack(threecenter_.Matrix().col(start + i),
+                        batch.middleCols(i * dftsize, dftsize));
   }
+}
 
-  return ERIs2.selfadjointView<Eigen::Upper>();
+void ERIs::GatherAuxBatch(Index start, Index size,
+                          Eigen::MatrixXd& values) const {
+  const std::vector<Index>& position = threecenter_.Pattern().position;
+  values.resize(Index(position.size()), size);
+#pragma omp parallel for schedule(static)
+  for (Index i = 0; i < size; i++) {
+    const double* packed = threecenter_.Matrix().col(start + i).data();
+    for (Index k = 0; k < values.rows(); k++) {
+      values(k, i) = packed[position[k]];
+    }
+  }
 }
 
 Eigen::MatrixXd ERIs::CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
+  const Index dftsize = threecenter_.dftsize();
   Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
-
-#pragma omp parallel for schedule(guided) reduction(+ : EXX)
-  for (Index i = 0; i < threecenter_.size(); i++) {
-    const Eigen::MatrixXd threecenter = threecenter_[i].UpperMatrix();
-    EXX -= threecenter.selfadjointView<Eigen::Upper>() * DMAT *
-           threecenter.selfadjointView<Eigen::Upper>();
+  const Index batchsize = AuxBatchSize();
+  const bool sparse = UseSparseExchange();
+  const Index nchunks = OPENMP::getMaxThreads();
+  Eigen::MatrixXd batch;
+  Eigen::MatrixXd W;
+  for (Index start = 0; start < threecenter_.size(); start += batchsize) {
+    const Index size = std::min(batchsize, threecenter_.size() - start);
+    if (sparse) {
+      // B_P*D*B_P = (D*B_P)^T*B_P, so only products of dense matrices with
+      // the sparse B_P from the right are needed, which Eigen does column by
+      // column
+      GatherAuxBatch(start, size, batch);
+      W.resize(dftsize, size * dftsize);
+#pragma omp parallel for schedule(static)
+      for (Index i = 0; i < size; i++) {
+        const Eigen::MatrixXd DxB = DMAT * AuxMatrix(threecenter_, batch, i);
+        W.middleCols(i * dftsize, dftsize) = DxB.transpose();
+      }
+      // the columns of EXX are split between threads, so that no thread
+      // needs a copy of EXX
+#pragma omp parallel for schedule(static)
+      for (Index chunk = 0; chunk < nchunks; chunk++) {
+        Index cols = (dftsize + nchunks - 1) / nchunks;
+        Index col = std::min(dftsize, chunk * cols);
+        cols = std::min(cols, dftsize - col);
+        for (Index i = 0; i < size; i++) {
+          EXX.middleCols(col, cols).noalias() -=
+              W.middleCols(i * dftsize, dftsize) *
+              AuxMatrix(threecenter_, batch, i).middleCols(col, cols);
+        }
+      }
+    } else {
+      // with the batch H = [B_1, B_2, ...] and the blocks D*B_P of D*H
+      // stacked vertically into W, sum_P B_P*D*B_P = H*W
+      UnpackAuxBatch(start, size, batch);
+      const Eigen::MatrixXd DxB = DMAT * batch;
+      W.resize(size * dftsize, dftsize);
+#pragma omp parallel for schedule(static)
+      for (Index i = 0; i < size; i++) {
+        W.middleRows(i * dftsize, dftsize) =
+            DxB.middleCols(i * dftsize, dftsize);
+      }
+      EXX.noalias() -= batch * W;
+    }
   }
   return EXX;
 }
@@ -112,14 +228,35 @@ Eigen::MatrixXd ERIs::CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const {
 Eigen::MatrixXd ERIs::CalculateEXX_mos(const Eigen::MatrixXd& occMos) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
+  const Index dftsize = threecenter_.dftsize();
+  const Index nocc = occMos.cols();
   Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(occMos.rows(), occMos.rows());
-
-#pragma omp parallel for schedule(guided) reduction(+ : EXX)
-  for (Index i = 0; i < threecenter_.size(); i++) {
-    const Eigen::MatrixXd TCxMOs_T =
-        occMos.transpose() *
-        threecenter_[i].UpperMatrix().selfadjointView<Eigen::Upper>();
-    EXX -= TCxMOs_T.transpose() * TCxMOs_T;
+  const Index batchsize = AuxBatchSize();
+  const bool sparse = UseSparseExchange();
+  // with the products C^T*B_P of a batch stacked vertically into Z,
+  // sum_P B_P*C*C^T*B_P = Z^T*Z
+  const Eigen::MatrixXd occMos_T = occMos.transpose();
+  Eigen::MatrixXd batch;
+  Eigen::MatrixXd Z;
+  for (Index start = 0; start < threecenter_.size(); start += batchsize) {
+    const Index size = std::min(batchsize, threecenter_.size() - start);
+    Z.resize(size * nocc, dftsize);
+    if (sparse) {
+      GatherAuxBatch(start, size, batch);
+#pragma omp parallel for schedule(static)
+      for (Index i = 0; i < size; i++) {
+        Z.middleRows(i * nocc, nocc).noalias() =
+            occMos_T * AuxMatrix(threecenter_, batch, i);
+      }
+    } else {
+      UnpackAuxBatch(start, size, batch);
+      const Eigen::MatrixXd CxB = occMos_T * batch;
+#pragma omp parallel for schedule(static)
+      for (Index i = 0; i < size; i++) {
+        Z.middleRows(i * nocc, nocc) = CxB.middleCols(i * dftsize, dftsize);
+      }
+    }
+    EXX.noalias() -= Z.transpose() * Z;
   }
   return 2 * EXX;
 }
@@ -33,6 +33,7 @@
 #include "votca/xtp/aomatrix.h"
 #include "votca/xtp/aopotential.h"
 #include "votca/xtp/density_integration.h"
+#include "votca/xtp/dftcache.h"
 #include "votca/xtp/dftengine.h"
 #include "votca/xtp/eeinteractor.h"
 #include "votca/xtp/logger.h"
@@ -62,8 +63,37 @@ void DFTEngine::Initialize(tools::Property& options) {
   }
 
   initial_guess_ = options.get(".initial_guess").as<std::string>();
+  if (options.exists(key_xtpdft + ".atomic_guess_cache")) {
+    atomic_guess_cache_ =
+        options.get(key_xtpdft + ".atomic_guess_cache").as<std::string>();
+  }
 
   grid_name_ = options.get(key_xtpdft + ".integration_grid").as<std::string>();
+  if (options.exists(key_xtpdft + ".ao_cache")) {
+    ao_cache_memory_ =
+        options.get(key_xtpdft + ".ao_cache.memory").as<double>();
+    ao_cache_single_ =
+        options.get(key_xtpdft + ".ao_cache.precision").as<std::string>() ==
+        "single";
+  }
+  if (options.exists(key_xtpdft + ".exact_exchange")) {
+    exact_exchange_ =
+        options.get(key_xtpdft + ".exact_exchange").as<std::string>();
+  }
+  if (exact_exchange_ == "auto") {
+    exact_exchange_ = auxbasis_name_.empty() ? "4c" : "ri";
+  } else if (exact_exchange_ == "ri" && auxbasis_name_.empty()) {
+    throw std::runtime_error(
+        "RI exact exchange requires an auxbasisset, use 4c or cosx instead");
+  }
+  if (options.exists(key_xtpdft + ".eri_cache_memory")) {
+    eri_cache_memory_ =
+        options.get(key_xtpdft + ".eri_cache_memory").as<double>();
+  }
+  if (options.exists(key_xtpdft + ".cosx_threshold")) {
+    cosx_threshold_ =
+        options.get(key_xtpdft + ".cosx_threshold").as<double>();
+  }
   xc_functional_name_ = options.get(".functional").as<std::string>();
 
   if (options.exists(key_xtpdft + ".externaldensity")) {
@@ -159,7 +189,9 @@ void DFTEngine::CalcElDipole(const Orbitals& orb) const {
 std::array<Eigen::MatrixXd, 2> DFTEngine::CalcERIs_EXX(
     const Eigen::MatrixXd& MOCoeff, const Eigen::MatrixXd& Dmat,
     double error) const {
-  if (!auxbasis_name_.empty()) {
+  if (exact_exchange_ == "cosx") {
+    return {CalcERIs(Dmat, error), cosx_->IntegrateEXX(Dmat)};
+  } else if (exact_exchange_ == "ri") {
     if (conv_accelerator_.getUseMixing() || MOCoeff.rows() == 0) {
       return ERIs_.CalculateERIs_EXX_3c(Eigen::MatrixXd::Zero(0, 0), Dmat);
     } else {
@@ -495,17 +527,39 @@ void DFTEngine::SetupInvariantMatrices() {
         << TimeStamp()
         << " Setup invariant parts of Electron Repulsion integrals "
         << std::flush;
-  } else {
+  }
+  if (auxbasis_name_.empty() || exact_exchange_ == "4c") {
     XTP_LOG(Log::info, *pLog_)
         << TimeStamp() << " Calculating 4c diagonals. " << std::flush;
     ERIs_.Initialize_4c(dftbasis_);
     XTP_LOG(Log::info, *pLog_)
         << TimeStamp() << " Calculated 4c diagonals. " << std::flush;
+    if (eri_cache_memory_ > 0) {
+      double cache_memory = ERIs_.CacheIntegrals(eri_cache_memory_);
+      XTP_LOG(Log::info, *pLog_)
+          << TimeStamp() << " Kept 4c integrals in memory using "
+          << cache_memory << " MB" << std::flush;
+    }
   }
 
   return;
 }
 
+std::string DFTEngine::AtomicDensityKey(const std::string& element) const {
+  bool with_ecp = !ecp_name_.empty();
+  if (element == "H" || element == "He") {
+    with_ecp = false;
+  }
+  // everything RunAtomicDFT_unrestricted depends on
+  std::stringstream key;
+  key << std::setprecision(17) << element << " basis:" << dftbasis_name_
+      << " ecp:" << (with_ecp ? ecp_name_ : "")
+      << " functional:" << xc_functional_name_ << " grid:" << grid_name_
+      << " energy:" << conv_opt_.Econverged
+      << " error:" << conv_opt_.error_converged << " iter:" << max_iter_;
+  return key.str();
+}
+
 Eigen::MatrixXd DFTEngine::RunAtomicDFT_unrestricted(
     const QMAtom& uniqueAtom) const {
   bool with_ecp = !ecp_name_.empty();
@@ -516,20 +570,19 @@ Eigen::MatrixXd DFTEngine::RunAtomicDFT_unrestricted(
   QMMolecule atom = QMMolecule("individual_atom", 0);
   atom.push_back(uniqueAtom);
 
-  BasisSet basisset;
-  basisset.Load(dftbasis_name_);
   AOBasis dftbasis;
-  dftbasis.Fill(basisset, atom);
+  dftbasis.Fill(*DFTCache::getBasisSet(dftbasis_name_), atom);
   Vxc_Grid grid;
   grid.GridSetup(grid_name_, atom, dftbasis);
+  if (ao_cache_memory_ > 0) {
+    grid.CacheAOValues(ao_cache_memory_, ao_cache_single_);
+  }
   Vxc_Potential<Vxc_Grid> gridIntegration(grid);
   gridIntegration.setXCfunctional(xc_functional_name_);
 
   ECPAOBasis ecp;
   if (with_ecp) {
-    ECPBasisSet ecps;
-    ecps.Load(ecp_name_);
-    ecp.Fill(ecps, atom);
+    ecp.Fill(*DFTCache::getECPBasisSet(ecp_name_), atom);
   }
 
   Index numofelectrons = uniqueAtom.getNuccharge();
@@ -709,10 +762,34 @@ Eigen::MatrixXd DFTEngine::AtomicGuess(const QMMolecule& mol) const {
                              << " unique elements found" << std::flush;
   std::vector<Eigen::MatrixXd> uniqueatom_guesses;
   for (QMAtom& unique_atom : uniqueelements) {
-    XTP_LOG(Log::error, *pLog_)
-        << TimeStamp() << " Calculating atom density for "
-        << unique_atom.getElement() << std::flush;
+    const std::string& element = unique_atom.getElement();
+    Index numfunc = 0;
+    for (Index i = 0; i < mol.size(); i++) {
+      if (mol[i].getElement() == element) {
+        numfunc = dftbasis_.getFuncPerAtom()[i];
+        break;
+      }
+    }
+    const std::string key = AtomicDensityKey(element);
+    std::shared_ptr<const Eigen::MatrixXd> cached =
+        DFTCache::getAtomicDensity(key, atomic_guess_cache_);
+    if (cached && cached->rows() == numfunc) {
+      XTP_LOG(Log::error, *pLog_)
+          << TimeStamp() << " Reusing atom density for " << element
+          << std::flush;
+      uniqueatom_guesses.push_back(*cached);
+      continue;
+    }
+    XTP_LOG(Log::error, *pLog_) << TimeStamp()
+                                << " Calculating atom density for " << element
+                                << std::flush;
     Eigen::MatrixXd dmat_unrestricted = RunAtomicDFT_unrestricted(unique_atom);
+    if (!DFTCache::addAtomicDensity(key, dmat_unrestricted,
+                                    atomic_guess_cache_)) {
+      XTP_LOG(Log::error, *pLog_)
+          << TimeStamp() << " WARNING: Could not write atom density for "
+          << element << " to " << atomic_guess_cache_ << std::flush;
+    }
     uniqueatom_guesses.push_back(dmat_unrestricted);
   }
 
@@ -834,20 +911,18 @@ void DFTEngine::Prepare(Orbitals& orb, Index numofelectrons) {
       << dftbasis_.AOBasisSize() << " functions" << std::flush;
 
   if (!auxbasis_name_.empty()) {
-    BasisSet auxbasisset;
-    auxbasisset.Load(auxbasis_name_);
-    auxbasis_.Fill(auxbasisset, mol);
+    auxbasis_.Fill(*DFTCache::getBasisSet(auxbasis_name_), mol);
     XTP_LOG(Log::error, *pLog_)
         << TimeStamp() << " Loaded AUX Basis Set " << auxbasis_name_ << " with "
         << auxbasis_.AOBasisSize() << " functions" << std::flush;
   }
   if (!ecp_name_.empty()) {
-    ECPBasisSet ecpbasisset;
-    ecpbasisset.Load(ecp_name_);
+    std::shared_ptr<const ECPBasisSet> ecpbasisset =
+        DFTCache::getECPBasisSet(ecp_name_);
     XTP_LOG(Log::error, *pLog_)
         << TimeStamp() << " Loaded ECP library " << ecp_name_ << std::flush;
 
-    std::vector<std::string> results = ecp_.Fill(ecpbasisset, mol);
+    std::vector<std::string> results = ecp_.Fill(*ecpbasisset, mol);
     XTP_LOG(Log::info, *pLog_)
         << TimeStamp() << " Filled ECP Basis" << std::flush;
     if (results.size() > 0) {
@@ -887,8 +962,21 @@ Vxc_Potential<Vxc_Grid> DFTEngine::SetupVxc(const QMMolecule& mol) {
   }
   Vxc_Grid grid;
   grid.GridSetup(grid_name_, mol, dftbasis_);
+  double cache_memory = 0.0;
+  if (ao_cache_memory_ > 0) {
+    // the copy of the grid in vxc shares the cached values
+    cache_memory = grid.CacheAOValues(ao_cache_memory_, ao_cache_single_);
+  }
   Vxc_Potential<Vxc_Grid> vxc(grid);
   vxc.setXCfunctional(xc_functional_name_);
+  cosx_.reset();
+  if (ScaHFX_ > 0 && exact_exchange_ == "cosx") {
+    cosx_ = std::make_unique<SeminumericalExchange>(grid, dftbasis_,
+                                                    cosx_threshold_);
+    XTP_LOG(Log::error, *pLog_)
+        << TimeStamp() << " Exact exchange integrated seminumerically on grid "
+        << grid_name_ << std::flush;
+  }
   XTP_LOG(Log::error, *pLog_)
       << TimeStamp() << " Setup numerical integration grid " << grid_name_
       << " for vxc functional " << xc_functional_name_ << std::flush;
@@ -896,6 +984,12 @@ Vxc_Potential<Vxc_Grid> DFTEngine::SetupVxc(const QMMolecule& mol) {
       << "\t\t "
       << " with " << grid.getGridSize() << " points"
       << " divided into " << grid.getBoxesSize() << " boxes" << std::flush;
+  if (ao_cache_memory_ > 0) {
+    XTP_LOG(Log::info, *pLog_)
+        << "\t\t  AO values on the grid cached in "
+        << (ao_cache_single_ ? "single" : "double") << " precision using "
+        << cache_memory << " MB" << std::flush;
+  }
   return vxc;
 }
 
@@ -1004,10 +1098,9 @@ Mat_p_Energy DFTEngine::IntegrateExternalMultipoles(
 
 Mat_p_Energy DFTEngine::IntegrateExternalDensity(
     const QMMolecule& mol, const Orbitals& extdensity) const {
-  BasisSet basis;
-  basis.Load(extdensity.getDFTbasisName());
   AOBasis aobasis;
-  aobasis.Fill(basis, extdensity.QMAtoms());
+  aobasis.Fill(*DFTCache::getBasisSet(extdensity.getDFTbasisName()),
+               extdensity.QMAtoms());
   Vxc_Grid grid;
   grid.GridSetup(gridquality_, extdensity.QMAtoms(), aobasis);
   DensityIntegration<Vxc_Grid> numint(grid);
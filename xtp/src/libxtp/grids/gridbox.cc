@@ -17,6 +17,9 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+
 // Local VOTCA includes
 #include "votca/xtp/gridbox.h"
 #include "votca/xtp/aobasis.h"
@@ -25,10 +28,28 @@ namespace votca {
 namespace xtp {
 
 void GridBox::FindSignificantShells(const AOBasis& basis) {
+  if (grid_pos.empty()) {
+    return;
+  }
+  // bounding sphere of the points, shells far away from all of them are
+  // skipped without looking at single points
+  Eigen::Vector3d center = Eigen::Vector3d::Zero();
+  for (const auto& point : grid_pos) {
+    center += point;
+  }
+  center /= double(grid_pos.size());
+  double radius = 0.0;
+  for (const auto& point : grid_pos) {
+    radius = std::max(radius, (point - center).norm());
+  }
 
   for (const AOShell& store : basis) {
     const double decay = store.getMinDecay();
     const Eigen::Vector3d& shellpos = store.getPos();
+    const double mindist = (shellpos - center).norm() - radius;
+    if (mindist > 0 && decay * mindist * mindist >= 20.7) {
+      continue;
+    }
     for (const auto& point : grid_pos) {
       Eigen::Vector3d dist = shellpos - point;
       double distsq = dist.squaredNorm();
@@ -44,14 +65,109 @@ void GridBox::FindSignificantShells(const AOBasis& basis) {
 AOShell::AOValues GridBox::CalcAOValues(const Eigen::Vector3d& point) const {
   AOShell::AOValues result(Matrixsize());
   for (Index j = 0; j < Shellsize(); ++j) {
-    const AOShell::AOValues val = significant_shells[j]->EvalAOspace(point);
-    result.derivatives.middleRows(aoranges[j].start, aoranges[j].size) =
-        val.derivatives;
-    result.values.segment(aoranges[j].start, aoranges[j].size) = val.values;
+    significant_shells[j]->EvalAOspace(
+        point, result.values.segment(aoranges[j].start, aoranges[j].size),
+        result.derivatives.middleRows(aoranges[j].start, aoranges[j].size));
   }
   return result;
 }
 
+GridBox::AOBlock GridBox::CalcAOValues(const GridboxRange& points) const {
+  AOBlock result;
+  result.values.resize(points.size, Matrixsize());
+  for (Eigen::MatrixXd& derivative : result.derivatives) {
+    derivative.resize(points.size, Matrixsize());
+  }
+  AOShell::AOValues point_values(Matrixsize());
+  for (Index p = 0; p < points.size; p++) {
+    const Eigen::Vector3d& point = grid_pos[points.start + p];
+    for (Index j = 0; j < Shellsize(); ++j) {
+      significant_shells[j]->EvalAOspace(
+          point,
+          point_values.values.segment(aoranges[j].start, aoranges[j].size),
+          point_values.derivatives.middleRows(aoranges[j].start,
+                                              aoranges[j].size));
+    }
+    result.values.row(p) = point_values.values.transpose();
+    for (Index k = 0; k < 3; k++) {
+      result.derivatives[k].row(p) =
+          point_values.derivatives.col(k).transpose();
+    }
+  }
+  return result;
+}
+
+std::vector<GridboxRange> GridBox::getPointBlocks(Index blocksize) const {
+  std::vector<GridboxRange> blocks;
+  for (Index start = 0; start < size(); start += blocksize) {
+    GridboxRange block;
+    block.start = start;
+    block.size = std::min(blocksize, size() - start);
+    blocks.push_back(block);
+  }
+  return blocks;
+}
+
+const GridBox::AOBlock& GridBox::getAOValues(const GridboxRange& points,
+                                             AOBlock& buffer) const {
+  if (ao_cache_ != nullptr) {
+    const Index index = points.start / default_blocksize;
+    const bool is_cached_block =
+        (points.start % default_blocksize == 0) &&
+        (points.size == std::min(default_blocksize, size() - points.start));
+    if (is_cached_block && !ao_cache_->blocks.empty()) {
+      return ao_cache_->blocks[index];
+    } else if (is_cached_block) {
+      const AOBlockT<float>& cached = ao_cache_->blocks_single[index];
+      buffer.values = cached.values.cast<double>();
+      for (Index k = 0; k < 3; k++) {
+        buffer.derivatives[k] = cached.derivatives[k].cast<double>();
+      }
+      return buffer;
+    }
+  }
+  buffer = CalcAOValues(points);
+  return buffer;
+}
+
+void GridBox::CacheAOValues(bool single_precision) {
+  auto cache = std::make_shared<AOCache>();
+  for (const GridboxRange& block : getPointBlocks()) {
+    AOBlock ao = CalcAOValues(block);
+    if (single_precision) {
+      AOBlockT<float> ao_single;
+      ao_single.values = ao.values.cast<float>();
+      for (Index k = 0; k < 3; k++) {
+        ao_single.derivatives[k] = ao.derivatives[k].cast<float>();
+      }
+      cache->blocks_single.push_back(std::move(ao_single));
+    } else {
+      cache->blocks.push_back(std::move(ao));
+    }
+  }
+  ao_cache_ = cache;
+}
+
+double GridBox::CacheAOValues(std::vector<GridBox>& boxes, double max_memory,
+                              bool single_precision) {
+  const double max_bytes = max_memory * 1024 * 1024;
+  double used_bytes = 0.0;
+  std::vector<Index> cached_boxes;
+  for (Index i = 0; i < Index(boxes.size()); i++) {
+    const double box_bytes = double(boxes[i].AOCacheSize(single_precision));
+    if (boxes[i].Matrixsize() == 0 || used_bytes + box_bytes > max_bytes) {
+      continue;
+    }
+    used_bytes += box_bytes;
+    cached_boxes.push_back(i);
+  }
+#pragma omp parallel for schedule(guided)
+  for (Index i = 0; i < Index(cached_boxes.size()); i++) {
+    boxes[cached_boxes[i]].CacheAOValues(single_precision);
+  }
+  return used_bytes / (1024.0 * 1024.0);
+}
+
 void GridBox::AddtoBigMatrix(Eigen::MatrixXd& bigmatrix,
                              const Eigen::MatrixXd& smallmatrix) const {
   for (Index i = 0; i < Index(ranges.size()); i++) {
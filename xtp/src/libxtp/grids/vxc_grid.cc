@@ -17,9 +17,17 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <unordered_map>
+
+// Third party includes
+#include <boost/functional/hash.hpp>
+
 // Local VOTCA includes
 #include "votca/xtp/vxc_grid.h"
 #include "votca/tools/NDimVector.h"
+#include "votca/xtp/dftcache.h"
 #include "votca/xtp/qmmolecule.h"
 #include "votca/xtp/radial_euler_maclaurin_rule.h"
 #include "votca/xtp/sphere_lebedev_rule.h"
@@ -28,6 +36,11 @@
 namespace votca {
 namespace xtp {
 
+namespace {
+// parameter of the SSW step function, for |mu| > ass it is zero or one
+constexpr double ass = 0.725;
+}  // namespace
+
 void Vxc_Grid::SortGridpointsintoBlocks(
     const std::vector<std::vector<GridContainers::Cartesian_gridpoint> >&
         grid) {
@@ -75,39 +88,39 @@ void Vxc_Grid::SortGridpointsintoBlocks(
 
 void Vxc_Grid::FindSignificantShells(const AOBasis& basis) {
 
-#pragma omp parallel for
+#pragma omp parallel for schedule(guided)
   for (Index i = 0; i < getBoxesSize(); i++) {
     grid_boxes_[i].FindSignificantShells(basis);
   }
 
+  // merge boxes with the same significant shells, the first box with a set of
+  // shells collects the points of all later ones
+  std::unordered_map<std::vector<const AOShell*>, Index,
+                     boost::hash<std::vector<const AOShell*> > >
+      box_index;
   std::vector<GridBox> grid_boxes_copy;
-  // use vector of bool to indicate if a gridbox has already been merged into
-  // another
-  std::vector<bool> Merged = std::vector<bool>(grid_boxes_.size(), false);
-  for (Index i = 0; i < Index(grid_boxes_.size()); i++) {
-    if (Merged[i]) {
-      continue;
-    }
-    GridBox box = grid_boxes_[i];
+  for (GridBox& box : grid_boxes_) {
     if (box.Shellsize() < 1) {
       continue;
     }
-    Merged[i] = true;
-    for (Index j = i + 1; j < Index(grid_boxes_.size()); j++) {
-      if (GridBox::compareGridboxes(grid_boxes_[i], grid_boxes_[j])) {
-        Merged[j] = true;
-        box.addGridBox(grid_boxes_[j]);
-      }
+    auto inserted =
+        box_index.try_emplace(box.getShells(), Index(grid_boxes_copy.size()));
+    if (inserted.second) {
+      grid_boxes_copy.push_back(std::move(box));
+    } else {
+      grid_boxes_copy[inserted.first->second].addGridBox(box);
     }
-    grid_boxes_copy.push_back(box);
   }
 
+#pragma omp parallel for schedule(guided)
+  for (Index i = 0; i < Index(grid_boxes_copy.size()); i++) {
+    grid_boxes_copy[i].PrepareForIntegration();
+  }
   totalgridsize_ = 0;
-  for (auto& box : grid_boxes_copy) {
+  for (const auto& box : grid_boxes_copy) {
     totalgridsize_ += box.size();
-    box.PrepareForIntegration();
   }
-  grid_boxes_ = grid_boxes_copy;
+  grid_boxes_ = std::move(grid_boxes_copy);
 }
 
 std::vector<const Eigen::Vector3d*> Vxc_Grid::getGridpoints() const {
@@ -122,17 +135,21 @@ std::vector<const Eigen::Vector3d*> Vxc_Grid::getGridpoints() const {
   return gridpoints;
 }
 
-Eigen::MatrixXd Vxc_Grid::CalcInverseAtomDist(const QMMolecule& atoms) const {
-  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(atoms.size(), atoms.size());
-#pragma omp parallel for
+Vxc_Grid::NeighbourList Vxc_Grid::CalcNeighbourList(
+    const QMMolecule& atoms) const {
+  NeighbourList neighbours(atoms.size());
+#pragma omp parallel for schedule(guided)
   for (Index i = 0; i < atoms.size(); ++i) {
     const Eigen::Vector3d& pos_a = atoms[i].getPos();
-    for (Index j = 0; j < i; ++j) {
-      const Eigen::Vector3d& pos_b = atoms[j].getPos();
-      result(j, i) = 1 / (pos_a - pos_b).norm();
+    neighbours[i].reserve(atoms.size() - 1);
+    for (Index j = 0; j < atoms.size(); ++j) {
+      if (j != i) {
+        neighbours[i].emplace_back((pos_a - atoms[j].getPos()).norm(), j);
+      }
     }
+    std::sort(neighbours[i].begin(), neighbours[i].end());
   }
-  return result + result.transpose();
+  return neighbours;
 }
 
 Index Vxc_Grid::UpdateOrder(LebedevGrid& sphericalgridofElement, Index maxorder,
@@ -174,8 +191,9 @@ Index Vxc_Grid::UpdateOrder(LebedevGrid& sphericalgridofElement, Index maxorder,
 }
 
 GridContainers::Cartesian_gridpoint Vxc_Grid::CreateCartesianGridpoint(
-    const Eigen::Vector3d& atomA_pos, GridContainers::radial_grid& radial_grid,
-    GridContainers::spherical_grid& spherical_grid, Index i_rad,
+    const Eigen::Vector3d& atomA_pos,
+    const GridContainers::radial_grid& radial_grid,
+    const GridContainers::spherical_grid& spherical_grid, Index i_rad,
     Index i_sph) const {
   GridContainers::Cartesian_gridpoint gridpoint;
   double p = spherical_grid.phi[i_sph];
@@ -189,149 +207,172 @@ GridContainers::Cartesian_gridpoint Vxc_Grid::CreateCartesianGridpoint(
   return gridpoint;
 }
 
-Eigen::MatrixXd Vxc_Grid::CalcDistanceAtomsGridpoints(
-    const QMMolecule& atoms,
-    std::vector<GridContainers::Cartesian_gridpoint>& atomgrid) const {
-  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(atoms.size(), atomgrid.size());
-#pragma omp parallel for
-  for (Index i = 0; i < atoms.size(); ++i) {
-    const Eigen::Vector3d& atom_pos = atoms[i].getPos();
-    for (Index j = 0; j < Index(atomgrid.size()); ++j) {
-      const auto& gridpoint = atomgrid[j];
-      result(i, j) = (atom_pos - gridpoint.grid_pos).norm();
-    }
-  }
-  return result;
-}
-
-void Vxc_Grid::SSWpartitionAtom(
-    const QMMolecule& atoms,
-    std::vector<GridContainers::Cartesian_gridpoint>& atomgrid, Index i_atom,
-    const Eigen::MatrixXd& Rij) const {
-  Eigen::MatrixXd AtomGridDist = CalcDistanceAtomsGridpoints(atoms, atomgrid);
+DFTCache::ElementGrid Vxc_Grid::BuildElementGrid(
+    const std::string& type, const std::string& element,
+    const GridContainers::radial_grid& radial_grid,
+    EulerMaclaurinGrid& radialgridofElement) const {
+  LebedevGrid sphericalgridofElement;
+  // maximum order (= number of points) in spherical integration grid
+  Index maxorder = sphericalgridofElement.Type2MaxOrder(element, type);
+  // for pruning of integration grid, get interval boundaries for this element
+  std::vector<double> PruningIntervals =
+      radialgridofElement.CalculatePruningIntervals(element);
+  GridContainers::spherical_grid spherical_grid;
+  Index current_order = 0;
+  DFTCache::ElementGrid elementgrid;
+  // for each radial value
+  for (Index i_rad = 0; i_rad < radial_grid.radius.size(); i_rad++) {
+    double r = radial_grid.radius[i_rad];
 
-#pragma omp parallel for schedule(guided)
-  for (Index i_grid = 0; i_grid < Index(atomgrid.size()); i_grid++) {
-    Eigen::VectorXd p = SSWpartition(AtomGridDist.col(i_grid), Rij);
-    // check weight sum
-    double wsum = p.sum();
-    if (wsum != 0.0) {
-      // update the weight of this grid point
-      atomgrid[i_grid].grid_weight *= p[i_atom] / wsum;
-    } else {
-      std::cerr << "\nSum of partition weights of grid point " << i_grid
-                << " of atom " << i_atom << " is zero! ";
-      throw std::runtime_error("\nThis should never happen!");
+    // which Lebedev order for this point?
+    Index order =
+        UpdateOrder(sphericalgridofElement, maxorder, PruningIntervals, r);
+    // get new spherical grid, if order changed
+    if (order != current_order) {
+      spherical_grid = sphericalgridofElement.CalculateUnitSphereGrid(order);
+      current_order = order;
     }
-  }  // partition weight for each gridpoint
+
+    for (Index i_sph = 0; i_sph < spherical_grid.phi.size(); i_sph++) {
+      elementgrid.push_back(CreateCartesianGridpoint(
+          Eigen::Vector3d::Zero(), radial_grid, spherical_grid, i_rad, i_sph));
+    }  // spherical gridpoints
+  }    // radial gridpoint
+  return elementgrid;
 }
 
 void Vxc_Grid::GridSetup(const std::string& type, const QMMolecule& atoms,
                          const AOBasis& basis) {
-  GridContainers initialgrids;
   // get radial grid per element
   EulerMaclaurinGrid radialgridofElement;
-  initialgrids.radial_grids = radialgridofElement.CalculateAtomicRadialGrids(
-      basis, atoms, type);  // this checks out 1:1 with NWChem results! AWESOME
-  LebedevGrid sphericalgridofElement;
-  initialgrids.spherical_grids =
-      sphericalgridofElement.CalculateSphericalGrids(atoms, type);
-
-  // for the partitioning, we need all inter-center distances later, stored in
-  // matrix
-  Eigen::MatrixXd Rij = CalcInverseAtomDist(atoms);
-  std::vector<std::vector<GridContainers::Cartesian_gridpoint> > grid;
-
-  for (Index i_atom = 0; i_atom < atoms.size(); ++i_atom) {
-    const QMAtom& atom = atoms[i_atom];
-
-    const Eigen::Vector3d& atomA_pos = atom.getPos();
-    const std::string& name = atom.getElement();
-    GridContainers::radial_grid radial_grid =
-        initialgrids.radial_grids.at(name);
-    GridContainers::spherical_grid spherical_grid =
-        initialgrids.spherical_grids.at(name);
+  std::map<std::string, GridContainers::radial_grid> radial_grids =
+      radialgridofElement.CalculateAtomicRadialGrids(
+          basis, atoms, type);  // this checks out 1:1 with NWChem results!
 
-    // maximum order (= number of points) in spherical integration grid
-    Index maxorder = sphericalgridofElement.Type2MaxOrder(name, type);
-    // for pruning of integration grid, get interval boundaries for this element
-    std::vector<double> PruningIntervals =
-        radialgridofElement.CalculatePruningIntervals(name);
-    Index current_order = 0;
-    // for each radial value
-    std::vector<GridContainers::Cartesian_gridpoint> atomgrid;
-    for (Index i_rad = 0; i_rad < radial_grid.radius.size(); i_rad++) {
-      double r = radial_grid.radius[i_rad];
+  // the pruned grid of an atom only depends on its element and radial grid,
+  // so it is built once around the origin and shifted to each atom
+  std::map<std::string, std::shared_ptr<const DFTCache::ElementGrid> >
+      element_grids;
+  for (const auto& element : radial_grids) {
+    element_grids[element.first] = DFTCache::getElementGrid(
+        element.first, type, element.second, [&]() {
+          return BuildElementGrid(type, element.first, element.second,
+                                  radialgridofElement);
+        });
+  }
 
-      // which Lebedev order for this point?
-      Index order =
-          UpdateOrder(sphericalgridofElement, maxorder, PruningIntervals, r);
-      // get new spherical grid, if order changed
-      if (order != current_order) {
-        spherical_grid = sphericalgridofElement.CalculateUnitSphereGrid(order);
-        current_order = order;
-      }
+  // for the partitioning, we need the neighbours of each atom
+  NeighbourList neighbours = CalcNeighbourList(atoms);
+  std::vector<std::vector<GridContainers::Cartesian_gridpoint> > grid(
+      atoms.size());
 
-      for (Index i_sph = 0; i_sph < spherical_grid.phi.size(); i_sph++) {
-        GridContainers::Cartesian_gridpoint gridpoint =
-            CreateCartesianGridpoint(atomA_pos, radial_grid, spherical_grid,
-                                     i_rad, i_sph);
+#pragma omp parallel for schedule(dynamic)
+  for (Index i_atom = 0; i_atom < atoms.size(); ++i_atom) {
+    const Eigen::Vector3d& atomA_pos = atoms[i_atom].getPos();
+    const DFTCache::ElementGrid& elementgrid =
+        *element_grids.at(atoms[i_atom].getElement());
+    std::vector<GridContainers::Cartesian_gridpoint>& atomgrid = grid[i_atom];
+    atomgrid.reserve(elementgrid.size());
+    for (const auto& elementpoint : elementgrid) {
+      GridContainers::Cartesian_gridpoint gridpoint;
+      gridpoint.grid_pos = atomA_pos + elementpoint.grid_pos;
+      gridpoint.grid_weight =
+          elementpoint.grid_weight *
+          SSWpartitionWeight(gridpoint.grid_pos, i_atom, atoms, neighbours);
+      // now remove points from the grid with negligible weights
+      if (gridpoint.grid_weight > 1e-13) {
         atomgrid.push_back(gridpoint);
-      }  // spherical gridpoints
-    }    // radial gridpoint
-
-    SSWpartitionAtom(atoms, atomgrid, i_atom, Rij);
-    // now remove points from the grid with negligible weights
-    std::vector<GridContainers::Cartesian_gridpoint> atomgrid_cleanedup;
-    for (const auto& point : atomgrid) {
-      if (point.grid_weight > 1e-13) {
-        atomgrid_cleanedup.push_back(point);
       }
     }
-    grid.push_back(atomgrid_cleanedup);
   }  // atoms
   SortGridpointsintoBlocks(grid);
   FindSignificantShells(basis);
   return;
 }
 
-Eigen::VectorXd Vxc_Grid::SSWpartition(const Eigen::VectorXd& rq_i,
-                                       const Eigen::MatrixXd& Rij) const {
-  const double ass = 0.725;
-  // initialize partition vector to 1.0
-  Eigen::VectorXd p = Eigen::VectorXd::Ones(rq_i.size());
-  const double tol_scr = 1e-10;
+// step function of the atom pair (i, j) with i > j and
+// mu = (r_i - r_j) / R_ij, the partition product of atom j is multiplied with
+// it and that of atom i with one minus it
+double Vxc_Grid::SSWstep(double mu) const {
   const double leps = 1e-6;
-  // go through centers
-  for (Index i = 1; i < rq_i.size(); i++) {
-    double rag = rq_i(i);
-    // through all other centers (one-directional)
-    for (Index j = 0; j < i; j++) {
-      if ((std::abs(p[i]) > tol_scr) || (std::abs(p[j]) > tol_scr)) {
-        double mu = (rag - rq_i(j)) * Rij(j, i);
-        if (mu > ass) {
-          p[i] = 0.0;
-        } else if (mu < -ass) {
-          p[j] = 0.0;
-        } else {
-          double sk;
-          if (std::abs(mu) < leps) {
-            sk = -1.88603178008 * mu + 0.5;
-          } else {
-            sk = erf1c(mu);
-          }
-          if (mu > 0.0) {
-            sk = 1.0 - sk;
-          }
-          p[j] = p[j] * sk;
-          p[i] = p[i] * (1.0 - sk);
-        }
-      }
+  if (mu > ass) {
+    return 1.0;
+  } else if (mu < -ass) {
+    return 0.0;
+  }
+  double sk;
+  if (std::abs(mu) < leps) {
+    sk = -1.88603178008 * mu + 0.5;
+  } else {
+    sk = erf1c(mu);
+  }
+  if (mu > 0.0) {
+    sk = 1.0 - sk;
+  }
+  return sk;
+}
+
+double Vxc_Grid::SSWpartitionProduct(const Eigen::Vector3d& point,
+                                     Index i_atom, double r_i,
+                                     const QMMolecule& atoms,
+                                     const NeighbourList& neighbours) const {
+  double p = 1.0;
+  for (const auto& neighbour : neighbours[i_atom]) {
+    const double R_ij = neighbour.first;
+    // for R_ij > 2 r_i/(1-ass) mu_ij < -ass, so this and all further atoms
+    // do not change p
+    if (R_ij * (1.0 - ass) > 2.0 * r_i) {
+      break;
+    }
+    const Index j = neighbour.second;
+    const double r_j = (point - atoms[j].getPos()).norm();
+    if (i_atom > j) {
+      p *= 1.0 - SSWstep((r_i - r_j) / R_ij);
+    } else {
+      p *= SSWstep((r_j - r_i) / R_ij);
+    }
+    if (p == 0.0) {
+      break;
     }
   }
   return p;
 }
 
+double Vxc_Grid::SSWpartitionWeight(const Eigen::Vector3d& point, Index i_atom,
+                                    const QMMolecule& atoms,
+                                    const NeighbourList& neighbours) const {
+  const std::vector<std::pair<double, Index> >& neighbours_A =
+      neighbours[i_atom];
+  const double r_A = (point - atoms[i_atom].getPos()).norm();
+  // close to its own atom the weight is one, Stratmann, Scuseria and Frisch,
+  // Chem. Phys. Lett. 257, 213 (1996)
+  if (neighbours_A.empty() ||
+      r_A < 0.5 * (1.0 - ass) * neighbours_A.front().first) {
+    return 1.0;
+  }
+  const double p_A =
+      SSWpartitionProduct(point, i_atom, r_A, atoms, neighbours);
+  if (p_A == 0.0) {
+    return 0.0;
+  }
+  // only atoms B with mu_BA <= ass have a non zero partition product, for
+  // R_AB > 2 r_A/(1-ass) mu_BA > ass always holds
+  double wsum = p_A;
+  for (const auto& neighbour : neighbours_A) {
+    const double R_AB = neighbour.first;
+    if (R_AB * (1.0 - ass) > 2.0 * r_A) {
+      break;
+    }
+    const Index b = neighbour.second;
+    const double r_B = (point - atoms[b].getPos()).norm();
+    if ((r_B - r_A) / R_AB > ass) {
+      continue;
+    }
+    wsum += SSWpartitionProduct(point, b, r_B, atoms, neighbours);
+  }
+  return p_A / wsum;
+}
+
 double Vxc_Grid::erf1c(double x) const {
   const static double alpha_erf1 = 1.0 / 0.30;
   return 0.5 * std::erfc(std::abs(x / (1.0 - x * x)) * alpha_erf1);
@@ -183,15 +183,11 @@ void Job::UpdateFromResult(const JobResult &res) {
 
 std::vector<Job> LOAD_JOBS(const std::string &job_file) {
 
-  tools::Property xml;
-  xml.LoadFromXML(job_file);
-
-  std::vector<tools::Property *> jobProps = xml.Select("jobs.job");
+  // jobs are constructed one by one, the tree of the whole file is never built
   std::vector<Job> jobs;
-  jobs.reserve(jobProps.size());
-  for (tools::Property *prop : jobProps) {
-    jobs.push_back(Job(*prop));
-  }
+  tools::Property::StreamFromXML(
+      job_file, "jobs.job",
+      [&jobs](tools::Property &prop) { jobs.push_back(Job(prop)); });
 
   return jobs;
 }
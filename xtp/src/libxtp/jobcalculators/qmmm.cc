@@ -287,24 +287,22 @@ void QMMM::ReadJobFile(Topology& top) {
   Eigen::Matrix<bool, Eigen::Dynamic, 5> found =
       Eigen::Matrix<bool, Eigen::Dynamic, 5>::Zero(top.Segments().size(), 5);
 
-  tools::Property xml;
-  xml.LoadFromXML(jobfile_);
-  for (tools::Property* job : xml.Select("jobs.job")) {
-
-    Index jobid = job->get("id").as<Index>();
-    if (!job->exists("status")) {
+  // jobs are read one by one from the file
+  auto read_job = [&](tools::Property& job) {
+    Index jobid = job.get("id").as<Index>();
+    if (!job.exists("status")) {
       throw std::runtime_error(
           "Jobfile is malformed. <status> tag missing for job " +
           std::to_string(jobid));
     }
-    if (job->get("status").as<std::string>() != "COMPLETE" ||
-        !job->exists("output")) {
+    if (job.get("status").as<std::string>() != "COMPLETE" ||
+        !job.exists("output")) {
       incomplete_jobs++;
-      continue;
+      return;
     }
 
     std::vector<std::string> split =
-        tools::Tokenizer(job->get("input.site_energies").as<std::string>(), ":")
+        tools::Tokenizer(job.get("input.site_energies").as<std::string>(), ":")
             .ToVector();
 
     Index segid = std::stoi(split[0]);
@@ -321,7 +319,7 @@ void QMMM::ReadJobFile(Topology& top) {
       message << e.what() << " for job " << jobid;
       throw std::runtime_error(message.str());
     }
-    double energy = job->get("output.E_tot").as<double>() * tools::conv::ev2hrt;
+    double energy = job.get("output.E_tot").as<double>() * tools::conv::ev2hrt;
     if (found(segid, state.Type().Type()) != 0) {
       throw std::runtime_error("There are two entries in jobfile for segment " +
                                std::to_string(segid) +
@@ -330,7 +328,8 @@ void QMMM::ReadJobFile(Topology& top) {
 
     energies(segid, state.Type().Type()) = energy;
     found(segid, state.Type().Type()) = true;
-  }
+  };
+  tools::Property::StreamFromXML(jobfile_, "jobs.job", read_job);
 
   Eigen::Matrix<Index, 1, 5> found_states = found.colwise().count();
   std::cout << std::endl;
@@ -22,6 +22,7 @@
 #include "votca/xtp/aobasis.h"
 #include "votca/xtp/aomatrix.h"
 #include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/seminumerical_exchange.h"
 #include "votca/xtp/threecenter.h"
 
 // include libint last otherwise it overrides eigen
@@ -297,6 +298,275 @@ Eigen::MatrixXd ERIs::ComputeSchwarzShells(const AOBasis& basis) const {
   return result.selfadjointView<Eigen::Upper>();
 }
 
+template <class Func>
+void ERIs::ForEachQuartet(Index s1, Func&& func) const {
+  for (Index pair = 0; pair < Index(shellpairs_[s1].size()); ++pair) {
+    const Index s2 = shellpairs_[s1][pair];
+    const libint2::ShellPair& sp12 = shellpairdata_[s1][pair];
+    for (Index s3 = 0; s3 <= s1; ++s3) {
+      auto sp34_iter = shellpairdata_[s3].begin();
+      Index s4max = (s1 == s3) ? s2 : s3;
+      for (Index s4 : shellpairs_[s3]) {
+        if (s4 > s4max) {
+          break;
+        }  // for each s3, s4 are stored in monotonically increasing
+           // order
+        const libint2::ShellPair& sp34 = *sp34_iter;
+        ++sp34_iter;
+        func(pair, s2, s3, s4, sp12, sp34);
+      }
+    }
+  }
+}
+
+// contributions of one Fock task, the rows of s1 and of all shells s2 of the
+// task and the block of the current ket pair (s3 s4) in its top left corner
+struct FockBuffers {
+  Eigen::MatrixXd hartree_1;
+  Eigen::MatrixXd exchange_1;
+  Eigen::MatrixXd exchange_2;
+  Eigen::MatrixXd hartree_34;
+};
+
+// adds the integrals of the shell quartet (s1 s2|s3 s4), which are stored in
+// the order of libint, to the buffers, row_2 is the first row of s2 in them
+template <bool with_exchange, class T>
+void ContractQuartet(const T* buf_1234, const std::array<Index, 4>& start,
+                     const std::array<Index, 4>& size, double degeneracy,
+                     Index row_2, const Eigen::MatrixXd& dmat,
+                     FockBuffers& fock) {
+  for (Index f1 = 0, f1234 = 0; f1 != size[0]; ++f1) {
+    const Index bf1 = f1 + start[0];
+    for (Index f2 = 0; f2 != size[1]; ++f2) {
+      const Index bf2 = f2 + start[1];
+      const Index r2 = f2 + row_2;
+      for (Index f3 = 0; f3 != size[2]; ++f3) {
+        const Index bf3 = f3 + start[2];
+        for (Index f4 = 0; f4 != size[3]; ++f4, ++f1234) {
+          const Index bf4 = f4 + start[3];
+
+          const double value = double(buf_1234[f1234]);
+
+          const double value_scal_by_deg = value * degeneracy;
+
+          fock.hartree_1(f1, bf2) += dmat(bf3, bf4) * value_scal_by_deg;
+          fock.hartree_34(f3, f4) += dmat(bf1, bf2) * value_scal_by_deg;
+          if (with_exchange) {
+            fock.exchange_1(f1, bf3) -= dmat(bf2, bf4) * value_scal_by_deg;
+            fock.exchange_2(r2, bf3) -= dmat(bf1, bf4) * value_scal_by_deg;
+            fock.exchange_2(r2, bf4) -= dmat(bf1, bf3) * value_scal_by_deg;
+            fock.exchange_1(f1, bf4) -= dmat(bf2, bf3) * value_scal_by_deg;
+          }
+        }
+      }
+    }
+  }
+}
+
+// adds a buffer of a task to the matrix shared by all threads
+void FlushBuffer(Eigen::MatrixXd& target, Index row, Index col,
+                 const Eigen::Ref<const Eigen::MatrixXd>& buffer) {
+  for (Index j = 0; j < buffer.cols(); ++j) {
+    for (Index i = 0; i < buffer.rows(); ++i) {
+      const double value = buffer(i, j);
+      if (value != 0.0) {
+        double& entry = target(row + i, col + j);
+#pragma omp atomic
+        entry += value;
+      }
+    }
+  }
+}
+
+std::vector<ERIs::FockTask> ERIs::PartitionFockTasks(Index nthreads) const {
+  const Index nshells = Index(basis_.size());
+  // the cost of a quartet is estimated as the product of the number of
+  // functions and primitive pairs of its bra and ket pair
+  std::vector<std::vector<double>> pair_cost(nshells);
+  // sum of the costs of all ket pairs (s3 s4) with s3<=s1
+  std::vector<double> ket_cost(nshells);
+  double sum = 0.0;
+  for (Index s1 = 0; s1 < nshells; ++s1) {
+    for (Index pair = 0; pair < Index(shellpairs_[s1].size()); ++pair) {
+      const Index s2 = shellpairs_[s1][pair];
+      const double primpairs =
+          double(std::max(std::size_t(1),
+                          shellpairdata_[s1][pair].primpairs.size()));
+      pair_cost[s1].push_back(
+          primpairs * double(basis_[s1].size() * basis_[s2].size()));
+      sum += pair_cost[s1].back();
+    }
+    ket_cost[s1] = sum;
+  }
+  double total = 0.0;
+  for (Index s1 = 0; s1 < nshells; ++s1) {
+    for (double cost : pair_cost[s1]) {
+      total += cost * ket_cost[s1];
+    }
+  }
+  // several tasks per thread, so that the last ones are small
+  const double target = total / double(16 * nthreads);
+
+  std::vector<FockTask> tasks;
+  for (Index s1 = 0; s1 < nshells; ++s1) {
+    FockTask task{s1, 0, 0, 0.0};
+    for (Index pair = 0; pair < Index(shellpairs_[s1].size()); ++pair) {
+      task.cost += pair_cost[s1][pair] * ket_cost[s1];
+      task.end = pair + 1;
+      if (task.cost >= target) {
+        tasks.push_back(task);
+        task = FockTask{s1, pair + 1, pair + 1, 0.0};
+      }
+    }
+    if (task.end > task.begin) {
+      tasks.push_back(task);
+    }
+  }
+  // expensive tasks first, the dynamic schedule then balances the load with
+  // the cheap ones at the end
+  std::stable_sort(tasks.begin(), tasks.end(),
+                   [](const FockTask& a, const FockTask& b) {
+                     return a.cost > b.cost;
+                   });
+  return tasks;
+}
+
+double ERIs::CacheIntegrals(double memory_MB) {
+  assert(schwarzscreen_.rows() > 0 && schwarzscreen_.cols() > 0 &&
+         "Please call Initialize_4c before running this");
+  cache_.clear();
+  const Index nshells = Index(basis_.size());
+  // quartets are sorted into buckets of log2 of their estimated cost, the
+  // most expensive buckets are kept as long as they fit into the memory
+  const Index nbuckets = 64;
+  auto bucket = [nbuckets](const libint2::ShellPair& sp12,
+                           const libint2::ShellPair& sp34, Index size) {
+    const double cost = double(sp12.primpairs.size()) *
+                        double(sp34.primpairs.size()) * double(size);
+    return std::min(Index(std::ilogb(std::max(cost, 1.0))), nbuckets - 1);
+  };
+  auto quartet_size = [this](Index s1, Index s2, Index s3, Index s4) {
+    return Index(basis_[s1].size() * basis_[s2].size() * basis_[s3].size() *
+                 basis_[s4].size());
+  };
+
+  Eigen::MatrixXd bytes = Eigen::MatrixXd::Zero(nbuckets, nshells);
+#pragma omp parallel for schedule(dynamic)
+  for (Index s1 = 0; s1 < nshells; ++s1) {
+    ForEachQuartet(s1, [&](Index, Index s2, Index s3, Index s4,
+                           const libint2::ShellPair& sp12,
+                           const libint2::ShellPair& sp34) {
+      if (schwarzscreen_(s1, s2) * schwarzscreen_(s3, s4) <
+          cache_threshold_) {
+        return;
+      }
+      const Index size = quartet_size(s1, s2, s3, s4);
+      bytes(bucket(sp12, sp34, size), s1) += double(
+          Index(sizeof(CachedQuartet)) + size * Index(sizeof(double)));
+    });
+  }
+
+  const double budget = memory_MB * 1024.0 * 1024.0;
+  const Eigen::VectorXd bucket_bytes = bytes.rowwise().sum();
+  Index cutoff = nbuckets;
+  double used_bytes = 0.0;
+  while (cutoff > 0 && used_bytes + bucket_bytes[cutoff - 1] <= budget) {
+    cutoff--;
+    used_bytes += bucket_bytes[cutoff];
+  }
+  // the bucket which does not fit completely is kept for the first shells
+  std::vector<bool> partial(nshells, false);
+  if (cutoff > 0) {
+    for (Index s1 = 0; s1 < nshells; ++s1) {
+      if (used_bytes + bytes(cutoff - 1, s1) <= budget) {
+        used_bytes += bytes(cutoff - 1, s1);
+        partial[s1] = true;
+      }
+    }
+  }
+  if (used_bytes == 0.0) {
+    return 0.0;
+  }
+
+  Index nthreads = OPENMP::getMaxThreads();
+  Index max_nprim4 = maxnprim_ * maxnprim_ * maxnprim_ * maxnprim_;
+  std::vector<libint2::Engine> engines(nthreads);
+  engines[0] = libint2::Engine(libint2::Operator::coulomb, int(maxnprim_),
+                               int(maxL_), 0);
+  // the integrals are reused for all densities, so the precision of
+  // Compute4c for a density of norm 1 is used
+  engines[0].set_precision(std::numeric_limits<double>::epsilon() /
+                           double(max_nprim4));
+  for (Index i = 1; i < nthreads; ++i) {
+    engines[i] = engines[0];
+  }
+
+  cache_.resize(nshells);
+#pragma omp parallel for schedule(dynamic)
+  for (Index s1 = 0; s1 < nshells; ++s1) {
+    libint2::Engine& engine = engines[OPENMP::getThreadId()];
+    const auto& buf = engine.results();
+    CachedShell& cached = cache_[s1];
+    ForEachQuartet(s1, [&](Index pair, Index s2, Index s3, Index s4,
+                           const libint2::ShellPair& sp12,
+                           const libint2::ShellPair& sp34) {
+      while (Index(cached.pair_start.size()) <= pair) {
+        cached.pair_start.push_back(Index(cached.quartets.size()));
+      }
+      if (schwarzscreen_(s1, s2) * schwarzscreen_(s3, s4) <
+          cache_threshold_) {
+        return;
+      }
+      const Index size = quartet_size(s1, s2, s3, s4);
+      const Index b = bucket(sp12, sp34, size);
+      if (b < cutoff - 1 || (b == cutoff - 1 && !partial[s1])) {
+        return;
+      }
+      engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xx_xx, 0>(
+          basis_[s1], basis_[s2], basis_[s3], basis_[s4], &sp12, &sp34);
+      CachedQuartet quartet;
+      quartet.s3 = std::int32_t(s3);
+      quartet.s4 = std::int32_t(s4);
+      if (buf[0] == nullptr) {
+        quartet.storage = CachedQuartet::Storage::zero;
+        quartet.offset = 0;
+      } else {
+        Eigen::Map<const Eigen::VectorXd> values(buf[0], size);
+        // small integrals lose nothing relevant in single precision
+        if (values.cwiseAbs().maxCoeff() *
+                double(std::numeric_limits<float>::epsilon()) <
+            cache_threshold_) {
+          quartet.storage = CachedQuartet::Storage::single;
+          quartet.offset = Index(cached.values_single.size());
+          for (Index i = 0; i < size; i++) {
+            cached.values_single.push_back(float(values[i]));
+          }
+        } else {
+          quartet.storage = CachedQuartet::Storage::full;
+          quartet.offset = Index(cached.values.size());
+          cached.values.insert(cached.values.end(), values.data(),
+                               values.data() + size);
+        }
+      }
+      cached.quartets.push_back(quartet);
+    });
+    cached.pair_start.resize(shellpairs_[s1].size() + 1,
+                             Index(cached.quartets.size()));
+    cached.quartets.shrink_to_fit();
+    cached.values.shrink_to_fit();
+    cached.values_single.shrink_to_fit();
+  }
+
+  used_bytes = 0.0;
+  for (const CachedShell& cached : cache_) {
+    used_bytes += double(cached.pair_start.size() * sizeof(Index) +
+                         cached.quartets.size() * sizeof(CachedQuartet) +
+                         cached.values.size() * sizeof(double) +
+                         cached.values_single.size() * sizeof(float));
+  }
+  return used_bytes / (1024.0 * 1024.0);
+}
+
 template <bool with_exchange>
 std::array<Eigen::MatrixXd, 2> ERIs::Compute4c(const Eigen::MatrixXd& dmat,
                                                double error) const {
@@ -327,95 +597,139 @@ std::array<Eigen::MatrixXd, 2> ERIs::Compute4c(const Eigen::MatrixXd& dmat,
   for (Index i = 1; i < nthreads; ++i) {
     engines[i] = engines[0];
   }
-  Index nshells = basis_.size();
+  const std::vector<FockTask> tasks = PartitionFockTasks(nthreads);
+  Index max_shellsize = 0;
+  for (const libint2::Shell& shell : basis_) {
+    max_shellsize = std::max(max_shellsize, Index(shell.size()));
+  }
 
-#pragma omp parallel for schedule(dynamic) reduction(+ : hartree) \
-    reduction(+ : exchange)
-  for (Index s1 = 0; s1 < nshells; ++s1) {
-    Index thread_id = OPENMP::getThreadId();
-    libint2::Engine& engine = engines[thread_id];
+  // every task accumulates into buffers of the rows of its shells, which are
+  // added to the shared matrices at the end, so no thread needs a full copy
+#pragma omp parallel
+  {
+    libint2::Engine& engine = engines[OPENMP::getThreadId()];
     const auto& buf = engine.results();
-    Index start_1 = starts_[s1];
-    const libint2::Shell& shell1 = basis_[s1];
-    Index n1 = shell1.size();
-
-    auto sp12_iter = shellpairdata_[s1].begin();
-    for (Index s2 : shellpairs_[s1]) {
-      Index start_2 = starts_[s2];
-      const libint2::Shell& shell2 = basis_[s2];
-      Index n2 = shell2.size();
-      double dnorm_12 = dnorm_block(s1, s2);
-      const libint2::ShellPair* sp12 = &(*sp12_iter);
-      ++sp12_iter;
+    FockBuffers fock;
+    fock.hartree_34 = Eigen::MatrixXd(max_shellsize, max_shellsize);
+    std::vector<Index> rows_2;
+    std::vector<Index> next_cached;
+#pragma omp for schedule(dynamic, 1)
+    for (Index t = 0; t < Index(tasks.size()); ++t) {
+      const FockTask& task = tasks[t];
+      const Index s1 = task.s1;
+      const Index n1 = Index(basis_[s1].size());
+      // all other shells of a quartet are <= s1
+      const Index ncols = starts_[s1] + n1;
+      rows_2.clear();
+      Index nrows_2 = 0;
+      for (Index pair = task.begin; pair < task.end; ++pair) {
+        rows_2.push_back(nrows_2);
+        nrows_2 += Index(basis_[shellpairs_[s1][pair]].size());
+      }
+      fock.hartree_1 = Eigen::MatrixXd::Zero(n1, ncols);
+      if (with_exchange) {
+        fock.exchange_1 = Eigen::MatrixXd::Zero(n1, ncols);
+        fock.exchange_2 = Eigen::MatrixXd::Zero(nrows_2, ncols);
+      }
+      // cached quartets of a bra pair are stored in the order of the kets
+      const CachedShell* cached = cache_.empty() ? nullptr : &cache_[s1];
+      if (cached != nullptr) {
+        next_cached.assign(cached->pair_start.begin() + task.begin,
+                           cached->pair_start.begin() + task.end);
+      }
+      const Index s2max = shellpairs_[s1][task.end - 1];
 
       for (Index s3 = 0; s3 <= s1; ++s3) {
-
-        Index start_3 = starts_[s3];
-        const libint2::Shell& shell3 = basis_[s3];
-        Index n3 = shell3.size();
+        const Index n3 = Index(basis_[s3].size());
         auto sp34_iter = shellpairdata_[s3].begin();
-        double dnorm_123 = std::max(dnorm_block(s1, s3),
-                                    std::max(dnorm_block(s2, s3), dnorm_12));
-        Index s4max = (s1 == s3) ? s2 : s3;
+        Index s4max = (s1 == s3) ? s2max : s3;
         for (Index s4 : shellpairs_[s3]) {
           if (s4 > s4max) {
             break;
           }  // for each s3, s4 are stored in monotonically increasing
              // order
-
-          const libint2::ShellPair* sp34 = &(*sp34_iter);
+          const libint2::ShellPair& sp34 = *sp34_iter;
           // must update the iter even if going to skip s4
           ++sp34_iter;
-          double dnorm_1234 =
-              std::max(dnorm_block(s1, s4),
-                       std::max(dnorm_block(s2, s4),
-                                std::max(dnorm_block(s3, s4), dnorm_123)));
-
-          if (dnorm_1234 * schwarzscreen_(s1, s2) * schwarzscreen_(s3, s4) <
-              fock_precision) {
-            continue;
-          }
+          const Index n4 = Index(basis_[s4].size());
+          fock.hartree_34.topLeftCorner(n3, n4).setZero();
+          bool ket_computed = false;
+
+          for (Index pair = task.begin; pair < task.end; ++pair) {
+            const Index s2 = shellpairs_[s1][pair];
+            if (s1 == s3 && s4 > s2) {
+              continue;
+            }
+            const Index i = pair - task.begin;
+            const CachedQuartet* quartet = nullptr;
+            if (cached != nullptr &&
+                next_cached[i] < cached->pair_start[pair + 1]) {
+              const CachedQuartet& next = cached->quartets[next_cached[i]];
+              if (next.s3 == s3 && next.s4 == s4) {
+                quartet = &next;
+                ++next_cached[i];
+              }
+            }
 
-          const libint2::Shell& shell4 = basis_[s4];
-          engine
-              .compute2<libint2::Operator::coulomb, libint2::BraKet::xx_xx, 0>(
-                  shell1, shell2, shell3, shell4, sp12, sp34);
-          const auto* buf_1234 = buf[0];
-          if (buf_1234 == nullptr) {
-            continue;  // if all integrals screened out, skip to next quartet
-          }
-          Index start_4 = starts_[s4];
-          Index n4 = shell4.size();
-          Index s12_deg = (s1 == s2) ? 1 : 2;
-          Index s34_deg = (s3 == s4) ? 1 : 2;
-          Index s12_34_deg = (s1 == s3) ? (s2 == s4 ? 1 : 2) : 2;
-          Index s1234_deg = s12_deg * s34_deg * s12_34_deg;
-
-          for (Index f1 = 0, f1234 = 0; f1 != n1; ++f1) {
-            const Index bf1 = f1 + start_1;
-            for (Index f2 = 0; f2 != n2; ++f2) {
-              const Index bf2 = f2 + start_2;
-              for (Index f3 = 0; f3 != n3; ++f3) {
-                const Index bf3 = f3 + start_3;
-                for (Index f4 = 0; f4 != n4; ++f4, ++f1234) {
-                  const Index bf4 = f4 + start_4;
-
-                  const double value = buf_1234[f1234];
-
-                  const double value_scal_by_deg = value * double(s1234_deg);
-
-                  hartree(bf1, bf2) += dmat(bf3, bf4) * value_scal_by_deg;
-                  hartree(bf3, bf4) += dmat(bf1, bf2) * value_scal_by_deg;
-                  if (with_exchange) {
-                    exchange(bf1, bf3) -= dmat(bf2, bf4) * value_scal_by_deg;
-                    exchange(bf2, bf3) -= dmat(bf1, bf4) * value_scal_by_deg;
-                    exchange(bf2, bf4) -= dmat(bf1, bf3) * value_scal_by_deg;
-                    exchange(bf1, bf4) -= dmat(bf2, bf3) * value_scal_by_deg;
-                  }
-                }
+            double dnorm_1234 = std::max(
+                std::max(dnorm_block(s1, s2), dnorm_block(s1, s3)),
+                std::max(std::max(dnorm_block(s2, s3), dnorm_block(s1, s4)),
+                         std::max(dnorm_block(s2, s4), dnorm_block(s3, s4))));
+            if (dnorm_1234 * schwarzscreen_(s1, s2) * schwarzscreen_(s3, s4) <
+                fock_precision) {
+              continue;
+            }
+
+            const std::array<Index, 4> start = {starts_[s1], starts_[s2],
+                                                starts_[s3], starts_[s4]};
+            const std::array<Index, 4> size = {
+                n1, Index(basis_[s2].size()), n3, n4};
+            Index s12_deg = (s1 == s2) ? 1 : 2;
+            Index s34_deg = (s3 == s4) ? 1 : 2;
+            Index s12_34_deg = (s1 == s3) ? (s2 == s4 ? 1 : 2) : 2;
+            double s1234_deg = double(s12_deg * s34_deg * s12_34_deg);
+
+            if (quartet == nullptr) {
+              engine.compute2<libint2::Operator::coulomb,
+                              libint2::BraKet::xx_xx, 0>(
+                  basis_[s1], basis_[s2], basis_[s3], basis_[s4],
+                  &shellpairdata_[s1][pair], &sp34);
+              const auto* buf_1234 = buf[0];
+              if (buf_1234 == nullptr) {
+                continue;  // if all integrals screened out, skip to next
+                           // quartet
               }
+              ContractQuartet<with_exchange>(buf_1234, start, size,
+                                             s1234_deg, rows_2[i], dmat,
+                                             fock);
+            } else if (quartet->storage == CachedQuartet::Storage::full) {
+              ContractQuartet<with_exchange>(
+                  cached->values.data() + quartet->offset, start, size,
+                  s1234_deg, rows_2[i], dmat, fock);
+            } else if (quartet->storage == CachedQuartet::Storage::single) {
+              ContractQuartet<with_exchange>(
+                  cached->values_single.data() + quartet->offset, start,
+                  size, s1234_deg, rows_2[i], dmat, fock);
+            } else {
+              continue;
             }
+            ket_computed = true;
           }
+          if (ket_computed) {
+            FlushBuffer(hartree, starts_[s3], starts_[s4],
+                        fock.hartree_34.topLeftCorner(n3, n4));
+          }
+        }
+      }
+
+      FlushBuffer(hartree, starts_[s1], 0, fock.hartree_1);
+      if (with_exchange) {
+        FlushBuffer(exchange, starts_[s1], 0, fock.exchange_1);
+        for (Index pair = task.begin; pair < task.end; ++pair) {
+          const Index s2 = shellpairs_[s1][pair];
+          FlushBuffer(exchange, starts_[s2], 0,
+                      fock.exchange_2.middleRows(rows_2[pair - task.begin],
+                                                 Index(basis_[s2].size())));
         }
       }
     }
@@ -435,6 +749,38 @@ template std::array<Eigen::MatrixXd, 2> ERIs::Compute4c<true>(
 template std::array<Eigen::MatrixXd, 2> ERIs::Compute4c<false>(
     const Eigen::MatrixXd& dmat, double error) const;
 
+Eigen::MatrixXd SeminumericalExchange::ContractPotentials(
+    const std::vector<Eigen::Vector3d>& points, const Eigen::MatrixXd& F,
+    const ShellSelection& rows, const ShellSelection& cols,
+    const std::vector<std::vector<Index>>& pairs) const {
+  Eigen::MatrixXd G = Eigen::MatrixXd::Zero(rows.size, F.cols());
+  // a unit point charge gives -A(g)
+  libint2::Engine engine(libint2::Operator::nuclear, int(maxnprim_),
+                         int(maxL_), 0);
+  const libint2::Engine::target_ptr_vec& buf = engine.results();
+  for (Index g = 0; g < Index(points.size()); g++) {
+    const Eigen::Vector3d& point = points[g];
+    engine.set_params(std::vector<std::pair<double, std::array<double, 3>>>{
+        {1.0, {point.x(), point.y(), point.z()}}});
+    for (Index r = 0; r < Index(rows.shells.size()); r++) {
+      const libint2::Shell& shell1 = shells_[rows.shells[r]];
+      const Index n1 = Index(shell1.size());
+      for (Index c : pairs[r]) {
+        const libint2::Shell& shell2 = shells_[cols.shells[c]];
+        engine.compute(shell1, shell2);
+        if (buf[0] == nullptr) {
+          continue;
+        }
+        const Index n2 = Index(shell2.size());
+        Eigen::Map<const MatrixLibInt> potential(buf[0], n1, n2);
+        G.col(g).segment(rows.start[r], n1) +=
+            potential * F.col(g).segment(cols.start[c], n2);
+      }
+    }
+  }
+  return G;
+}
+
 void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
   {
     AOCoulomb auxAOcoulomb;
@@ -442,15 +788,30 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
     inv_sqrt_ = auxAOcoulomb.Pseudo_InvSqrt(1e-8);
     removedfunctions_ = auxAOcoulomb.Removedfunctions();
   }
-  matrix_ = std::vector<Symmetric_Matrix>(auxbasis.AOBasisSize());
-
-#pragma omp parallel for schedule(dynamic, 4)
-  for (Index i = 0; i < auxbasis.AOBasisSize(); i++) {
-    matrix_[i] = Symmetric_Matrix(dftbasis.AOBasisSize());
+  dftsize_ = dftbasis.AOBasisSize();
+  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
+  std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
+  // the diagonal shell pair is always significant and the last in the list
+  std::vector<std::vector<Index>> shellpairs = dftbasis.ComputeShellPairs();
+
+  segments_.clear();
+  std::vector<Index> rowstart(dftsize_);
+  Index packedsize = 0;
+  for (Index s1 = 0; s1 < Index(dftshells.size()); s1++) {
+    for (Index i = 0; i < Index(dftshells[s1].size()); i++) {
+      const Index row = shell2bf[s1] + i;
+      rowstart[row] = packedsize;
+      for (Index s2 : shellpairs[s1]) {
+        const Index size = (s2 == s1) ? i + 1 : Index(dftshells[s2].size());
+        segments_.push_back({row, shell2bf[s2], size, packedsize});
+        packedsize += size;
+      }
+    }
   }
+  BuildSparsityPattern();
+  matrix_ = Eigen::MatrixXd(packedsize, auxbasis.AOBasisSize());
 
   Index nthreads = OPENMP::getMaxThreads();
-  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
   std::vector<libint2::Shell> auxshells = auxbasis.GenerateLibintBasis();
   std::vector<libint2::Engine> engines(nthreads);
   engines[0] = libint2::Engine(
@@ -462,7 +823,6 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
     engines[i] = engines[0];
   }
 
-  std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
   std::vector<Index> auxshell2bf = auxbasis.getMapToBasisFunctions();
 
 #pragma omp parallel for schedule(dynamic)
@@ -472,9 +832,15 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
     const libint2::Engine::target_ptr_vec& buf = engine.results();
     const libint2::Shell& dftshell = dftshells[is];
     Index start = shell2bf[is];
+    const std::vector<Index>& pairs = shellpairs[is];
+    // position of the significant shells in the packed rows of this shell
+    std::vector<Index> coloffset(pairs.size(), 0);
+    for (Index k = 1; k < Index(pairs.size()); k++) {
+      coloffset[k] = coloffset[k - 1] + dftshells[pairs[k - 1]].size();
+    }
     std::vector<Eigen::MatrixXd> block(dftshell.size());
     for (Index i = 0; i < Index(dftshell.size()); i++) {
-      Index size = start + i + 1;
+      Index size = coloffset.back() + i + 1;
       block[i] = Eigen::MatrixXd::Zero(auxbasis.AOBasisSize(), size);
     }
 
@@ -482,10 +848,10 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
       const libint2::Shell& auxshell = auxshells[aux];
       Index aux_start = auxshell2bf[aux];
 
-      for (Index dis = 0; dis <= is; dis++) {
+      for (Index k = 0; k < Index(pairs.size()); k++) {
 
-        const libint2::Shell& shell_col = dftshells[dis];
-        Index col_start = shell2bf[dis];
+        const libint2::Shell& shell_col = dftshells[pairs[k]];
+        Index col_start = shell2bf[pairs[k]];
         engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xx, 0>(
             auxshell, libint2::Shell::unit(), dftshell, shell_col);
 
@@ -502,7 +868,7 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
               if ((col_start + col) > (start + left)) {
                 break;
               }
-              block[left](aux_start + auxf, col_start + col) =
+              block[left](aux_start + auxf, coloffset[k] + col) =
                   result(auxf, left, col);
             }
           }
@@ -510,13 +876,11 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
       }
     }
 
+    // row i+start of the lower triangle is contiguous in the packed storage
     for (Index i = 0; i < Index(block.size()); ++i) {
-      Eigen::MatrixXd temp = inv_sqrt_ * block[i];
-      for (Index mu = 0; mu < temp.rows(); ++mu) {
-        for (Index j = 0; j < temp.cols(); ++j) {
-          matrix_[mu](i + start, j) = temp(mu, j);
-        }
-      }
+      matrix_.middleRows(rowstart[i + start], block[i].cols())
+          .transpose()
+          .noalias() = inv_sqrt_ * block[i];
     }
   }
 
@@ -526,11 +890,13 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
 /*
  * Determines the 3-center integrals for a given shell in the aux basis
  * by calculating the 3-center repulsion integral of the functions in the
- * aux shell with ALL functions in the DFT basis set
+ * aux shell with ALL functions in the DFT basis set, the blocks of shell
+ * pairs which are not in shellpairs are zero
  */
-std::vector<Eigen::MatrixXd> ComputeAO3cBlock(const libint2::Shell& auxshell,
-                                              const AOBasis& dftbasis,
-                                              libint2::Engine& engine) {
+std::vector<Eigen::MatrixXd> ComputeAO3cBlock(
+    const libint2::Shell& auxshell, const AOBasis& dftbasis,
+    const std::vector<std::vector<Index>>& shellpairs,
+    libint2::Engine& engine) {
   std::vector<Eigen::MatrixXd> ao3c = std::vector<Eigen::MatrixXd>(
       auxshell.size(),
       Eigen::MatrixXd::Zero(dftbasis.AOBasisSize(), dftbasis.AOBasisSize()));
@@ -545,8 +911,8 @@ std::vector<Eigen::MatrixXd> ComputeAO3cBlock(const libint2::Shell& auxshell,
     const libint2::Shell& shell_row = dftshells[row];
     const Index row_start = shell2bf[row];
     // ThreecMatrix is symmetric, restrict explicit calculation to triangular
-    // matrix
-    for (Index col = 0; col <= row; col++) {
+    // matrix and to shell pairs with significant overlap
+    for (Index col : shellpairs[row]) {
       const libint2::Shell& shell_col = dftshells[col];
       const Index col_start = shell2bf[col];
 
@@ -579,15 +945,68 @@ std::vector<Eigen::MatrixXd> ComputeAO3cBlock(const libint2::Shell& auxshell,
   return ao3c;
 }
 
+/*
+ * Contracts the 3-center integrals of the functions in the aux shell with
+ * the right MO coefficients, sum_b (k|ab) C_bm, on the blocks of the shell
+ * pairs in shellpairs only, so the dense AO matrices are never formed
+ */
+std::vector<Eigen::MatrixXd> ComputeAO3cHalfTransformed(
+    const libint2::Shell& auxshell, const AOBasis& dftbasis,
+    const std::vector<std::vector<Index>>& shellpairs,
+    const Eigen::MatrixXd& right, libint2::Engine& engine) {
+  std::vector<Eigen::MatrixXd> half = std::vector<Eigen::MatrixXd>(
+      auxshell.size(),
+      Eigen::MatrixXd::Zero(dftbasis.AOBasisSize(), right.cols()));
+
+  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
+  std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
+
+  const libint2::Engine::target_ptr_vec& buf = engine.results();
+  for (Index row = 0; row < Index(dftshells.size()); row++) {
+    const libint2::Shell& shell_row = dftshells[row];
+    const Index row_start = shell2bf[row];
+    const Index row_size = Index(shell_row.size());
+    for (Index col : shellpairs[row]) {
+      const libint2::Shell& shell_col = dftshells[col];
+      const Index col_start = shell2bf[col];
+      const Index col_size = Index(shell_col.size());
+
+      engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xx, 0>(
+          auxshell, libint2::Shell::unit(), shell_col, shell_row);
+
+      if (buf[0] == nullptr) {
+        continue;
+      }
+      for (Index aux_c = 0; aux_c < Index(auxshell.size()); aux_c++) {
+        // the row-major (col, row) block of libint is the column major
+        // (row, col) block
+        Eigen::Map<const Eigen::MatrixXd> block(
+            buf[0] + aux_c * col_size * row_size, row_size, col_size);
+        half[aux_c].middleRows(row_start, row_size).noalias() +=
+            block * right.middleRows(col_start, col_size);
+        // only the lower triangle of shell pairs is computed
+        if (col != row) {
+          half[aux_c].middleRows(col_start, col_size).noalias() +=
+              block.transpose() * right.middleRows(row_start, row_size);
+        }
+      }
+    }
+  }
+  return half;
+}
+
 void TCMatrix_gwbse::Fill3cMO(const AOBasis& auxbasis, const AOBasis& dftbasis,
                               const Eigen::MatrixXd& dft_orbitals) {
 
   const Eigen::MatrixXd dftm = dft_orbitals.middleCols(mmin_, mtotal_);
-  const Eigen::MatrixXd dftn =
-      dft_orbitals.middleCols(nmin_, ntotal_).transpose();
+  const Eigen::MatrixXd dftn_T = dft_orbitals.middleCols(nmin_, ntotal_);
+  const Eigen::MatrixXd dftn = dftn_T.transpose();
 
   OpenMP_CUDA transform;
-  transform.setOperators(dftn, dftm);
+  const bool use_gpus = OpenMP_CUDA::UsingGPUs() > 0;
+  if (use_gpus) {
+    transform.setOperators(dftn, dftm);
+  }
   Index nthreads = OPENMP::getMaxThreads();
 
   std::vector<libint2::Shell> auxshells = auxbasis.GenerateLibintBasis();
@@ -601,6 +1020,7 @@ void TCMatrix_gwbse::Fill3cMO(const AOBasis& auxbasis, const AOBasis& dftbasis,
     engines[i] = engines[0];
   }
   std::vector<Index> auxshell2bf = auxbasis.getMapToBasisFunctions();
+  std::vector<std::vector<Index>> shellpairs = dftbasis.ComputeShellPairs();
 
 #pragma omp parallel
   {
@@ -609,22 +1029,40 @@ void TCMatrix_gwbse::Fill3cMO(const AOBasis& auxbasis, const AOBasis& dftbasis,
     for (Index aux = 0; aux < Index(auxshells.size()); aux++) {
       const libint2::Shell& auxshell = auxshells[aux];
 
-      std::vector<Eigen::MatrixXd> ao3c =
-          ComputeAO3cBlock(auxshell, dftbasis, engines[threadid]);
-
       // this is basically a transpose of AO3c and at the same time the ao->mo
       // transformation
       // we do not want to put it into  matrix_ straight away is because,
       //  matrix_ is shared between all threads and we want a nice clean access
       // pattern to it
       std::vector<Eigen::MatrixXd> block = std::vector<Eigen::MatrixXd>(
-          mtotal_, Eigen::MatrixXd::Zero(ntotal_, ao3c.size()));
-
-      Index dim = static_cast<Index>(ao3c.size());
-      for (Index k = 0; k < dim; ++k) {
-        transform.MultiplyLeftRight(ao3c[k], threadid);
-        for (Index i = 0; i < ao3c[k].cols(); ++i) {
-          block[i].col(k) = ao3c[k].col(i);
+          mtotal_, Eigen::MatrixXd::Zero(ntotal_, auxshell.size()));
+
+      Index dim = static_cast<Index>(auxshell.size());
+      if (use_gpus) {
+        // the GPUs multiply dense matrices
+        std::vector<Eigen::MatrixXd> ao3c = ComputeAO3cBlock(
+            auxshell, dftbasis, shellpairs, engines[threadid]);
+        for (Index k = 0; k < dim; ++k) {
+          transform.MultiplyLeftRight(ao3c[k], threadid);
+          for (Index i = 0; i < ao3c[k].cols(); ++i) {
+            block[i].col(k) = ao3c[k].col(i);
+          }
+        }
+      } else {
+        // the first contraction runs over all significant AO elements, so it
+        // uses the smaller set of MOs, either works as the AO matrices are
+        // symmetric
+        const bool n_first = ntotal_ <= mtotal_;
+        std::vector<Eigen::MatrixXd> half = ComputeAO3cHalfTransformed(
+            auxshell, dftbasis, shellpairs, n_first ? dftn_T : dftm,
+            engines[threadid]);
+        for (Index k = 0; k < dim; ++k) {
+          const Eigen::MatrixXd mo =
+              n_first ? Eigen::MatrixXd(half[k].transpose() * dftm)
+                      : Eigen::MatrixXd(dftn * half[k]);
+          for (Index i = 0; i < mo.cols(); ++i) {
+            block[i].col(k) = mo.col(i);
+          }
         }
       }
 
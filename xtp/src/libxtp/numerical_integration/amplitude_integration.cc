@@ -38,12 +38,15 @@ std::vector<std::vector<double> >
       continue;
     }
     const Eigen::VectorXd amplitude_here = box.ReadFromBigVector(amplitude);
-    const std::vector<Eigen::Vector3d>& points = box.getGridPoints();
     const std::vector<double>& weights = box.getGridWeights();
-    // iterate over gridpoints
-    for (Index p = 0; p < box.size(); p++) {
-      AOShell::AOValues ao = box.CalcAOValues(points[p]);
-      result[i][p] = weights[p] * amplitude_here.dot(ao.values);
+    // iterate over blocks of gridpoints
+    GridBox::AOBlock buffer;
+    for (const GridboxRange& block : box.getPointBlocks()) {
+      const GridBox::AOBlock& ao = box.getAOValues(block, buffer);
+      const Eigen::VectorXd values = ao.values * amplitude_here;
+      for (Index p = 0; p < block.size; p++) {
+        result[i][block.start + p] = weights[block.start + p] * values(p);
+      }
     }
   }
   return result;
@@ -66,6 +66,21 @@ void DensityIntegration<Grid>::SetupDensityContainer() {
   }
 }
 
+template <class Grid>
+Eigen::VectorXd DensityIntegration<Grid>::CalcDensities(
+    const GridBox& box, const GridboxRange& block,
+    const Eigen::MatrixXd& DMAT_here) const {
+  GridBox::AOBlock buffer;
+  const GridBox::AOBlock& ao = box.getAOValues(block, buffer);
+  Eigen::Map<const Eigen::VectorXd> weights(
+      box.getGridWeights().data() + block.start, block.size);
+  return (ao.values * DMAT_here)
+      .cwiseProduct(ao.values)
+      .rowwise()
+      .sum()
+      .cwiseProduct(weights);
+}
+
 template <class Grid>
 double DensityIntegration<Grid>::IntegrateDensity(
     const Eigen::MatrixXd& density_matrix) {
@@ -80,14 +95,12 @@ double DensityIntegration<Grid>::IntegrateDensity(
       continue;
     }
     const Eigen::MatrixXd DMAT_here = box.ReadFromBigMatrix(density_matrix);
-    const std::vector<Eigen::Vector3d>& points = box.getGridPoints();
-    const std::vector<double>& weights = box.getGridWeights();
-    // iterate over gridpoints
-    for (Index p = 0; p < box.size(); p++) {
-      AOShell::AOValues ao = box.CalcAOValues(points[p]);
-      double rho = ao.values.dot(DMAT_here * ao.values) * weights[p];
-      densities_[i][p] = rho;
-      N += rho;
+    // iterate over blocks of gridpoints
+    for (const GridboxRange& block : box.getPointBlocks()) {
+      const Eigen::VectorXd rho = CalcDensities(box, block, DMAT_here);
+      Eigen::Map<Eigen::VectorXd>(densities_[i].data() + block.start,
+                                  block.size) = rho;
+      N += rho.sum();
     }
   }
   return N;
@@ -111,15 +124,16 @@ Gyrationtensor DensityIntegration<Grid>::IntegrateGyrationTensor(
 
     const Eigen::MatrixXd DMAT_here = box.ReadFromBigMatrix(density_matrix);
     const std::vector<Eigen::Vector3d>& points = box.getGridPoints();
-    const std::vector<double>& weights = box.getGridWeights();
-    // iterate over gridpoints
-    for (Index p = 0; p < box.size(); p++) {
-      AOShell::AOValues ao = box.CalcAOValues(points[p]);
-      double rho = ao.values.dot(DMAT_here * ao.values) * weights[p];
-      densities_[i][p] = rho;
-      N += rho;
-      centroid += rho * points[p];
-      gyration += rho * points[p] * points[p].transpose();
+    // iterate over blocks of gridpoints
+    for (const GridboxRange& block : box.getPointBlocks()) {
+      const Eigen::VectorXd rho = CalcDensities(box, block, DMAT_here);
+      for (Index p = 0; p < block.size; p++) {
+        const Eigen::Vector3d& point = points[block.start + p];
+        densities_[i][block.start + p] = rho(p);
+        N += rho(p);
+        centroid += rho(p) * point;
+        gyration += rho(p) * point * point.transpose();
+      }
     }
   }
 
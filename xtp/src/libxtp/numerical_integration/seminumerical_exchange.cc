@@ -0,0 +1,174 @@
+/*
+ *            Copyright 2009-2023 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Local VOTCA includes
+#include "votca/xtp/seminumerical_exchange.h"
+
+namespace votca {
+namespace xtp {
+
+SeminumericalExchange::SeminumericalExchange(const Vxc_Grid& grid,
+                                             const AOBasis& basis,
+                                             double threshold)
+    : grid_(grid),
+      threshold_(threshold),
+      shells_(basis.GenerateLibintBasis()),
+      starts_(basis.getMapToBasisFunctions()),
+      maxnprim_(basis.getMaxNprim()),
+      maxL_(basis.getMaxL()) {
+  // ComputeShellPairs only contains the pairs s2<=s1
+  std::vector<std::vector<Index>> pairs = basis.ComputeShellPairs();
+  neighbours_.resize(pairs.size());
+  for (Index s1 = 0; s1 < Index(pairs.size()); s1++) {
+    for (Index s2 : pairs[s1]) {
+      neighbours_[s1].push_back(s2);
+      if (s2 != s1) {
+        neighbours_[s2].push_back(s1);
+      }
+    }
+  }
+}
+
+void SeminumericalExchange::addShell(ShellSelection& selection,
+                                     Index shell) const {
+  selection.shells.push_back(shell);
+  selection.start.push_back(selection.size);
+  selection.size += Index(shells_[shell].size());
+}
+
+Eigen::MatrixXd SeminumericalExchange::IntegrateEXX(
+    const Eigen::MatrixXd& DMAT) const {
+  const Index nshells = Index(shells_.size());
+  Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
+
+#pragma omp parallel for schedule(guided) reduction(+ : EXX)
+  for (Index i = 0; i < grid_.getBoxesSize(); ++i) {
+    const GridBox& box = grid_[i];
+    if (!box.Matrixsize()) {
+      continue;
+    }
+    const std::vector<const AOShell*>& box_shells = box.getShells();
+    const std::vector<GridboxRange>& box_ranges = box.getAOranges();
+    // rows of the density matrix which belong to the AOs of the box
+    Eigen::MatrixXd DMAT_rows(box.Matrixsize(), DMAT.cols());
+    for (Index j = 0; j < box.Shellsize(); j++) {
+      DMAT_rows.middleRows(box_ranges[j].start, box_ranges[j].size) =
+          DMAT.middleRows(box_shells[j]->getStartIndex(), box_ranges[j].size);
+    }
+    Eigen::MatrixXd EXX_box =
+        Eigen::MatrixXd::Zero(box.Matrixsize(), DMAT.cols());
+    const std::vector<double>& weights = box.getGridWeights();
+    const std::vector<Eigen::Vector3d>& gridpoints = box.getGridPoints();
+
+    GridBox::AOBlock buffer;
+    for (const GridboxRange& block : box.getPointBlocks()) {
+      const GridBox::AOBlock& ao = box.getAOValues(block, buffer);
+      // F_sigma(g), one column per point
+      const Eigen::MatrixXd F = DMAT_rows.transpose() * ao.values.transpose();
+
+      // skip points whose contribution is below the threshold, bound(g)
+      // limits the contribution of the AOs of the box at g
+      std::vector<Index> significant;
+      std::vector<double> bound;
+      for (Index p = 0; p < block.size; p++) {
+        const double b = std::abs(weights[block.start + p]) *
+                         ao.values.row(p).cwiseAbs().maxCoeff();
+        if (b * F.col(p).cwiseAbs().maxCoeff() >= threshold_) {
+          significant.push_back(p);
+          bound.push_back(b);
+        }
+      }
+      if (significant.empty()) {
+        continue;
+      }
+      const Index nsignificant = Index(significant.size());
+      std::vector<Eigen::Vector3d> points(nsignificant);
+      Eigen::MatrixXd ao_weighted(nsignificant, box.Matrixsize());
+      Eigen::MatrixXd F_bound(F.rows(), nsignificant);
+      for (Index s = 0; s < nsignificant; s++) {
+        const Index p = significant[s];
+        points[s] = gridpoints[block.start + p];
+        ao_weighted.row(s) = weights[block.start + p] * ao.values.row(p);
+        F_bound.col(s) = bound[s] * F.col(p).cwiseAbs();
+      }
+
+      // shells sigma with significant F on this block, and the shells nu
+      // which overlap with them
+      ShellSelection cols;
+      std::vector<Index> position(nshells, -1);
+      for (Index shell = 0; shell < nshells; shell++) {
+        if (F_bound.middleRows(starts_[shell], shells_[shell].size())
+                .maxCoeff() >= threshold_) {
+          position[shell] = Index(cols.shells.size());
+          addShell(cols, shell);
+        }
+      }
+      std::vector<bool> overlaps(nshells, false);
+      for (Index shell : cols.shells) {
+        for (Index neighbour : neighbours_[shell]) {
+          overlaps[neighbour] = true;
+        }
+      }
+      ShellSelection rows;
+      std::vector<std::vector<Index>> pairs;
+      for (Index shell = 0; shell < nshells; shell++) {
+        if (!overlaps[shell]) {
+          continue;
+        }
+        addShell(rows, shell);
+        pairs.emplace_back();
+        for (Index neighbour : neighbours_[shell]) {
+          if (position[neighbour] >= 0) {
+            pairs.back().push_back(position[neighbour]);
+          }
+        }
+      }
+
+      Eigen::MatrixXd F_cols(cols.size, nsignificant);
+      for (Index c = 0; c < Index(cols.shells.size()); c++) {
+        const Index shell = cols.shells[c];
+        const Index size = Index(shells_[shell].size());
+        for (Index s = 0; s < nsignificant; s++) {
+          F_cols.col(s).segment(cols.start[c], size) =
+              F.col(significant[s]).segment(starts_[shell], size);
+        }
+      }
+      const Eigen::MatrixXd G =
+          ContractPotentials(points, F_cols, rows, cols, pairs);
+      const Eigen::MatrixXd EXX_block = ao_weighted.transpose() * G.transpose();
+      for (Index r = 0; r < Index(rows.shells.size()); r++) {
+        const Index shell = rows.shells[r];
+        const Index size = Index(shells_[shell].size());
+        EXX_box.middleCols(starts_[shell], size) +=
+            EXX_block.middleCols(rows.start[r], size);
+      }
+    }
+
+    for (Index j = 0; j < box.Shellsize(); j++) {
+      EXX.middleRows(box_shells[j]->getStartIndex(), box_ranges[j].size) +=
+          EXX_box.middleRows(box_ranges[j].start, box_ranges[j].size);
+    }
+  }
+  // only the first electron is integrated on the grid, which breaks the
+  // symmetry of the exact matrix slightly
+  return 0.5 * (EXX + EXX.transpose());
+}
+
+}  // namespace xtp
+}  // namespace votca
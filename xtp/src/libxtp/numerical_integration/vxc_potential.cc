@@ -121,33 +121,34 @@ void Vxc_Potential<Grid>::setXCfunctional(const std::string& functional) {
 }
 template <class Grid>
 typename Vxc_Potential<Grid>::XC_entry Vxc_Potential<Grid>::EvaluateXC(
-    double rho, double sigma) const {
-
-  Vxc_Potential<Grid>::XC_entry result;
-  switch (xfunc.info->family) {
-    case XC_FAMILY_LDA:
-      xc_lda_exc_vxc(&xfunc, 1, &rho, &result.f_xc, &result.df_drho);
-      break;
-    case XC_FAMILY_GGA:
-    case XC_FAMILY_HYB_GGA:
-      xc_gga_exc_vxc(&xfunc, 1, &rho, &sigma, &result.f_xc, &result.df_drho,
-                     &result.df_dsigma);
-      break;
-  }
-  if (use_separate_) {
-    typename Vxc_Potential<Grid>::XC_entry temp;
-    // via libxc correlation part only
-    switch (cfunc.info->family) {
+    const Eigen::VectorXd& rho, const Eigen::VectorXd& sigma) const {
+
+  // one call to libxc for the whole block, so it can vectorize over points
+  auto evaluate = [&rho, &sigma](const xc_func_type& func, XC_entry& entry) {
+    const std::size_t npoints = std::size_t(rho.size());
+    entry.f_xc = Eigen::VectorXd::Zero(rho.size());
+    entry.df_drho = Eigen::VectorXd::Zero(rho.size());
+    entry.df_dsigma = Eigen::VectorXd::Zero(rho.size());
+    switch (func.info->family) {
       case XC_FAMILY_LDA:
-        xc_lda_exc_vxc(&cfunc, 1, &rho, &temp.f_xc, &temp.df_drho);
+        xc_lda_exc_vxc(&func, npoints, rho.data(), entry.f_xc.data(),
+                       entry.df_drho.data());
         break;
       case XC_FAMILY_GGA:
       case XC_FAMILY_HYB_GGA:
-        xc_gga_exc_vxc(&cfunc, 1, &rho, &sigma, &temp.f_xc, &temp.df_drho,
-                       &temp.df_dsigma);
+        xc_gga_exc_vxc(&func, npoints, rho.data(), sigma.data(),
+                       entry.f_xc.data(), entry.df_drho.data(),
+                       entry.df_dsigma.data());
         break;
     }
+  };
 
+  Vxc_Potential<Grid>::XC_entry result;
+  evaluate(xfunc, result);
+  if (use_separate_) {
+    typename Vxc_Potential<Grid>::XC_entry temp;
+    // via libxc correlation part only
+    evaluate(cfunc, temp);
     result.f_xc += temp.f_xc;
     result.df_drho += temp.df_drho;
     result.df_dsigma += temp.df_dsigma;
@@ -155,6 +156,7 @@ typename Vxc_Potential<Grid>::XC_entry Vxc_Potential<Grid>::EvaluateXC(
 
   return result;
 }
+
 template <class Grid>
 Mat_p_Energy Vxc_Potential<Grid>::IntegrateVXC(
     const Eigen::MatrixXd& density_matrix) const {
@@ -179,27 +181,57 @@ Mat_p_Energy Vxc_Potential<Grid>::IntegrateVXC(
     }
     Eigen::MatrixXd Vxc_here =
         Eigen::MatrixXd::Zero(DMAT_here.rows(), DMAT_here.cols());
-    const std::vector<Eigen::Vector3d>& points = box.getGridPoints();
     const std::vector<double>& weights = box.getGridWeights();
 
-    // iterate over gridpoints
-    for (Index p = 0; p < box.size(); p++) {
-      AOShell::AOValues ao = box.CalcAOValues(points[p]);
-      Eigen::VectorXd temp = ao.values.transpose() * DMAT_here;
-      double rho = 0.5 * temp.dot(ao.values);
-      const double weight = weights[p];
-      if (rho * weight < 1.e-20) {
-        continue;  // skip the rest, if density is very small
+    // iterate over blocks of gridpoints, AO values are (points x AOs)
+    GridBox::AOBlock buffer;
+    for (const GridboxRange& block : box.getPointBlocks()) {
+      const GridBox::AOBlock& ao = box.getAOValues(block, buffer);
+      const Eigen::MatrixXd temp = ao.values * DMAT_here;
+      const Eigen::VectorXd rho =
+          0.5 * temp.cwiseProduct(ao.values).rowwise().sum();
+      Eigen::MatrixX3d rho_grad(block.size, 3);
+      for (Index k = 0; k < 3; k++) {
+        rho_grad.col(k) = temp.cwiseProduct(ao.derivatives[k]).rowwise().sum();
       }
-      const Eigen::Vector3d rho_grad = temp.transpose() * ao.derivatives;
 
+      // skip points, where the density is very small
+      std::vector<Index> significant;
+      significant.reserve(block.size);
+      for (Index p = 0; p < block.size; p++) {
+        if (rho(p) * weights[block.start + p] >= 1.e-20) {
+          significant.push_back(p);
+        }
+      }
+      if (significant.empty()) {
+        continue;
+      }
+      const Index nsignificant = Index(significant.size());
+      Eigen::VectorXd rho_sig(nsignificant);
+      Eigen::VectorXd sigma_sig(nsignificant);
+      for (Index s = 0; s < nsignificant; s++) {
+        rho_sig(s) = rho(significant[s]);
+        sigma_sig(s) = rho_grad.row(significant[s]).squaredNorm();
+      }
       typename Vxc_Potential<Grid>::XC_entry xc =
-          EvaluateXC(rho, rho_grad.squaredNorm());
-      EXC_box += weight * rho * xc.f_xc;
-      auto grad = ao.derivatives * rho_grad;
-      temp.noalias() =
-          weight * (0.5 * xc.df_drho * ao.values + 2.0 * xc.df_dsigma * grad);
-      Vxc_here.noalias() += temp * ao.values.transpose();
+          EvaluateXC(rho_sig, sigma_sig);
+
+      // prefactors of the AO values and gradients of each point
+      Eigen::VectorXd value_factor = Eigen::VectorXd::Zero(block.size);
+      Eigen::MatrixX3d grad_factor = Eigen::MatrixX3d::Zero(block.size, 3);
+      for (Index s = 0; s < nsignificant; s++) {
+        const Index p = significant[s];
+        const double weight = weights[block.start + p];
+        EXC_box += weight * rho(p) * xc.f_xc(s);
+        value_factor(p) = 0.5 * weight * xc.df_drho(s);
+        grad_factor.row(p) = 2.0 * weight * xc.df_dsigma(s) * rho_grad.row(p);
+      }
+      Eigen::MatrixXd weighted = value_factor.asDiagonal() * ao.values;
+      for (Index k = 0; k < 3; k++) {
+        weighted.noalias() +=
+            grad_factor.col(k).asDiagonal() * ao.derivatives[k];
+      }
+      Vxc_here.noalias() += weighted.transpose() * ao.values;
     }
     box.AddtoBigMatrix(vxc.matrix(), Vxc_here);
     vxc.energy() += EXC_box;
@@ -26,6 +26,7 @@
 // Local VOTCA includes
 #include "votca/tools/version.h"
 #include "votca/xtp/aomatrix.h"
+#include "votca/xtp/dftcache.h"
 #include "votca/xtp/orbitals.h"
 #include "votca/xtp/orbreorder.h"
 #include "votca/xtp/qmstate.h"
@@ -91,18 +92,14 @@ void Orbitals::SetupDftBasis(std::string basis_name) {
   if (this->QMAtoms().size() == 0) {
     throw std::runtime_error("Can't setup AOBasis without atoms");
   }
-  BasisSet bs;
-  bs.Load(basis_name);
-  dftbasis_.Fill(bs, this->QMAtoms());
+  dftbasis_.Fill(*DFTCache::getBasisSet(basis_name), this->QMAtoms());
 }
 
 void Orbitals::SetupAuxBasis(std::string aux_basis_name) {
   if (this->QMAtoms().size() == 0) {
     throw std::runtime_error("Can't setup Aux AOBasis without atoms");
   }
-  BasisSet bs;
-  bs.Load(aux_basis_name);
-  auxbasis_.Fill(bs, this->QMAtoms());
+  auxbasis_.Fill(*DFTCache::getBasisSet(aux_basis_name), this->QMAtoms());
 }
 
 /*
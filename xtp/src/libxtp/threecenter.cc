@@ -17,6 +17,9 @@
  *
  */
 
+// Standard includes
+#include <numeric>
+
 // Local VOTCA includes
 #include "votca/xtp/threecenter.h"
 #include "votca/xtp/aomatrix.h"
@@ -26,6 +29,65 @@
 namespace votca {
 namespace xtp {
 
+Eigen::VectorXd TCMatrix_dft::Pack(const Eigen::MatrixXd& full,
+                                   double offdiag_factor) const {
+  assert(full.rows() == dftsize_ && full.cols() == dftsize_ &&
+         "Matrix does not match dft basis");
+  Eigen::VectorXd packed(matrix_.rows());
+  for (const Segment& seg : segments_) {
+    // the upper triangle is read, its columns are contiguous
+    packed.segment(seg.start, seg.size) =
+        offdiag_factor * full.col(seg.row).segment(seg.col, seg.size);
+    if (seg.col + seg.size > seg.row) {
+      packed[seg.start + seg.size - 1] = full(seg.row, seg.row);
+    }
+  }
+  return packed;
+}
+
+void TCMatrix_dft::Unpack(const Eigen::Ref<const Eigen::VectorXd>& packed,
+                          Eigen::Ref<Eigen::MatrixXd> full) const {
+  assert(packed.size() == matrix_.rows() && full.rows() == dftsize_ &&
+         "Packed size does not match matrix");
+  full.setZero();
+  // a row of the packed lower triangle is a column of the upper triangle
+  for (const Segment& seg : segments_) {
+    full.col(seg.row).segment(seg.col, seg.size) =
+        packed.segment(seg.start, seg.size);
+  }
+  full.triangularView<Eigen::StrictlyLower>() = full.transpose();
+}
+
+void TCMatrix_dft::BuildSparsityPattern() {
+  pattern_.outer = std::vector<Index>(dftsize_ + 1, 0);
+  for (const Segment& seg : segments_) {
+    for (Index col = seg.col; col < seg.col + seg.size; col++) {
+      pattern_.outer[col + 1]++;
+      if (col != seg.row) {
+        pattern_.outer[seg.row + 1]++;
+      }
+    }
+  }
+  std::partial_sum(pattern_.outer.begin(), pattern_.outer.end(),
+                   pattern_.outer.begin());
+  pattern_.inner.resize(pattern_.outer.back());
+  pattern_.position.resize(pattern_.outer.back());
+  // the segments are ordered by row, so the row indices of every column are
+  // added in ascending order
+  std::vector<Index> next(pattern_.outer.begin(), pattern_.outer.end() - 1);
+  for (const Segment& seg : segments_) {
+    for (Index i = 0; i < seg.size; i++) {
+      const Index col = seg.col + i;
+      pattern_.inner[next[col]] = seg.row;
+      pattern_.position[next[col]++] = seg.start + i;
+      if (col != seg.row) {
+        pattern_.inner[next[seg.row]] = col;
+        pattern_.position[next[seg.row]++] = seg.start + i;
+      }
+    }
+  }
+}
+
 void TCMatrix_gwbse::Initialize(Index basissize, Index mmin, Index mmax,
                                 Index nmin, Index nmax) {
 
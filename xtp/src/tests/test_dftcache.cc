@@ -0,0 +1,115 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE dftcache_test
+
+// Standard includes
+#include <filesystem>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/dftcache.h"
+using namespace votca::xtp;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(dftcache_test)
+
+BOOST_AUTO_TEST_CASE(basisset_test) {
+  DFTCache::Clear();
+  const std::string basisname =
+      std::string(XTP_TEST_DATA_FOLDER) + "/ecpaobasis/3-21G.xml";
+  std::shared_ptr<const BasisSet> basis = DFTCache::getBasisSet(basisname);
+  BOOST_CHECK_EQUAL(basis->getElement("C").NumOfShells(), 5);
+  BOOST_CHECK(basis == DFTCache::getBasisSet(basisname));
+
+  const std::string ecpname =
+      std::string(XTP_TEST_DATA_FOLDER) + "/ecpaobasis/ecp.xml";
+  std::shared_ptr<const ECPBasisSet> ecp = DFTCache::getECPBasisSet(ecpname);
+  BOOST_CHECK(ecp == DFTCache::getECPBasisSet(ecpname));
+
+  // objects handed out before stay valid
+  DFTCache::Clear();
+  BOOST_CHECK_EQUAL(basis->getElement("C").NumOfShells(), 5);
+  BOOST_CHECK(basis != DFTCache::getBasisSet(basisname));
+
+  BOOST_CHECK_THROW(DFTCache::getBasisSet("doesnotexist.xml"),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(elementgrid_test) {
+  DFTCache::Clear();
+  GridContainers::radial_grid radial;
+  radial.radius = Eigen::VectorXd::LinSpaced(4, 0.5, 2.0);
+  radial.weight = Eigen::VectorXd::Ones(4);
+
+  Index builds = 0;
+  auto build = [&builds]() {
+    builds++;
+    DFTCache::ElementGrid grid(3);
+    return grid;
+  };
+  auto grid = DFTCache::getElementGrid("C", "medium", radial, build);
+  BOOST_CHECK_EQUAL(grid->size(), 3);
+  BOOST_CHECK(grid == DFTCache::getElementGrid("C", "medium", radial, build));
+  BOOST_CHECK_EQUAL(builds, 1);
+
+  // other element, grid type or radial extent give new grids
+  DFTCache::getElementGrid("H", "medium", radial, build);
+  DFTCache::getElementGrid("C", "fine", radial, build);
+  radial.radius[3] = 3.0;
+  DFTCache::getElementGrid("C", "medium", radial, build);
+  BOOST_CHECK_EQUAL(builds, 4);
+
+  // the number of stored grids is bounded, the oldest ones are dropped
+  for (Index i = 0; i < DFTCache::MaxElementGrids; ++i) {
+    radial.radius[3] = 4.0 + double(i);
+    DFTCache::getElementGrid("C", "medium", radial, build);
+  }
+  BOOST_CHECK_EQUAL(builds, 4 + DFTCache::MaxElementGrids);
+  radial.radius[3] = 2.0;
+  BOOST_CHECK(grid != DFTCache::getElementGrid("C", "medium", radial, build));
+  BOOST_CHECK_EQUAL(builds, 5 + DFTCache::MaxElementGrids);
+  // grids returned before stay valid
+  BOOST_CHECK_EQUAL(grid->size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(atomicdensity_test) {
+  DFTCache::Clear();
+  const std::string directory = "atomicdensities";
+  std::filesystem::remove_all(directory);
+  Eigen::MatrixXd dmat = Eigen::MatrixXd::Random(5, 5);
+
+  BOOST_CHECK(DFTCache::getAtomicDensity("C basis:a") == nullptr);
+  BOOST_CHECK(DFTCache::addAtomicDensity("C basis:a", dmat));
+  BOOST_CHECK(DFTCache::getAtomicDensity("C basis:a")->isApprox(dmat, 0.0));
+  BOOST_CHECK(DFTCache::getAtomicDensity("C basis:b") == nullptr);
+
+  // another process only sees the densities written to the directory
+  BOOST_CHECK(DFTCache::addAtomicDensity("O basis:a", dmat, directory));
+  DFTCache::Clear();
+  BOOST_CHECK(DFTCache::getAtomicDensity("C basis:a", directory) == nullptr);
+  std::shared_ptr<const Eigen::MatrixXd> read =
+      DFTCache::getAtomicDensity("O basis:a", directory);
+  BOOST_REQUIRE(read != nullptr);
+  BOOST_CHECK(read->isApprox(dmat, 0.0));
+  BOOST_CHECK(DFTCache::getAtomicDensity("O basis:a") == read);
+  std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,9 @@
 
 #define BOOST_TEST_MODULE dftengine_test
 
+// Standard includes
+#include <sstream>
+
 // Third party includes
 #include <boost/test/unit_test.hpp>
 
@@ -146,11 +149,17 @@ BOOST_AUTO_TEST_CASE(dft_full) {
   prop.LoadFromXML("dftengine2.xml");
 
   Logger log;
+  log.setReportLevel(Log::info);
   dft.setLogger(&log);
   dft.Initialize(prop.get("dftpackage"));
   dft.Evaluate(orb);
 
   BOOST_CHECK_CLOSE(orb.getDFTTotalEnergy(), -75.891017293070945, 1e-5);
+  // without ao_cache options the AO values are recomputed
+  std::stringstream output;
+  output << log;
+  BOOST_CHECK(output.str().find("AO values on the grid cached") ==
+              std::string::npos);
 
   Eigen::VectorXd MOs_energy_ref = Eigen::VectorXd::Zero(13);
   MOs_energy_ref << -19.0739, -1.01904, -0.520731, -0.341996, -0.27356,
@@ -187,6 +196,74 @@ BOOST_AUTO_TEST_CASE(dft_full) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(dft_cosx) {
+  libint2::initialize();
+  DFTEngine dft;
+
+  WriteBasis321G();
+
+  Orbitals orb;
+  orb.QMAtoms() = Water();
+
+  std::ofstream xml("dftengine_cosx.xml");
+  xml << "<dftpackage>" << std::endl;
+  xml << "<spin>1</spin>" << std::endl;
+  xml << "<name>xtp</name>" << std::endl;
+  xml << "<charge>0</charge>" << std::endl;
+  xml << "<functional>XC_HYB_GGA_XC_PBEH</functional>" << std::endl;
+  xml << "<basisset>3-21G.xml</basisset>" << std::endl;
+  xml << "<initial_guess>independent</initial_guess>" << std::endl;
+  xml << "<xtpdft>" << std::endl;
+  xml << "<screening_eps>1e-9</screening_eps>\n";
+  xml << "<fock_matrix_reset>5</fock_matrix_reset>\n";
+  xml << "<convergence>" << std::endl;
+  xml << "    <energy>1e-7</energy>" << std::endl;
+  xml << "    <method>DIIS</method>" << std::endl;
+  xml << "    <DIIS_start>0.002</DIIS_start>" << std::endl;
+  xml << "    <ADIIS_start>0.8</ADIIS_start>" << std::endl;
+  xml << "    <DIIS_length>20</DIIS_length>" << std::endl;
+  xml << "    <levelshift>0.0</levelshift>" << std::endl;
+  xml << "    <levelshift_end>0.2</levelshift_end>" << std::endl;
+  xml << "    <max_iterations>100</max_iterations>\n";
+  xml << "    <error>1e-7</error>\n";
+  xml << "    <DIIS_maxout>false</DIIS_maxout>\n";
+  xml << "    <mixing>0.7</mixing>\n";
+  xml << "</convergence>" << std::endl;
+  xml << "<integration_grid>xcoarse</integration_grid>" << std::endl;
+  xml << "<exact_exchange>cosx</exact_exchange>" << std::endl;
+  xml << "<max_iterations>200</max_iterations>" << std::endl;
+  xml << "</xtpdft>" << std::endl;
+  xml << "</dftpackage>" << std::endl;
+  xml.close();
+  votca::tools::Property prop;
+  prop.LoadFromXML("dftengine_cosx.xml");
+
+  Logger log;
+  dft.setLogger(&log);
+  dft.Initialize(prop.get("dftpackage"));
+  BOOST_CHECK(dft.Evaluate(orb));
+  std::stringstream output;
+  output << log;
+  BOOST_CHECK(output.str().find("Exact exchange integrated seminumerically") !=
+              std::string::npos);
+
+  // same system as dft_full, only the exact exchange is integrated on the
+  // grid
+  BOOST_CHECK_CLOSE(orb.getDFTTotalEnergy(), -75.891017293070945, 1e-2);
+
+  libint2::finalize();
+}
+
+BOOST_AUTO_TEST_CASE(ao_cache_default) {
+  // the cache is opt in, parallel jobs would otherwise each keep their own
+  votca::tools::Property defaults;
+  defaults.LoadFromXML(std::string(XTP_TEST_DATA_FOLDER) +
+                       "/../../../share/xtp/xml/subpackages/dftpackage.xml");
+  BOOST_CHECK_EQUAL(defaults.get("dftpackage.xtpdft.ao_cache.memory")
+                        .getAttribute<double>("default"),
+                    0.0);
+}
+
 BOOST_AUTO_TEST_CASE(density_guess) {
   libint2::initialize();
   DFTEngine dft;
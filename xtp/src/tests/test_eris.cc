@@ -90,6 +90,13 @@ BOOST_AUTO_TEST_CASE(fourcenter) {
   }
   BOOST_CHECK_EQUAL(exxs_check, 1);
 
+  // semi-direct, all quartets fit into the memory
+  BOOST_CHECK_GT(eris.CacheIntegrals(100), 0.0);
+  std::array<Eigen::MatrixXd, 2> both_cached =
+      eris.CalculateERIs_EXX_4c(dmat, 1e-20);
+  BOOST_CHECK(both_cached[0].isApprox(both[0], 1e-10));
+  BOOST_CHECK(both_cached[1].isApprox(both[1], 1e-10));
+
   libint2::finalize();
 }
 
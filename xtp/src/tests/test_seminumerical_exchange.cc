@@ -0,0 +1,70 @@
+/*
+ * Copyright 2009-2023 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <libint2/initialize.h>
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE seminumerical_exchange_test
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/eigenio_matrixmarket.h"
+#include "votca/xtp/qmmolecule.h"
+#include "votca/xtp/seminumerical_exchange.h"
+
+using namespace votca::xtp;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(seminumerical_exchange_test)
+
+BOOST_AUTO_TEST_CASE(compare_to_4c) {
+  libint2::initialize();
+  QMMolecule mol("none", 0);
+  mol.LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) + "/eris/molecule.xyz");
+  BasisSet basis;
+  basis.Load(std::string(XTP_TEST_DATA_FOLDER) + "/eris/3-21G.xml");
+  AOBasis aobasis;
+  aobasis.Fill(basis, mol);
+
+  Eigen::MatrixXd dmat = votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+      std::string(XTP_TEST_DATA_FOLDER) + "/eris/dmat.mm");
+  Eigen::MatrixXd exx_ref = -votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+      std::string(XTP_TEST_DATA_FOLDER) + "/eris/exx_ref.mm");
+
+  Vxc_Grid grid;
+  grid.GridSetup("fine", mol, aobasis);
+
+  SeminumericalExchange cosx(grid, aobasis, 1e-10);
+  Eigen::MatrixXd exx = cosx.IntegrateEXX(dmat);
+
+  // the error of the grid is much larger than the one of the screening
+  double error = (exx - exx_ref).cwiseAbs().maxCoeff();
+  BOOST_CHECK_LT(error, 2e-3);
+  if (error >= 2e-3) {
+    std::cout << "result exx" << std::endl;
+    std::cout << exx << std::endl;
+    std::cout << "ref exx" << std::endl;
+    std::cout << exx_ref << std::endl;
+  }
+
+  SeminumericalExchange cosx_unscreened(grid, aobasis, 0.0);
+  BOOST_CHECK(exx.isApprox(cosx_unscreened.IntegrateEXX(dmat), 1e-6));
+
+  libint2::finalize();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,7 @@
 #include "votca/xtp/vxc_grid.h"
 #include <libint2/initialize.h>
 using namespace votca::xtp;
+using votca::Index;
 using namespace std;
 
 BOOST_AUTO_TEST_SUITE(vxc_grid_test)
@@ -59,4 +60,98 @@ BOOST_AUTO_TEST_CASE(vxc_grid_build) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(gridbox_aoblock) {
+  libint2::initialize();
+  QMMolecule mol("none", 0);
+
+  mol.LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                   "/vxc_grid/molecule.xyz");
+  AOBasis aobasis = CreateBasis(mol);
+
+  Vxc_Grid grid;
+  grid.GridSetup("medium", mol, aobasis);
+
+  for (const GridBox& box : grid) {
+    Index npoints = 0;
+    for (const GridboxRange& block : box.getPointBlocks(100)) {
+      BOOST_CHECK_EQUAL(block.start, npoints);
+      BOOST_CHECK(block.size <= 100);
+      npoints += block.size;
+
+      GridBox::AOBlock ao = box.CalcAOValues(block);
+      BOOST_CHECK_EQUAL(ao.values.rows(), block.size);
+      BOOST_CHECK_EQUAL(ao.values.cols(), box.Matrixsize());
+      for (Index p = 0; p < block.size; p += 17) {
+        AOShell::AOValues ref =
+            box.CalcAOValues(box.getGridPoints()[block.start + p]);
+        BOOST_CHECK(ao.values.row(p).transpose().isApprox(ref.values, 1e-12));
+        for (Index k = 0; k < 3; k++) {
+          BOOST_CHECK(ao.derivatives[k].row(p).transpose().isApprox(
+              ref.derivatives.col(k), 1e-12));
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(npoints, box.size());
+  }
+
+  libint2::finalize();
+}
+
+BOOST_AUTO_TEST_CASE(gridbox_aocache) {
+  libint2::initialize();
+  QMMolecule mol("none", 0);
+
+  mol.LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                   "/vxc_grid/molecule.xyz");
+  AOBasis aobasis = CreateBasis(mol);
+
+  Vxc_Grid grid;
+  grid.GridSetup("medium", mol, aobasis);
+  Vxc_Grid grid_double = grid;
+  Vxc_Grid grid_single = grid;
+  // no memory, no cache
+  BOOST_CHECK_EQUAL(grid.CacheAOValues(0.0, false), 0.0);
+  BOOST_CHECK_GT(grid_double.CacheAOValues(1000.0, false), 0.0);
+  BOOST_CHECK_GT(grid_single.CacheAOValues(1000.0, true), 0.0);
+  // copies share the cache
+  Vxc_Grid copy = grid_double;
+
+  for (Index i = 0; i < grid.getBoxesSize(); i++) {
+    const GridBox& box = grid[i];
+    if (box.Matrixsize() == 0) {
+      continue;
+    }
+    BOOST_CHECK(!box.hasAOCache());
+    BOOST_CHECK(copy[i].hasAOCache());
+    for (const GridboxRange& block : box.getPointBlocks()) {
+      GridBox::AOBlock ref = box.CalcAOValues(block);
+      GridBox::AOBlock buffer;
+      const GridBox::AOBlock& ao_double =
+          grid_double[i].getAOValues(block, buffer);
+      BOOST_CHECK(ao_double.values.isApprox(ref.values, 1e-14));
+      BOOST_CHECK(&ao_double != &buffer);
+      BOOST_CHECK(&copy[i].getAOValues(block, buffer) == &ao_double);
+
+      const GridBox::AOBlock& ao_single =
+          grid_single[i].getAOValues(block, buffer);
+      BOOST_CHECK(&ao_single == &buffer);
+      BOOST_CHECK(ao_single.values.isApprox(ref.values, 1e-6));
+      for (Index k = 0; k < 3; k++) {
+        BOOST_CHECK(
+            ao_single.derivatives[k].isApprox(ref.derivatives[k], 1e-6));
+      }
+    }
+    // blocks not matching the cached ones are computed
+    GridboxRange range;
+    range.start = 1;
+    range.size = box.size() - 1;
+    GridBox::AOBlock buffer;
+    const GridBox::AOBlock& ao = grid_double[i].getAOValues(range, buffer);
+    BOOST_CHECK(&ao == &buffer);
+    BOOST_CHECK(ao.values.isApprox(box.CalcAOValues(range).values, 1e-14));
+  }
+
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()